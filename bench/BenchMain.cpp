@@ -0,0 +1,40 @@
+#include "Benchmarks.h"
+
+#include <cstdio>
+#include <cstring>
+
+struct Suite {
+    const char* name;
+    int (*run)(int argc, char** argv);
+    const char* help;
+};
+
+static const Suite kSuites[] = {
+    { "tick", runTickBench, "tick [--ticks N] [--seed S] [--hz N] [map.svg...]  simulation tick cost per map" },
+    { "broadphase", runBroadphaseBench, "broadphase [--obstacles N] [--bullets N] [--brute-sample N]  grid vs all-pairs bullet hits" },
+    { "svgload", runSvgLoadBench, "svgload [--circles N] [--reps N]  SVG load time, current vs legacy scanner" },
+    { "players", runPlayersBench, "players [--ticks N] [--seed S] [count...]  tick cost for 2/64/1024 players" },
+    { "snapshot", runSnapshotBench, "snapshot [--iters N] [--obstacles N] [bullets...]  Game save/restore cost vs copy" },
+    { "collision", runCollisionBench, "collision [--queries N] [--obstacles N] [span...]  swept narrowphase, scalar vs SSE/AVX2 batch" },
+    { "pose", runPoseBench, "pose [--angles N] [--reps N]  fast sincos, angle wrapping and cached player vectors" },
+    { "raster", runRasterBench, "raster [--width W] [--height H] [--frames N] [--obstacles N] [--players N] [--bullets N] [--threads N]  CPU rasterizer frame cost" },
+    { "render", runRenderBench, "render [--ticks N] [--seed S] [--pixels N] [map.svg...]  simulation vs drawing cost through the null/recording backends" },
+    { "scaling", runScalingBench, "scaling [--min N] [--max N] [--ticks N] [--reps N] [--seed S] [layout...]  load/tick/draw cost vs obstacle count on generated arenas" },
+};
+
+static void usage(const char* exe) {
+    std::fprintf(stderr, "Usage: %s <suite> [options]\n", exe);
+    for (const Suite& s : kSuites) std::fprintf(stderr, "  %s\n", s.help);
+}
+
+int main(int argc, char** argv) {
+    // Default suite keeps `./trabalhocg_bench` meaningful without arguments.
+    const char* name = (argc >= 2) ? argv[1] : "tick";
+    for (const Suite& s : kSuites) {
+        if (std::strcmp(s.name, name) == 0) {
+            return (argc >= 2) ? s.run(argc - 2, argv + 2) : s.run(0, argv + 1);
+        }
+    }
+    usage(argv[0]);
+    return 1;
+}
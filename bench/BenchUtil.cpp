@@ -0,0 +1,57 @@
+#include "BenchUtil.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+namespace BenchUtil {
+
+double secondsSince(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+Percentiles summarize(std::vector<double>& samples) {
+    Percentiles p = { 0.0, 0.0, 0.0, 0.0 };
+    if (samples.empty()) return p;
+
+    std::sort(samples.begin(), samples.end());
+
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+
+    size_t n = samples.size();
+    p.mean = sum / double(n);
+    p.p50 = samples[(n - 1) / 2];
+    p.p99 = samples[std::min(n - 1, (n * 99) / 100)];
+    p.max = samples[n - 1];
+    return p;
+}
+
+std::vector<std::string> listSvgFiles(const std::string& dir) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const auto& e : std::filesystem::directory_iterator(dir, ec)) {
+        if (e.path().extension() == ".svg") files.push_back(e.path().string());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+long long intOption(int argc, char** argv, const char* name, long long def) {
+    for (int i = 0; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) return std::atoll(argv[i + 1]);
+    }
+    return def;
+}
+
+std::vector<std::string> positionalArgs(int argc, char** argv) {
+    std::vector<std::string> out;
+    for (int i = 0; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--", 2) == 0) { ++i; continue; }
+        out.push_back(argv[i]);
+    }
+    return out;
+}
+
+} // namespace BenchUtil
@@ -0,0 +1,35 @@
+#ifndef BENCH_BENCH_UTIL_H
+#define BENCH_BENCH_UTIL_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace BenchUtil {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point t0);
+
+struct Percentiles {
+    double mean;
+    double p50;
+    double p99;
+    double max;
+};
+
+// Sorts `samples` in place.
+Percentiles summarize(std::vector<double>& samples);
+
+// All *.svg files in `dir`, sorted by name. Empty if the directory is missing.
+std::vector<std::string> listSvgFiles(const std::string& dir);
+
+// Parses "--name value" style integer options; returns `def` when absent.
+long long intOption(int argc, char** argv, const char* name, long long def);
+
+// Positional (non "--") arguments after the suite name.
+std::vector<std::string> positionalArgs(int argc, char** argv);
+
+} // namespace BenchUtil
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef BENCH_BENCHMARKS_H
+#define BENCH_BENCHMARKS_H
+
+// Each suite receives the arguments that follow its name on the command line.
+int runTickBench(int argc, char** argv);
+int runBroadphaseBench(int argc, char** argv);
+int runSvgLoadBench(int argc, char** argv);
+int runPlayersBench(int argc, char** argv);
+int runSnapshotBench(int argc, char** argv);
+int runCollisionBench(int argc, char** argv);
+int runPoseBench(int argc, char** argv);
+int runRasterBench(int argc, char** argv);
+int runRenderBench(int argc, char** argv);
+int runScalingBench(int argc, char** argv);
+
+#endif
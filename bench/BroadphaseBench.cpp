@@ -0,0 +1,125 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "../include/entity/BulletPool.h"
+#include "../include/math/Collision.h"
+#include "../include/world/Arena.h"
+#include "../include/world/ObstacleGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Bullet-vs-obstacle cost with the uniform grid versus the old all-pairs scan,
+// over synthetic arenas of growing obstacle and bullet counts.
+
+namespace {
+
+struct Rng {
+    uint32_t s;
+    explicit Rng(uint32_t seed) : s(seed ? seed : 1u) {}
+    float next01() {
+        s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+        return float(s >> 8) * (1.0f / 16777216.0f);
+    }
+    float range(float lo, float hi) { return lo + (hi - lo) * next01(); }
+};
+
+Vec2 randomPointInDisc(Rng& rng, const Vec2& c, float R) {
+    float a = rng.range(0.0f, 6.2831853f);
+    float d = R * std::sqrt(rng.next01());
+    return Vec2(c.x + std::cos(a) * d, c.y + std::sin(a) * d);
+}
+
+int bruteHit(const std::vector<Obstacle>& obs, const Vec2& p0, const Vec2& p1, float r) {
+    int hit = -1;
+    float best = 2.0f;
+    for (int k = 0; k < (int)obs.size(); ++k) {
+        float t;
+        if (Collision::sweepCircleCircle(p0, p1, r, obs[k].pos, obs[k].radius, t) && t < best) {
+            best = t;
+            hit = k;
+        }
+    }
+    return hit;
+}
+
+} // namespace
+
+int runBroadphaseBench(int argc, char** argv) {
+    long long maxObstacles = BenchUtil::intOption(argc, argv, "--obstacles", 10000);
+    long long maxBullets = BenchUtil::intOption(argc, argv, "--bullets", 100000);
+    long long bruteSample = BenchUtil::intOption(argc, argv, "--brute-sample", 2000);
+    const float dt = 1.0f / 60.0f;
+
+    Arena arena;
+    arena.center = Vec2(0.0f, 0.0f);
+    arena.radius = 20000.0f;
+
+    std::printf("%10s %10s %10s %10s %12s %14s %14s %9s %6s\n",
+                "obstacles", "bullets", "build(ms)", "cells", "grid(ms)",
+                "grid(ns/blt)", "brute(ns/blt)", "speedup", "match");
+
+    for (long long nObs = 100; nObs <= maxObstacles; nObs *= 10) {
+        Rng rng(1234);
+        std::vector<Obstacle> obstacles;
+        obstacles.reserve(size_t(nObs));
+        for (long long i = 0; i < nObs; ++i) {
+            obstacles.emplace_back(randomPointInDisc(rng, arena.center, arena.radius * 0.95f),
+                                   rng.range(20.0f, 120.0f));
+        }
+
+        auto tb = BenchUtil::Clock::now();
+        ObstacleGrid grid;
+        grid.build(obstacles);
+        double buildMs = BenchUtil::secondsSince(tb) * 1e3;
+
+        for (long long nBul = 1000; nBul <= maxBullets; nBul *= 10) {
+            BulletPool pool((int)nBul);
+            for (long long i = 0; i < nBul; ++i) {
+                Vec2 p = randomPointInDisc(rng, arena.center, arena.radius * 0.9f);
+                float a = rng.range(0.0f, 6.2831853f);
+                pool.spawn(p, Vec2(std::cos(a) * 400.0f, std::sin(a) * 400.0f), 3.0f, 1);
+            }
+            pool.integrate(dt);
+            pool.removeOutside(arena);
+
+            const float* bx = pool.posX();
+            const float* by = pool.posY();
+            const float* bvx = pool.velX();
+            const float* bvy = pool.velY();
+            const float* br = pool.radius();
+            const int n = pool.size();
+
+            std::vector<int> gridHits((size_t)n);
+            auto tg = BenchUtil::Clock::now();
+            for (int i = 0; i < n; ++i) {
+                Vec2 p(bx[i], by[i]);
+                Vec2 p0(bx[i] - bvx[i] * dt, by[i] - bvy[i] * dt);
+                gridHits[i] = grid.findHit(p0, p, br[i]);
+            }
+            double gridSec = BenchUtil::secondsSince(tg);
+
+            int sample = (int)std::min<long long>(bruteSample, n);
+            int mismatches = 0;
+            auto tf = BenchUtil::Clock::now();
+            for (int i = 0; i < sample; ++i) {
+                Vec2 p0(bx[i] - bvx[i] * dt, by[i] - bvy[i] * dt);
+                int b = bruteHit(obstacles, p0, Vec2(bx[i], by[i]), br[i]);
+                if ((b >= 0) != (gridHits[i] >= 0)) ++mismatches;
+            }
+            double bruteSec = BenchUtil::secondsSince(tf);
+
+            double gridNs = gridSec * 1e9 / double(std::max(n, 1));
+            double bruteNs = bruteSec * 1e9 / double(std::max(sample, 1));
+
+            std::printf("%10lld %10d %10.2f %10d %12.3f %14.1f %14.1f %8.1fx %6s\n",
+                        nObs, n, buildMs, grid.columns() * grid.rows(), gridSec * 1e3,
+                        gridNs, bruteNs, bruteNs / std::max(gridNs, 1e-3),
+                        mismatches == 0 ? "yes" : "NO");
+        }
+    }
+    return 0;
+}
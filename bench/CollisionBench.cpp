@@ -0,0 +1,172 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "../include/math/Collision.h"
+#include "../include/world/ObstacleGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Swept-circle narrowphase: the scalar loop over sweepCircleCircle against
+// the SSE and AVX2 batch kernels behind Collision::sweepCircleFirst, first on
+// raw SoA spans of growing length, then end to end through
+// ObstacleGrid::findHit on a dense map. Every level must return the same
+// index and bit-identical time as the scalar loop.
+
+namespace {
+
+struct Rng {
+    uint32_t s;
+    explicit Rng(uint32_t seed) : s(seed ? seed : 1u) {}
+    float next01() {
+        s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+        return float(s >> 8) * (1.0f / 16777216.0f);
+    }
+    float range(float lo, float hi) { return lo + (hi - lo) * next01(); }
+};
+
+struct Query {
+    Vec2 p0;
+    Vec2 p1;
+    float r;
+};
+
+const Collision::BatchLevel kLevels[] = {
+    Collision::BatchLevel::SCALAR, Collision::BatchLevel::SSE, Collision::BatchLevel::AVX2
+};
+
+// The reference: the per-circle scalar test, first minimum wins.
+int scalarLoop(const Query& q, const Collision::CircleSpan& c, float& t) {
+    int best = -1;
+    for (int i = 0; i < c.count; ++i) {
+        float ti;
+        if (Collision::sweepCircleCircle(q.p0, q.p1, q.r, Vec2(c.x[i], c.y[i]), c.r[i], ti) &&
+            (best < 0 || ti < t)) {
+            best = i;
+            t = ti;
+        }
+    }
+    return best;
+}
+
+uint32_t bits(float v) {
+    uint32_t b;
+    std::memcpy(&b, &v, sizeof(b));
+    return b;
+}
+
+} // namespace
+
+int runCollisionBench(int argc, char** argv) {
+    long long queries = BenchUtil::intOption(argc, argv, "--queries", 200000);
+    long long obstacles = BenchUtil::intOption(argc, argv, "--obstacles", 20000);
+
+    std::vector<int> spans;
+    for (const std::string& a : BenchUtil::positionalArgs(argc, argv)) spans.push_back(std::max(1, std::atoi(a.c_str())));
+    if (spans.empty()) spans = {4, 16, 64, 256, 1024};
+
+    const Collision::BatchLevel initial = Collision::batchLevel();
+    std::printf("batch level on this CPU: %s\n\n", Collision::batchLevelName(initial));
+
+    /* ----- Raw spans ----- */
+
+    std::printf("%8s %-8s %12s %12s %9s %7s\n", "circles", "path", "ns/query", "ns/circle", "speedup", "match");
+    for (int n : spans) {
+        Rng rng(uint32_t(n) * 7919u);
+        std::vector<float> x(static_cast<size_t>(n)), y(static_cast<size_t>(n)), r(static_cast<size_t>(n));
+        // Circles spread over a box a few query lengths wide, so some sweeps
+        // hit early, some late and most miss.
+        float extent = 40.0f * std::sqrt(float(n));
+        for (int i = 0; i < n; ++i) {
+            x[i] = rng.range(-extent, extent);
+            y[i] = rng.range(-extent, extent);
+            r[i] = rng.range(5.0f, 20.0f);
+        }
+        const Collision::CircleSpan span = { x.data(), y.data(), r.data(), n };
+
+        const int qn = int(std::max(1LL, queries / std::max(1, n / 16)));
+        std::vector<Query> qs(static_cast<size_t>(qn));
+        for (Query& q : qs) {
+            q.p0 = Vec2(rng.range(-extent, extent), rng.range(-extent, extent));
+            q.p1 = q.p0 + Vec2(rng.range(-60.0f, 60.0f), rng.range(-60.0f, 60.0f));
+            q.r = rng.range(1.0f, 4.0f);
+        }
+
+        std::vector<int> refIndex(static_cast<size_t>(qn));
+        std::vector<uint32_t> refT(static_cast<size_t>(qn));
+        long long sink = 0;
+        auto t0 = BenchUtil::Clock::now();
+        for (int i = 0; i < qn; ++i) {
+            float t = 0.0f;
+            refIndex[i] = scalarLoop(qs[i], span, t);
+            refT[i] = bits(t);
+            sink += refIndex[i];
+        }
+        double base = BenchUtil::secondsSince(t0) * 1e9 / double(qn);
+        std::printf("%8d %-8s %12.1f %12.3f %8.2fx %7s\n", n, "loop", base, base / double(n), 1.0, "ref");
+
+        for (Collision::BatchLevel level : kLevels) {
+            if (!Collision::setBatchLevel(level)) continue;
+            bool same = true;
+            t0 = BenchUtil::Clock::now();
+            for (int i = 0; i < qn; ++i) {
+                float t = 0.0f;
+                int k = Collision::sweepCircleFirst(qs[i].p0, qs[i].p1, qs[i].r, span, t);
+                same &= (k == refIndex[i]) && (k < 0 || bits(t) == refT[i]);
+                sink += k;
+            }
+            double ns = BenchUtil::secondsSince(t0) * 1e9 / double(qn);
+            std::printf("%8d %-8s %12.1f %12.3f %8.2fx %7s\n", n, Collision::batchLevelName(level), ns,
+                        ns / double(n), base / ns, same ? "yes" : "NO");
+            if (!same) return 1;
+        }
+        if (sink == 42) std::printf(" ");
+    }
+
+    /* ----- Through the obstacle grid ----- */
+
+    Rng rng(12345u);
+    std::vector<Obstacle> obs;
+    const float R = 40.0f * std::sqrt(float(obstacles));
+    for (long long i = 0; i < obstacles; ++i) {
+        obs.emplace_back(Vec2(rng.range(-R, R), rng.range(-R, R)), rng.range(5.0f, 60.0f));
+    }
+    ObstacleGrid grid;
+    grid.build(obs);
+
+    std::vector<Query> qs(static_cast<size_t>(queries));
+    for (Query& q : qs) {
+        q.p0 = Vec2(rng.range(-R, R), rng.range(-R, R));
+        q.p1 = q.p0 + Vec2(rng.range(-7.0f, 7.0f), rng.range(-7.0f, 7.0f));
+        q.r = 3.0f;
+    }
+
+    std::printf("\nObstacleGrid::findHit, %lld obstacles, %d entries, %.1f per cell\n",
+                obstacles, grid.entryCount(), double(grid.entryCount()) / double(grid.columns() * grid.rows()));
+    std::printf("%-8s %12s %9s %7s\n", "path", "ns/query", "speedup", "match");
+    std::vector<int> ref(qs.size());
+    double base = 0.0;
+    for (Collision::BatchLevel level : kLevels) {
+        if (!Collision::setBatchLevel(level)) continue;
+        bool same = true;
+        auto t0 = BenchUtil::Clock::now();
+        for (size_t i = 0; i < qs.size(); ++i) {
+            int k = grid.findHit(qs[i].p0, qs[i].p1, qs[i].r);
+            if (level == Collision::BatchLevel::SCALAR) ref[i] = k;
+            else same &= (k == ref[i]);
+        }
+        double ns = BenchUtil::secondsSince(t0) * 1e9 / double(qs.size());
+        if (level == Collision::BatchLevel::SCALAR) base = ns;
+        std::printf("%-8s %12.1f %8.2fx %7s\n", Collision::batchLevelName(level), ns, base / ns, same ? "yes" : "NO");
+        if (!same) return 1;
+    }
+
+    Collision::setBatchLevel(initial);
+    return 0;
+}
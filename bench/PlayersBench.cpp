@@ -0,0 +1,143 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "../include/game/Game.h"
+#include "../include/game/InputScript.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Tick cost as the number of combatants grows. Each run generates an arena
+// whose area scales with the player count (constant density, about one
+// obstacle per two players); players 1 and 2 follow the usual input script
+// and the rest get random held commands through Game::setPlayerCommand.
+
+namespace {
+
+struct Rng {
+    uint32_t s;
+    explicit Rng(uint32_t seed) : s(seed ? seed : 1u) {}
+    uint32_t next() {
+        s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+        return s;
+    }
+    float next01() { return float(next() >> 8) * (1.0f / 16777216.0f); }
+    float range(float lo, float hi) { return lo + (hi - lo) * next01(); }
+    int rangeInt(int lo, int hi) { return lo + int(next() % uint32_t(hi - lo + 1)); }
+};
+
+Vec2 randomPointInDisc(Rng& rng, const Vec2& c, float R) {
+    float a = rng.range(0.0f, 6.2831853f);
+    float d = R * std::sqrt(rng.next01());
+    return Vec2(c.x + std::cos(a) * d, c.y + std::sin(a) * d);
+}
+
+struct Bot {
+    PlayerCommand cmd;
+    int hold = 0;
+};
+
+void stepBot(Bot& b, Rng& rng) {
+    if (b.hold <= 0) {
+        int a = rng.rangeInt(0, 6);
+        b.cmd.forward = (a == 1 || a == 2 || a == 3);
+        b.cmd.backward = (a == 4);
+        b.cmd.turnLeft = (a == 2 || a == 5);
+        b.cmd.turnRight = (a == 3 || a == 6);
+        b.cmd.aim = true;
+        b.cmd.aimFraction = rng.next01();
+        b.hold = rng.rangeInt(15, 90);
+    }
+    --b.hold;
+    // Tap fire now and then; shots are edge-triggered.
+    b.cmd.fire = (rng.next() & 31u) == 0;
+}
+
+const float kHeadRadius = 20.0f;
+
+SvgSceneData makeScene(Rng& rng, int players) {
+    SvgSceneData d;
+    d.hasArena = d.hasPlayer1 = d.hasPlayer2 = true;
+    d.arena.center = Vec2(0.0f, 0.0f);
+    // ~2% of the arena area covered by players.
+    d.arena.radius = kHeadRadius * std::sqrt(float(std::max(players, 2)) / 0.02f);
+
+    int obstacles = std::max(4, players / 2);
+    for (int i = 0; i < obstacles; ++i) {
+        d.obstacles.emplace_back(randomPointInDisc(rng, d.arena.center, d.arena.radius * 0.9f),
+                                 rng.range(10.0f, 40.0f));
+    }
+    d.player1Pos = randomPointInDisc(rng, d.arena.center, d.arena.radius * 0.8f);
+    d.player1HeadRadius = kHeadRadius;
+    d.player2Pos = randomPointInDisc(rng, d.arena.center, d.arena.radius * 0.8f);
+    d.player2HeadRadius = kHeadRadius;
+    return d;
+}
+
+} // namespace
+
+int runPlayersBench(int argc, char** argv) {
+    long long ticks = BenchUtil::intOption(argc, argv, "--ticks", 2000);
+    long long seed = BenchUtil::intOption(argc, argv, "--seed", 1);
+    const float dt = 1.0f / 60.0f;
+
+    std::vector<int> counts;
+    for (const std::string& a : BenchUtil::positionalArgs(argc, argv)) counts.push_back(std::max(2, std::atoi(a.c_str())));
+    if (counts.empty()) counts = {2, 64, 1024};
+
+    std::printf("%8s %8s %12s %10s %10s %14s %10s %10s %7s %8s\n",
+                "players", "ticks", "ticks/s", "p50(us)", "p99(us)", "ns/plyr-tick",
+                "pairs/tck", "obs/tck", "resets", "dropped");
+
+    for (int n : counts) {
+        Rng rng((uint32_t)seed * 2654435761u + (uint32_t)n);
+        SvgSceneData scene = makeScene(rng, n);
+
+        Game game;
+        game.loadScene(scene);
+        for (int e = 2; e < n; ++e) {
+            game.addPlayer(randomPointInDisc(rng, scene.arena.center, scene.arena.radius * 0.9f), kHeadRadius);
+        }
+
+        InputScript script((uint32_t)seed);
+        InputState in;
+        std::vector<Bot> bots((size_t)n);
+
+        std::vector<double> samples;
+        samples.reserve(size_t(ticks));
+        long long pairs = 0;
+        long long obstacleTests = 0;
+        int resets = 0;
+
+        auto t0 = BenchUtil::Clock::now();
+        for (long long t = 0; t < ticks; ++t) {
+            script.step(in);
+            game.setInput(in);
+            for (int e = 2; e < n; ++e) {
+                stepBot(bots[e], rng);
+                game.setPlayerCommand(e, bots[e].cmd);
+            }
+
+            auto s0 = BenchUtil::Clock::now();
+            game.update(dt);
+            samples.push_back(BenchUtil::secondsSince(s0) * 1e6);
+            pairs += game.lastResolveStats().pairsTested;
+            obstacleTests += game.lastResolveStats().obstaclesTested;
+
+            if (!game.isRunning()) { game.reset(); ++resets; }
+        }
+        double secs = BenchUtil::secondsSince(t0);
+
+        BenchUtil::Percentiles p = BenchUtil::summarize(samples);
+        std::printf("%8d %8lld %12.0f %10.2f %10.2f %14.1f %10.1f %10.1f %7d %8lld\n",
+                    n, ticks, double(ticks) / secs, p.p50, p.p99, p.mean * 1e3 / double(n),
+                    double(pairs) / double(ticks), double(obstacleTests) / double(ticks), resets,
+                    game.droppedBulletCount());
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "../include/entity/PlayerStore.h"
+#include "../include/math/Angle.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Heading math: Angle::sincos against libm (accuracy and speed), the
+// constant-time wrap functions against the old loops, and the three ways of
+// getting a player's direction vectors (libm per call, Angle::sincos, the
+// PlayerStore cache).
+
+namespace {
+
+struct Rng {
+    uint32_t s;
+    explicit Rng(uint32_t seed) : s(seed ? seed : 1u) {}
+    float next01() {
+        s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+        return float(s >> 8) * (1.0f / 16777216.0f);
+    }
+    float range(float lo, float hi) { return lo + (hi - lo) * next01(); }
+};
+
+// The loops Angle::wrapPi / wrap2Pi used before.
+float loopWrapPi(float a) {
+    while (a <= -Angle::pi()) a += 2.0f * Angle::pi();
+    while (a >  Angle::pi()) a -= 2.0f * Angle::pi();
+    return a;
+}
+
+float loopWrap2Pi(float a) {
+    while (a < 0.0f) a += 2.0f * Angle::pi();
+    while (a >= 2.0f * Angle::pi()) a -= 2.0f * Angle::pi();
+    return a;
+}
+
+// Max |error| of Angle::sincos against double precision over [lo, hi].
+double sincosError(double lo, double hi, long long steps) {
+    double worst = 0.0;
+    for (long long i = 0; i <= steps; ++i) {
+        float a = float(lo + (hi - lo) * double(i) / double(steps));
+        float s, c;
+        Angle::sincos(a, s, c);
+        worst = std::max(worst, std::fabs(double(s) - std::sin(double(a))));
+        worst = std::max(worst, std::fabs(double(c) - std::cos(double(a))));
+    }
+    return worst;
+}
+
+volatile float gSink = 0.0f;
+
+// `f` maps an angle to a float; the results are summed so nothing is dropped.
+template <class F>
+double nsPerCall(const std::vector<float>& in, int reps, F&& f) {
+    float sum = 0.0f;
+    auto t0 = BenchUtil::Clock::now();
+    for (int r = 0; r < reps; ++r) {
+        for (float a : in) sum += f(a);
+    }
+    double ns = BenchUtil::secondsSince(t0) * 1e9 / (double(in.size()) * double(reps));
+    gSink = sum;
+    return ns;
+}
+
+} // namespace
+
+int runPoseBench(int argc, char** argv) {
+    long long n = BenchUtil::intOption(argc, argv, "--angles", 100000);
+    int reps = int(BenchUtil::intOption(argc, argv, "--reps", 20));
+
+    /* ----- Accuracy ----- */
+
+    std::printf("Angle::sincos max abs error vs double sin/cos\n");
+    const double ranges[][2] = { { -Angle::pi(), Angle::pi() }, { -100.0, 100.0 }, { -65536.0, 65536.0 } };
+    for (const auto& r : ranges) {
+        std::printf("  [%9.2f, %9.2f]  %.3g\n", r[0], r[1], sincosError(r[0], r[1], 2000000));
+    }
+
+    /* ----- Speed ----- */
+
+    Rng rng(7u);
+    std::vector<float> small(size_t(n > 0 ? n : 1)), large(small.size());
+    for (size_t i = 0; i < small.size(); ++i) {
+        small[i] = rng.range(-1.5f * Angle::twoPi(), 1.5f * Angle::twoPi());
+        large[i] = rng.range(-2000.0f, 2000.0f);
+    }
+
+    std::printf("\n%-30s %10s\n", "", "ns/call");
+    std::printf("%-30s %10.2f\n", "std::sin + std::cos", nsPerCall(small, reps, [](float a) {
+        return std::sin(a) + std::cos(a);
+    }));
+    std::printf("%-30s %10.2f\n", "Angle::sincos", nsPerCall(small, reps, [](float a) {
+        float s, c;
+        Angle::sincos(a, s, c);
+        return s + c;
+    }));
+
+    bool same = true;
+    for (float a : small) {
+        same &= loopWrapPi(a) == Angle::wrapPi(a) && loopWrap2Pi(a) == Angle::wrap2Pi(a);
+    }
+    std::printf("%-30s %10.2f\n", "loop wrap2Pi, |a| < 3pi", nsPerCall(small, reps, [](float a) { return loopWrap2Pi(a); }));
+    std::printf("%-30s %10.2f\n", "Angle::wrap2Pi, |a| < 3pi", nsPerCall(small, reps, [](float a) { return Angle::wrap2Pi(a); }));
+    std::printf("%-30s %10.2f\n", "loop wrap2Pi, |a| < 2000", nsPerCall(large, reps, [](float a) { return loopWrap2Pi(a); }));
+    std::printf("%-30s %10.2f\n", "Angle::wrap2Pi, |a| < 2000", nsPerCall(large, reps, [](float a) { return Angle::wrap2Pi(a); }));
+    std::printf("wrap within one turn matches the loops: %s\n", same ? "yes" : "NO");
+
+    /* ----- Player direction vectors ----- */
+
+    PlayerStore store;
+    Player tmpl;
+    for (int e = 0; e < 1024; ++e) {
+        tmpl.headingRad = rng.range(0.0f, Angle::twoPi());
+        tmpl.armRelRad = rng.range(tmpl.armMinRelRad, tmpl.armMaxRelRad);
+        store.add(tmpl);
+    }
+    std::vector<Player> copies;
+    for (int e = 0; e < store.size(); ++e) copies.push_back(store.get(e));
+
+    auto perPose = [&](auto&& f) {
+        float sum = 0.0f;
+        auto t0 = BenchUtil::Clock::now();
+        for (int r = 0; r < reps * 20; ++r) {
+            for (int e = 0; e < store.size(); ++e) {
+                PlayerPose p = f(e);
+                sum += p.forward.x + p.armDir.y;
+            }
+        }
+        double ns = BenchUtil::secondsSince(t0) * 1e9 / (double(store.size()) * double(reps * 20));
+        gSink = sum;
+        return ns;
+    };
+    std::printf("\n%-30s %10s\n", "player pose", "ns/pose");
+    std::printf("%-30s %10.2f\n", "Player::pose (libm)", perPose([&](int e) { return copies[e].pose(); }));
+    std::printf("%-30s %10.2f\n", "Player::approxPose", perPose([&](int e) { return copies[e].approxPose(); }));
+    std::printf("%-30s %10.2f\n", "PlayerStore::pose (cached)", perPose([&](int e) { return store.pose(e); }));
+
+    bool exact = true;
+    for (int e = 0; e < store.size(); ++e) {
+        PlayerPose a = copies[e].pose();
+        PlayerPose b = store.pose(e);
+        exact &= a.forward.x == b.forward.x && a.forward.y == b.forward.y &&
+                 a.armDir.x == b.armDir.x && a.armDir.y == b.armDir.y;
+    }
+    std::printf("cached pose equals libm pose: %s\n", exact ? "yes" : "NO");
+    return (same && exact) ? 0 : 1;
+}
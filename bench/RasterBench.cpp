@@ -0,0 +1,167 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "../include/game/SoftRaster.h"
+#include "../include/util/Hash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// CPU rasterizer on a synthetic frame much busier than a real match: many
+// outlined obstacles, players built from ellipses and quads, bullets and a
+// line of text. Each thread count renders the same frame, once drawing
+// everything and once starting from the cached static layer, and must
+// produce the same pixels as the single-threaded run.
+
+namespace {
+
+struct Rng {
+    uint32_t s;
+    explicit Rng(uint32_t seed) : s(seed ? seed : 1u) {}
+    float next01() {
+        s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+        return float(s >> 8) * (1.0f / 16777216.0f);
+    }
+    float range(float lo, float hi) { return lo + (hi - lo) * next01(); }
+};
+
+struct Scene {
+    std::vector<Vec2> obstacles;
+    std::vector<float> obstacleRadius;
+    std::vector<Vec2> players;
+    std::vector<float> heading;
+    std::vector<Vec2> bullets;
+};
+
+Scene makeScene(int obstacles, int players, int bullets) {
+    Rng rng(99u);
+    Scene s;
+    for (int i = 0; i < obstacles; ++i) {
+        s.obstacles.push_back(Vec2(rng.range(-950.0f, 950.0f), rng.range(-950.0f, 950.0f)));
+        s.obstacleRadius.push_back(rng.range(8.0f, 45.0f));
+    }
+    for (int i = 0; i < players; ++i) {
+        s.players.push_back(Vec2(rng.range(-900.0f, 900.0f), rng.range(-900.0f, 900.0f)));
+        s.heading.push_back(rng.range(0.0f, 6.2831853f));
+    }
+    for (int i = 0; i < bullets; ++i) s.bullets.push_back(Vec2(rng.range(-950.0f, 950.0f), rng.range(-950.0f, 950.0f)));
+    return s;
+}
+
+const Rgba8 kBackground = { 56, 56, 56, 255 };
+const Rgba8 kBlack = { 0, 0, 0, 255 };
+const Rgba8 kWhite = { 255, 255, 255, 255 };
+const Rgba8 kBlue = { 25, 89, 255, 255 };
+const Rgba8 kGreen = { 0, 191, 64, 255 };
+const Rgba8 kYellow = { 255, 230, 51, 255 };
+
+void drawStatic(SoftRaster& r, const Scene& s) {
+    r.strokeCircle(Vec2(0.0f, 0.0f), 1000.0f, 4.0f, kBlue);
+    for (size_t i = 0; i < s.obstacles.size(); ++i) {
+        r.fillCircle(s.obstacles[i], s.obstacleRadius[i], { 5, 5, 5, 255 });
+        r.strokeCircle(s.obstacles[i], s.obstacleRadius[i], 3.0f, kWhite);
+    }
+}
+
+// Roughly Renderer::drawPlayer: arm ellipses, body, feet and weapon quads.
+void drawDynamic(SoftRaster& r, const Scene& s) {
+    const float R = 12.0f;
+    for (size_t i = 0; i < s.players.size(); ++i) {
+        Vec2 p = s.players[i];
+        Vec2 f(std::cos(s.heading[i]), -std::sin(s.heading[i]));
+        Vec2 left(f.y, -f.x);
+        for (float side : { 1.0f, -1.0f }) {
+            Vec2 arm = p + left * (side * R * 1.05f);
+            r.fillEllipse(arm, R * 0.95f, R * 0.35f, left.x, left.y, kGreen);
+            r.strokeEllipse(arm, R * 0.95f, R * 0.35f, left.x, left.y, 3.0f, kBlack);
+        }
+        r.fillCircle(p, R, kGreen);
+        r.strokeCircle(p, R, 3.0f, kBlack);
+        Vec2 n(-f.y, f.x);
+        Vec2 c = p + f * (R * 1.5f) - left * (R * 1.05f);
+        Vec2 quad[4] = { c - f * 8.0f - n * 2.0f, c + f * 8.0f - n * 2.0f, c + f * 8.0f + n * 2.0f, c - f * 8.0f + n * 2.0f };
+        r.fillQuad(quad, kGreen);
+        r.strokeQuad(quad, 3.0f, kBlack);
+    }
+    for (const Vec2& b : s.bullets) {
+        r.fillCircle(b, 2.0f, kYellow);
+        r.strokeCircle(b, 2.0f, 1.0f, kBlack);
+    }
+    r.drawText(-950.0f, -950.0f, "P1: 3   P2: 3", TextFont::SMALL, kWhite);
+}
+
+uint64_t frameHash(const SoftRaster& r) {
+    return Hash::bytes(r.pixels(), size_t(r.width()) * size_t(r.height()) * sizeof(uint32_t));
+}
+
+} // namespace
+
+int runRasterBench(int argc, char** argv) {
+    int width = int(BenchUtil::intOption(argc, argv, "--width", 1920));
+    int height = int(BenchUtil::intOption(argc, argv, "--height", 1080));
+    int frames = int(std::max(1LL, BenchUtil::intOption(argc, argv, "--frames", 30)));
+    int obstacles = int(BenchUtil::intOption(argc, argv, "--obstacles", 2000));
+    int players = int(BenchUtil::intOption(argc, argv, "--players", 256));
+    int bullets = int(BenchUtil::intOption(argc, argv, "--bullets", 2000));
+    int maxThreads = int(BenchUtil::intOption(argc, argv, "--threads", 0));
+    if (maxThreads <= 0) maxThreads = std::max(1, int(std::thread::hardware_concurrency()));
+
+    SoftRaster raster;
+    if (!raster.resize(width, height)) {
+        std::fprintf(stderr, "bad size %dx%d\n", width, height);
+        return 1;
+    }
+    raster.fitView(Vec2(0.0f, 0.0f), 1000.0f);
+    raster.setClearColor(kBackground);
+    const Scene scene = makeScene(obstacles, players, bullets);
+
+    std::printf("%dx%d, %d obstacles, %d players, %d bullets\n", width, height, obstacles, players, bullets);
+    std::printf("%8s %12s %8s %14s %8s %9s %6s\n", "threads", "full ms", "fps", "cached ms", "fps", "speedup", "same");
+
+    std::vector<int> counts;
+    for (int n = 1; n < maxThreads; n *= 2) counts.push_back(n);
+    counts.push_back(maxThreads);
+
+    uint64_t reference = 0;
+    double base = 0.0;
+    for (int n : counts) {
+        raster.setThreads(n);
+
+        auto t0 = BenchUtil::Clock::now();
+        for (int f = 0; f < frames; ++f) {
+            raster.beginFrame();
+            drawStatic(raster, scene);
+            drawDynamic(raster, scene);
+            raster.finish();
+        }
+        double fullMs = BenchUtil::secondsSince(t0) * 1e3 / double(frames);
+        uint64_t h = frameHash(raster);
+
+        raster.beginFrame();
+        drawStatic(raster, scene);
+        raster.captureBackground();
+        t0 = BenchUtil::Clock::now();
+        for (int f = 0; f < frames; ++f) {
+            raster.beginFrame();
+            raster.restoreBackground();
+            drawDynamic(raster, scene);
+            raster.finish();
+        }
+        double cachedMs = BenchUtil::secondsSince(t0) * 1e3 / double(frames);
+        bool same = frameHash(raster) == h;
+
+        if (n == 1) {
+            reference = h;
+            base = cachedMs;
+        }
+        same = same && h == reference;
+        std::printf("%8d %12.2f %8.0f %14.2f %8.0f %8.2fx %6s\n", n, fullMs, 1000.0 / fullMs, cachedMs,
+                    1000.0 / cachedMs, base / cachedMs, same ? "yes" : "NO");
+        if (!same) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "../include/game/Game.h"
+#include "../include/game/InputScript.h"
+#include "../include/game/NullRenderBackend.h"
+#include "../include/game/RecordingRenderBackend.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Simulation cost next to drawing cost, without a GL context. Every tick is
+// simulated, then drawn through the null backend (scene composition plus the
+// counters of the immediate GL path) and captured by the recording backend.
+// The last recording is replayed into a fresh null backend and must give the
+// same counters; its hash identifies the frame for regression comparisons.
+int runRenderBench(int argc, char** argv) {
+    long long ticks = BenchUtil::intOption(argc, argv, "--ticks", 5000);
+    long long seed = BenchUtil::intOption(argc, argv, "--seed", 1);
+    long long pixels = std::max(1LL, BenchUtil::intOption(argc, argv, "--pixels", 500));
+
+    std::vector<std::string> files = BenchUtil::positionalArgs(argc, argv);
+    if (files.empty()) files = BenchUtil::listSvgFiles("test_svgs");
+    if (files.empty()) {
+        std::fprintf(stderr, "render: no SVG files given and none found in test_svgs/\n");
+        return 1;
+    }
+
+    std::printf("%-20s %9s %9s %9s %9s %8s %8s %7s %7s %18s\n",
+                "map", "sim(us)", "draw(us)", "p99(us)", "rec(us)", "prims", "verts", "draws", "state", "last frame");
+
+    for (const std::string& path : files) {
+        Game game;
+        if (!game.loadFromSvg(path)) {
+            std::fprintf(stderr, "render: failed to load '%s'\n", path.c_str());
+            return 1;
+        }
+        const Arena& arena = game.getArena();
+        float ppu = float(pixels) / (2.0f * arena.radius);
+
+        NullRenderBackend counter;
+        RecordingRenderBackend recorder;
+        counter.setPixelsPerUnit(ppu);
+        recorder.setPixelsPerUnit(ppu);
+
+        InputScript script((uint32_t)seed);
+        InputState in;
+        std::vector<double> drawUs;
+        drawUs.reserve(size_t(ticks));
+        double simSeconds = 0.0;
+        double recordSeconds = 0.0;
+        RenderStats sum = RenderStats();
+
+        for (long long t = 0; t < ticks; ++t) {
+            script.step(in);
+            game.setInput(in);
+            auto s0 = BenchUtil::Clock::now();
+            game.update(1.0f / 60.0f);
+            simSeconds += BenchUtil::secondsSince(s0);
+            if (!game.isRunning()) game.reset();
+
+            s0 = BenchUtil::Clock::now();
+            counter.beginFrame();
+            game.render(counter);
+            counter.endFrame();
+            drawUs.push_back(BenchUtil::secondsSince(s0) * 1e6);
+
+            s0 = BenchUtil::Clock::now();
+            recorder.beginFrame();
+            game.render(recorder);
+            recorder.endFrame();
+            recordSeconds += BenchUtil::secondsSince(s0);
+
+            RenderStats st = counter.frameStats();
+            sum.primitives += st.primitives;
+            sum.vertices += st.vertices;
+            sum.drawCalls += st.drawCalls;
+            sum.stateChanges += st.stateChanges;
+        }
+
+        // Both start with a stale static layer, so the replay records it too.
+        NullRenderBackend check;
+        check.setPixelsPerUnit(ppu);
+        check.beginFrame();
+        recorder.replay(check);
+        check.endFrame();
+        NullRenderBackend direct;
+        direct.setPixelsPerUnit(ppu);
+        direct.beginFrame();
+        game.render(direct);
+        direct.endFrame();
+        RenderStats a = check.frameStats();
+        RenderStats b = direct.frameStats();
+        if (a.primitives != b.primitives || a.vertices != b.vertices || a.drawCalls != b.drawCalls ||
+            a.stateChanges != b.stateChanges) {
+            std::fprintf(stderr, "render: replayed frame differs on '%s'\n", path.c_str());
+            return 1;
+        }
+
+        BenchUtil::Percentiles p = BenchUtil::summarize(drawUs);
+        std::string name = path;
+        size_t slash = name.find_last_of('/');
+        if (slash != std::string::npos) name = name.substr(slash + 1);
+        double n = double(std::max(1LL, ticks));
+        std::printf("%-20s %9.2f %9.2f %9.2f %9.2f %8.1f %8.1f %7.1f %7.1f   %016llx\n",
+                    name.c_str(), simSeconds * 1e6 / n, p.mean, p.p99, recordSeconds * 1e6 / n,
+                    double(sum.primitives) / n, double(sum.vertices) / n, double(sum.drawCalls) / n,
+                    double(sum.stateChanges) / n, (unsigned long long)recorder.hash());
+    }
+    return 0;
+}
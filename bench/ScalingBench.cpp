@@ -0,0 +1,223 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "../include/game/Camera.h"
+#include "../include/game/Game.h"
+#include "../include/game/InputScript.h"
+#include "../include/game/NullRenderBackend.h"
+#include "../include/io/ArenaGenerator.h"
+#include "../include/io/SvgLoader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Load, tick and draw cost on generated stress arenas (ArenaGenerator) from
+// --min to --max obstacles, one decade per step, for every layout. After
+// each layout it prints the scaling exponent of every cost between steps
+// (log of the time ratio over log of the size ratio): ~1 for work that has
+// to touch every obstacle (parse, grid build, static layer), ~0 for per-frame
+// work. Anything above kSuperlinear is flagged and makes the suite fail.
+//
+// One-shot costs keep the best of up to --reps runs; ticks and frames are
+// averaged over --ticks steps of the seeded input script. Frames go to the
+// null backend at 500 pixels across the arena; "follow" frames go through a
+// camera tracking player 1 with a 500x500 unit view, which culls everything
+// else, so they include re-drawing the static layer as the view moves.
+
+namespace {
+
+// Falling out of cache costs up to ~0.3 over a decade on its own (grid
+// build, 10^5 -> 10^6); n^1.5 or worse still stands out.
+const double kSuperlinear = 1.4;
+
+// One-shot timings below this are too noisy to judge.
+const double kMinJudgedMs = 0.5;
+
+enum Metric { PARSE, BUILD, TICK, STATIC_LAYER, FRAME, FOLLOW, METRIC_COUNT };
+
+const char* const kMetricNames[METRIC_COUNT] = { "parse", "build", "tick", "static", "frame", "follow" };
+
+struct Row {
+    long long obstacles;
+    double mb;
+    double obstaclesTested;
+    double ms[METRIC_COUNT];
+};
+
+// Best wall time of `run` in ms: at most `reps` runs, fewer once half a
+// second has been spent.
+template <typename F>
+double bestOf(long long reps, F run) {
+    double best = 1e300;
+    auto start = BenchUtil::Clock::now();
+    for (long long r = 0; r < reps; ++r) {
+        auto t0 = BenchUtil::Clock::now();
+        run();
+        best = std::min(best, BenchUtil::secondsSince(t0) * 1e3);
+        if (BenchUtil::secondsSince(start) > 0.5) break;
+    }
+    return best;
+}
+
+bool measure(ArenaLayout layout, long long n, long long seed, long long ticks, long long reps,
+             const std::string& path, Row& row) {
+    ArenaGenParams params;
+    params.layout = layout;
+    params.obstacles = n;
+    params.seed = uint32_t(seed);
+    SvgSceneData generated;
+    ArenaGenerator::generate(params, generated);
+    if (!ArenaGenerator::writeSvg(path, generated)) {
+        std::fprintf(stderr, "scaling: cannot write '%s'\n", path.c_str());
+        return false;
+    }
+
+    row.obstacles = n;
+    row.mb = double(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+    SvgSceneData scene;
+    bool ok = true;
+    row.ms[PARSE] = bestOf(reps, [&]() { scene = SvgSceneData(); ok = ok && SvgLoader::load(path, scene); });
+    if (!ok || (long long)scene.obstacles.size() != n) {
+        std::fprintf(stderr, "scaling: '%s' loaded %zu obstacles, expected %lld\n", path.c_str(),
+                     scene.obstacles.size(), n);
+        return false;
+    }
+
+    Game game;
+    row.ms[BUILD] = bestOf(reps, [&]() { game.loadScene(scene); });
+
+    NullRenderBackend backend;
+    backend.setPixelsPerUnit(500.0f / (2.0f * scene.arena.radius));
+    row.ms[STATIC_LAYER] = bestOf(reps, [&]() {
+        backend.invalidateStaticLayer();
+        backend.beginFrame();
+        game.render(backend);
+        backend.endFrame();
+    });
+
+    // One pixel per unit over a 500 pixel window.
+    Camera camera;
+    camera.setZoom(2.0f * scene.arena.radius / 500.0f);
+    camera.setFollow(true);
+    NullRenderBackend follower;
+
+    InputScript script((uint32_t)seed);
+    InputState in;
+    double tickSeconds = 0.0, frameSeconds = 0.0, followSeconds = 0.0;
+    long long tested = 0;
+    for (long long t = 0; t < ticks; ++t) {
+        script.step(in);
+        game.setInput(in);
+        auto t0 = BenchUtil::Clock::now();
+        game.update(1.0f / 60.0f);
+        tickSeconds += BenchUtil::secondsSince(t0);
+        tested += game.lastResolveStats().obstaclesTested;
+        if (!game.isRunning()) game.reset();
+
+        t0 = BenchUtil::Clock::now();
+        backend.beginFrame();
+        game.render(backend);
+        backend.endFrame();
+        frameSeconds += BenchUtil::secondsSince(t0);
+
+        t0 = BenchUtil::Clock::now();
+        const PlayerStore& players = game.getPlayers();
+        camera.update(game.getArena(), Vec2(players.posX()[0], players.posY()[0]));
+        follower.setPixelsPerUnit(camera.pixelsPerUnit());
+        follower.setViewRect(camera.cullRect());
+        follower.beginFrame();
+        game.render(follower);
+        follower.endFrame();
+        followSeconds += BenchUtil::secondsSince(t0);
+    }
+    double steps = double(std::max(1LL, ticks));
+    row.ms[TICK] = tickSeconds * 1e3 / steps;
+    row.ms[FRAME] = frameSeconds * 1e3 / steps;
+    row.ms[FOLLOW] = followSeconds * 1e3 / steps;
+    row.obstaclesTested = double(tested) / steps;
+    return true;
+}
+
+} // namespace
+
+int runScalingBench(int argc, char** argv) {
+    long long minCount = std::max(1LL, BenchUtil::intOption(argc, argv, "--min", 100));
+    long long maxCount = BenchUtil::intOption(argc, argv, "--max", 1000000);
+    long long ticks = std::max(1LL, BenchUtil::intOption(argc, argv, "--ticks", 600));
+    long long reps = std::max(1LL, BenchUtil::intOption(argc, argv, "--reps", 3));
+    long long seed = BenchUtil::intOption(argc, argv, "--seed", 1);
+
+    std::vector<ArenaLayout> layouts;
+    for (const std::string& name : BenchUtil::positionalArgs(argc, argv)) {
+        ArenaLayout l;
+        if (!ArenaGenerator::parseLayout(name, l)) {
+            std::fprintf(stderr, "scaling: unknown layout '%s'\n", name.c_str());
+            return 1;
+        }
+        layouts.push_back(l);
+    }
+    if (layouts.empty()) {
+        for (int i = 0; i < ArenaGenerator::kLayoutCount; ++i) layouts.push_back(ArenaLayout(i));
+    }
+
+    // Per run, so concurrent runs sharing a temp directory keep their own arenas.
+    std::string file = "trabalhocg_scaling_bench_" + std::to_string((long long)getpid()) + "_" +
+                       std::to_string(seed) + ".svg";
+    std::string path = (std::filesystem::temp_directory_path() / file).string();
+    int flagged = 0;
+
+    for (ArenaLayout layout : layouts) {
+        const char* name = ArenaGenerator::layoutName(layout);
+        std::printf("%-10s %9s %8s %10s %10s %9s %8s %10s %9s %10s\n", "layout", "obstacles", "MiB", "parse(ms)",
+                    "build(ms)", "tick(us)", "obs/tck", "static(ms)", "frame(us)", "follow(us)");
+
+        std::vector<Row> rows;
+        for (long long n = minCount; n <= maxCount; n *= 10) {
+            Row row;
+            if (!measure(layout, n, seed, ticks, reps, path, row)) {
+                std::filesystem::remove(path);
+                return 1;
+            }
+            rows.push_back(row);
+            std::printf("%-10s %9lld %8.2f %10.2f %10.2f %9.2f %8.1f %10.2f %9.2f %10.2f\n", name, n, row.mb,
+                        row.ms[PARSE], row.ms[BUILD], row.ms[TICK] * 1e3, row.obstaclesTested,
+                        row.ms[STATIC_LAYER], row.ms[FRAME] * 1e3, row.ms[FOLLOW] * 1e3);
+            std::fflush(stdout);
+        }
+
+        // Exponents between consecutive sizes; averaged costs are stable
+        // enough to judge at any size, one-shot ones only above the floor.
+        std::printf("%-10s %19s", name, "exponent");
+        for (int m = 0; m < METRIC_COUNT; ++m) std::printf(" %9s", kMetricNames[m]);
+        std::printf("\n");
+        for (size_t i = 1; i < rows.size(); ++i) {
+            const Row& a = rows[i - 1];
+            const Row& b = rows[i];
+            std::printf("%-10s %9lld->%-9lld", name, a.obstacles, b.obstacles);
+            double sizeLog = std::log(double(b.obstacles) / double(a.obstacles));
+            for (int m = 0; m < METRIC_COUNT; ++m) {
+                double k = std::log(std::max(b.ms[m], 1e-9) / std::max(a.ms[m], 1e-9)) / sizeLog;
+                bool oneShot = (m == PARSE || m == BUILD || m == STATIC_LAYER);
+                bool bad = k > kSuperlinear && (!oneShot || b.ms[m] >= kMinJudgedMs);
+                if (bad) ++flagged;
+                std::printf(" %8.2f%c", k, bad ? '!' : ' ');
+            }
+            std::printf("\n");
+        }
+        std::printf("\n");
+    }
+
+    std::filesystem::remove(path);
+    if (flagged) {
+        std::printf("superlinear: %d step(s) above exponent %.1f (marked !)\n", flagged, kSuperlinear);
+        return 1;
+    }
+    std::printf("superlinear: none (limit %.1f)\n", kSuperlinear);
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "../include/game/Game.h"
+#include "../include/game/GameSnapshot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Cost of saving and restoring the mutable Game state as the number of live
+// bullets grows, against copying the whole Game (which also drags along the
+// obstacle list and its grid). The scene has many obstacles on purpose so the
+// difference between the two is visible.
+
+namespace {
+
+struct Rng {
+    uint32_t s;
+    explicit Rng(uint32_t seed) : s(seed ? seed : 1u) {}
+    uint32_t next() {
+        s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+        return s;
+    }
+    float next01() { return float(next() >> 8) * (1.0f / 16777216.0f); }
+    float range(float lo, float hi) { return lo + (hi - lo) * next01(); }
+};
+
+Vec2 randomPointInDisc(Rng& rng, const Vec2& c, float R) {
+    float a = rng.range(0.0f, 6.2831853f);
+    float d = R * std::sqrt(rng.next01());
+    return Vec2(c.x + std::cos(a) * d, c.y + std::sin(a) * d);
+}
+
+SvgSceneData makeScene(Rng& rng, int obstacles) {
+    SvgSceneData d;
+    d.hasArena = d.hasPlayer1 = d.hasPlayer2 = true;
+    d.arena.center = Vec2(0.0f, 0.0f);
+    d.arena.radius = 4000.0f;
+    for (int i = 0; i < obstacles; ++i) {
+        d.obstacles.emplace_back(randomPointInDisc(rng, d.arena.center, d.arena.radius * 0.9f),
+                                 rng.range(10.0f, 40.0f));
+    }
+    d.player1Pos = Vec2(-100.0f, 0.0f);
+    d.player1HeadRadius = 20.0f;
+    d.player2Pos = Vec2(100.0f, 0.0f);
+    d.player2HeadRadius = 20.0f;
+    return d;
+}
+
+} // namespace
+
+int runSnapshotBench(int argc, char** argv) {
+    long long iters = BenchUtil::intOption(argc, argv, "--iters", 20000);
+    long long obstacles = BenchUtil::intOption(argc, argv, "--obstacles", 2000);
+    long long seed = BenchUtil::intOption(argc, argv, "--seed", 1);
+
+    std::vector<int> counts;
+    for (const std::string& a : BenchUtil::positionalArgs(argc, argv)) counts.push_back(std::max(0, std::atoi(a.c_str())));
+    if (counts.empty()) counts = {0, 64, 256, 1024};
+
+    std::printf("%8s %10s %10s %12s %12s %12s %6s\n",
+                "bullets", "bytes", "save(ns)", "restore(ns)", "copy(ns)", "speedup", "hash");
+
+    Rng rng((uint32_t)seed);
+    SvgSceneData scene = makeScene(rng, int(obstacles));
+
+    for (int n : counts) {
+        Game game;
+        game.loadScene(scene);
+        int spawned = 0;
+        while (spawned < n) {
+            Vec2 p = randomPointInDisc(rng, scene.arena.center, scene.arena.radius * 0.8f);
+            Vec2 v(rng.range(-200.0f, 200.0f), rng.range(-200.0f, 200.0f));
+            if (!game.addBullet(p, v, 3.0f, spawned & 1)) break;
+            ++spawned;
+        }
+
+        GameSnapshot snap;
+        game.saveSnapshot(snap);
+        const uint64_t before = game.stateHash();
+
+        auto t0 = BenchUtil::Clock::now();
+        for (long long i = 0; i < iters; ++i) game.saveSnapshot(snap);
+        double saveNs = BenchUtil::secondsSince(t0) * 1e9 / double(iters);
+
+        // Move the game on so each restore has real work to undo.
+        game.update(1.0f / 60.0f);
+        bool ok = true;
+        t0 = BenchUtil::Clock::now();
+        for (long long i = 0; i < iters; ++i) ok &= game.restoreSnapshot(snap);
+        double restoreNs = BenchUtil::secondsSince(t0) * 1e9 / double(iters);
+        ok &= game.stateHash() == before;
+
+        long long copies = std::max(1LL, iters / 10);
+        Game copy(game);
+        t0 = BenchUtil::Clock::now();
+        for (long long i = 0; i < copies; ++i) copy = game;
+        double copyNs = BenchUtil::secondsSince(t0) * 1e9 / double(copies);
+
+        std::printf("%8d %10zu %10.1f %12.1f %12.1f %11.1fx %6s\n",
+                    game.bulletCount(), snap.size(), saveNs, restoreNs, copyNs,
+                    copyNs / std::max(1e-3, saveNs + restoreNs), ok ? "ok" : "FAIL");
+        if (!ok) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "../include/io/SceneCache.h"
+#include "../include/io/SvgLoader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Load time of SvgLoader::load on a generated multi-megabyte SVG, against the
+// previous fallback path (read into std::string, substr per tag, pattern
+// string + substr per attribute, strtof) kept below verbatim for comparison,
+// and against a warm SceneCache hit (scene + obstacle grid, no XML at all).
+
+namespace {
+
+namespace legacy {
+
+struct CircleRaw {
+    float cx, cy, r;
+    bool hasFill;
+};
+
+bool readFileAll(const std::string& path, std::string& outText) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    std::fseek(f, 0, SEEK_END);
+    long n = std::ftell(f);
+    if (n < 0) { std::fclose(f); return false; }
+    std::fseek(f, 0, SEEK_SET);
+    outText.resize((size_t)n);
+    if (n > 0) {
+        size_t rd = std::fread(&outText[0], 1, (size_t)n, f);
+        if (rd != (size_t)n) { std::fclose(f); return false; }
+    }
+    std::fclose(f);
+    return true;
+}
+
+bool extractAttrValue(const std::string& tag, const char* key, std::string& outVal) {
+    std::string pat = std::string(key) + "=\"";
+    size_t p = tag.find(pat);
+    if (p == std::string::npos) return false;
+    p += pat.size();
+    size_t q = tag.find('"', p);
+    if (q == std::string::npos) return false;
+    outVal = tag.substr(p, q - p);
+    return true;
+}
+
+bool parseFloatLocal(const char* s, float& out) {
+    if (!s) return false;
+    char* end = nullptr;
+    out = std::strtof(s, &end);
+    return end != s;
+}
+
+bool parseCircleTag(const std::string& tag, CircleRaw& outC) {
+    std::string cxS, cyS, rS;
+    if (!extractAttrValue(tag, "cx", cxS)) return false;
+    if (!extractAttrValue(tag, "cy", cyS)) return false;
+    if (!extractAttrValue(tag, "r", rS)) return false;
+
+    float cx = 0.0f, cy = 0.0f, rr = 0.0f;
+    if (!parseFloatLocal(cxS.c_str(), cx)) return false;
+    if (!parseFloatLocal(cyS.c_str(), cy)) return false;
+    if (!parseFloatLocal(rS.c_str(), rr)) return false;
+
+    std::string fillS;
+    outC.cx = cx;
+    outC.cy = cy;
+    outC.r = rr;
+    outC.hasFill = extractAttrValue(tag, "fill", fillS);
+    return true;
+}
+
+size_t load(const std::string& path) {
+    std::string text;
+    if (!readFileAll(path, text)) return 0;
+    std::vector<CircleRaw> circles;
+    circles.reserve(64);
+    size_t pos = 0;
+    while (true) {
+        size_t p = text.find("<circle", pos);
+        if (p == std::string::npos) break;
+        size_t q = text.find('>', p);
+        if (q == std::string::npos) break;
+        std::string tag = text.substr(p, q - p + 1);
+        CircleRaw c;
+        if (parseCircleTag(tag, c)) circles.push_back(c);
+        pos = q + 1;
+    }
+    return circles.size();
+}
+
+} // namespace legacy
+
+bool writeStressSvg(const std::string& path, long long circles) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    const float R = 20000.0f;
+    std::fprintf(f, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    std::fprintf(f, "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">\n");
+    std::fprintf(f, "  <circle cx=\"%.3f\" cy=\"%.3f\" r=\"%.3f\" fill=\"blue\" id=\"arena\" />\n", R, R, R);
+
+    uint32_t s = 99;
+    auto next01 = [&s]() {
+        s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+        return float(s >> 8) * (1.0f / 16777216.0f);
+    };
+    for (long long i = 0; i < circles; ++i) {
+        float a = next01() * 6.2831853f;
+        float d = (R - 100.0f) * std::sqrt(next01());
+        std::fprintf(f, "  <circle\n     fill=\"black\"\n     cx=\"%.5f\"\n     cy=\"%.5f\"\n     r=\"%.5f\"\n     id=\"o%lld\" />\n",
+                     R + std::cos(a) * d, R + std::sin(a) * d, 5.0f + 40.0f * next01(), i);
+    }
+    std::fprintf(f, "</svg>\n");
+    return std::fclose(f) == 0;
+}
+
+} // namespace
+
+int runSvgLoadBench(int argc, char** argv) {
+    long long circles = BenchUtil::intOption(argc, argv, "--circles", 200000);
+    long long reps = std::max(1LL, BenchUtil::intOption(argc, argv, "--reps", 5));
+
+    // Per run, so concurrent runs sharing a temp directory keep their own input.
+    std::string file = "trabalhocg_svgload_bench_" + std::to_string((long long)getpid()) + "_" +
+                       std::to_string(circles) + ".svg";
+    std::string path = (std::filesystem::temp_directory_path() / file).string();
+    if (!writeStressSvg(path, circles)) {
+        std::fprintf(stderr, "svgload: cannot write '%s'\n", path.c_str());
+        return 1;
+    }
+    double mb = double(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+    // A fresh cache directory of this run's own, so the cold and warm numbers
+    // never see another run's entries and only ours is deleted afterwards.
+    std::string cacheDir = (std::filesystem::temp_directory_path() / "trabalhocg_svgload_cache_XXXXXX").string();
+    if (!mkdtemp(&cacheDir[0])) {
+        std::fprintf(stderr, "svgload: cannot create a cache directory in '%s'\n",
+                     std::filesystem::temp_directory_path().string().c_str());
+        std::filesystem::remove(path);
+        return 1;
+    }
+    SceneCache::setDirectory(cacheDir);
+
+    std::vector<double> legacyMs, currentMs, cachedMs;
+    size_t legacyCount = 0, currentCount = 0, cachedCount = 0;
+
+    for (long long r = 0; r < reps; ++r) {
+        auto t0 = BenchUtil::Clock::now();
+        legacyCount = legacy::load(path);
+        legacyMs.push_back(BenchUtil::secondsSince(t0) * 1e3);
+
+        auto t1 = BenchUtil::Clock::now();
+        SvgSceneData data;
+        bool ok = SvgLoader::load(path, data);
+        currentMs.push_back(BenchUtil::secondsSince(t1) * 1e3);
+        currentCount = ok ? data.obstacles.size() + 1 : 0;  // + arena
+
+        // The first rep writes the cache file; later ones are the warm-start path.
+        auto t2 = BenchUtil::Clock::now();
+        SvgSceneData cached;
+        ObstacleGrid grid;
+        SceneCache::Result res = SceneCache::load(path, cached, grid);
+        if (r > 0 || reps == 1) cachedMs.push_back(BenchUtil::secondsSince(t2) * 1e3);
+        if (r > 0 && res != SceneCache::Result::HIT) {
+            std::fprintf(stderr, "svgload: expected a cache hit in '%s'\n", cacheDir.c_str());
+        }
+        cachedCount = res != SceneCache::Result::FAILED ? cached.obstacles.size() + 1 : 0;
+    }
+
+    BenchUtil::Percentiles lp = BenchUtil::summarize(legacyMs);
+    BenchUtil::Percentiles cp = BenchUtil::summarize(currentMs);
+    BenchUtil::Percentiles kp = BenchUtil::summarize(cachedMs);
+
+    std::printf("file: %s (%.1f MiB, %lld circles + arena, %lld reps)\n", path.c_str(), mb, circles, reps);
+    std::printf("%-10s %10s %10s %10s %10s\n", "path", "circles", "p50(ms)", "max(ms)", "MiB/s");
+    std::printf("%-10s %10zu %10.2f %10.2f %10.1f\n", "legacy", legacyCount, lp.p50, lp.max, mb / (lp.p50 * 1e-3));
+    std::printf("%-10s %10zu %10.2f %10.2f %10.1f\n", "current", currentCount, cp.p50, cp.max, mb / (cp.p50 * 1e-3));
+    std::printf("%-10s %10zu %10.2f %10.2f %10.1f\n", "cached", cachedCount, kp.p50, kp.max, mb / (kp.p50 * 1e-3));
+    std::printf("speedup: %.2fx (cached: %.2fx)\n", lp.p50 / std::max(cp.p50, 1e-6), lp.p50 / std::max(kp.p50, 1e-6));
+
+    std::filesystem::remove(path);
+    std::filesystem::remove_all(cacheDir);
+    SceneCache::setDirectory(std::string());
+    return (legacyCount == currentCount && currentCount == cachedCount) ? 0 : 1;
+}
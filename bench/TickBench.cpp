@@ -0,0 +1,84 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "../include/game/Game.h"
+#include "../include/game/InputScript.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Drives both players with scripted input for N ticks on every map and reports
+// throughput plus per-tick latency percentiles. This is the baseline the other
+// simulation optimizations are measured against. `--hz` lowers the tick rate;
+// bullet hits are swept, so they still land at coarse steps.
+int runTickBench(int argc, char** argv) {
+    long long ticks = BenchUtil::intOption(argc, argv, "--ticks", 20000);
+    long long seed = BenchUtil::intOption(argc, argv, "--seed", 1);
+    long long hz = std::max(1LL, BenchUtil::intOption(argc, argv, "--hz", 60));
+    const float dt = 1.0f / float(hz);
+
+    std::vector<std::string> files = BenchUtil::positionalArgs(argc, argv);
+    if (files.empty()) files = BenchUtil::listSvgFiles("test_svgs");
+    if (files.empty()) {
+        std::fprintf(stderr, "tick: no SVG files given and none found in test_svgs/\n");
+        return 1;
+    }
+
+    std::printf("%-32s %10s %12s %10s %10s %10s %7s %9s %9s\n",
+                "map", "ticks", "ticks/s", "p50(us)", "p99(us)", "max(us)", "resets",
+                "iter/tck", "obs/tck");
+
+    std::vector<double> all;
+    all.reserve(size_t(ticks) * files.size());
+    double totalSeconds = 0.0;
+
+    for (const std::string& path : files) {
+        Game game;
+        if (!game.loadFromSvg(path)) {
+            std::fprintf(stderr, "tick: failed to load '%s'\n", path.c_str());
+            return 1;
+        }
+
+        InputScript script((uint32_t)seed);
+        InputState in;
+        std::vector<double> samples;
+        samples.reserve(size_t(ticks));
+        int resets = 0;
+        long long iterations = 0;
+        long long obstaclesTested = 0;
+
+        auto t0 = BenchUtil::Clock::now();
+        for (long long t = 0; t < ticks; ++t) {
+            script.step(in);
+            game.setInput(in);
+
+            auto s0 = BenchUtil::Clock::now();
+            game.update(dt);
+            samples.push_back(BenchUtil::secondsSince(s0) * 1e6);
+            iterations += game.lastResolveStats().iterations;
+            obstaclesTested += game.lastResolveStats().obstaclesTested;
+
+            if (!game.isRunning()) { game.reset(); ++resets; }
+        }
+        double secs = BenchUtil::secondsSince(t0);
+        totalSeconds += secs;
+
+        all.insert(all.end(), samples.begin(), samples.end());
+        BenchUtil::Percentiles p = BenchUtil::summarize(samples);
+
+        std::string name = path;
+        size_t slash = name.find_last_of('/');
+        if (slash != std::string::npos) name = name.substr(slash + 1);
+
+        std::printf("%-32s %10lld %12.0f %10.2f %10.2f %10.2f %7d %9.2f %9.2f\n",
+                    name.c_str(), ticks, double(ticks) / secs, p.p50, p.p99, p.max, resets,
+                    double(iterations) / double(ticks), double(obstaclesTested) / double(ticks));
+    }
+
+    BenchUtil::Percentiles p = BenchUtil::summarize(all);
+    std::printf("%-32s %10zu %12.0f %10.2f %10.2f %10.2f\n",
+                "TOTAL", all.size(), double(all.size()) / totalSeconds, p.p50, p.p99, p.max);
+    return 0;
+}
@@ -17,10 +17,6 @@ struct Bullet {
 
     void spawn(const Vec2& p, const Vec2& v, float r, int owner);
 
-    void update(float dt);
-
-    bool isOutsideArena(const Arena& arena) const;
-
     bool hitsObstacle(const Obstacle& ob) const;
 };
 
@@ -0,0 +1,81 @@
+#ifndef ENTITY_BULLET_POOL_H
+#define ENTITY_BULLET_POOL_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Bullet.h"
+#include "../math/Vec2.h"
+#include "../world/Arena.h"
+
+// Fixed-capacity bullet storage in structure-of-arrays layout.
+// Live bullets are always packed in [0, size()); removal swaps the last bullet
+// into the freed slot, so order is not preserved. Storage is allocated up
+// front and only grows through reserve(), never while spawning.
+class BulletPool {
+public:
+    explicit BulletPool(int capacity = 1024);
+
+    int size() const;
+    int capacity() const;
+    bool empty() const;
+    bool full() const;
+
+    // Grows the capacity to at least `capacity`, keeping the live bullets.
+    void reserve(int capacity);
+
+    // Returns false (and drops the bullet) when the pool is full.
+    bool spawn(const Vec2& p, const Vec2& v, float r, int owner);
+
+    void removeAt(int i);
+    void clear();
+
+    // Copies current positions into the previous-position arrays; called once
+    // at the start of every simulation step.
+    void savePrevious();
+
+    // Moves every bullet by vel * dt.
+    void integrate(float dt);
+
+    // Removes the bullets whose center left the arena. Run after the swept hit
+    // tests, so a bullet that strikes something on its way out still counts.
+    void removeOutside(const Arena& arena);
+
+    // Raw copy of the live bullets (all arrays, previous positions included),
+    // for snapshots. readState() fails if `bullets` exceeds the capacity.
+    static size_t stateBytes(int bullets);
+    void writeState(uint8_t* dst) const;
+    bool readState(const uint8_t* src, int bullets);
+
+    // Fingerprint of the live bullets (not the previous positions).
+    uint64_t hash(uint64_t h) const;
+
+    // AoS copy of one bullet (rendering, debugging).
+    Bullet get(int i) const;
+
+    const float* posX() const;
+    const float* posY() const;
+    const float* prevX() const;
+    const float* prevY() const;
+    const float* velX() const;
+    const float* velY() const;
+    const float* radius() const;
+    const int* owner() const;
+
+private:
+    int count;
+    int cap;
+
+    std::vector<float> px;
+    std::vector<float> py;
+    std::vector<float> ox;
+    std::vector<float> oy;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> rad;
+    std::vector<int> own;
+
+    std::vector<uint8_t> outside;
+};
+
+#endif
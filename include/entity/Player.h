@@ -11,6 +11,23 @@ enum class PlayerId : int {
     P2 = 2
 };
 
+// Direction vectors derived from a player's heading and arm angle. Screen
+// axes are Y-down, so `left` is (f.y, -f.x). PlayerStore keeps one per entity,
+// refreshed only when the heading or arm changes, and both bullet spawning
+// and drawing read it instead of calling cos/sin again.
+struct PlayerPose {
+    Vec2 forward;
+    Vec2 left;
+    Vec2 right;
+    Vec2 armDir;    // weapon direction in world space
+
+    static PlayerPose fromAngles(float cosHeading, float sinHeading, float cosArm, float sinArm);
+
+    // Muzzle of the simulated weapon: it hangs off the right side of the head
+    // and is 1.65 head radii long. Bullets spawn just behind this point.
+    Vec2 weaponTip(const Vec2& pos, float headRadius) const;
+};
+
 struct Player {
     PlayerId id;
 
@@ -43,11 +60,25 @@ struct Player {
 
     void applyMovement(float dt, bool moveForward, bool moveBackward, bool turnLeft, bool turnRight);
 
+    // The movement rules on plain values, shared with PlayerStore so both
+    // integrate bit for bit alike (replay hashes depend on it). turnStep
+    // returns whether the heading changed; walkStep whether the player walked,
+    // along `forward` (the unit vector of the heading after turning).
+    static bool turnStep(float& headingRad, float turnSpeedRad, float dt, bool turnLeft, bool turnRight);
+    static bool walkStep(Vec2& pos, float& walkPhase, const Vec2& forward, float moveSpeed, float dt,
+                         bool moveForward, bool moveBackward);
+
     void setArmRelative(float relRad);
     void addArmRelative(float deltaRelRad);
 
     Vec2 armWorldDir() const;
 
+    // forward()/armWorldDir() and the perpendiculars, with libm cos/sin (the
+    // values the simulation uses).
+    PlayerPose pose() const;
+    // Same with Angle::sincos; for drawing interpolated players.
+    PlayerPose approxPose() const;
+
     void clampArm();
 };
 
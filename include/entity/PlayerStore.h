@@ -0,0 +1,109 @@
+#ifndef ENTITY_PLAYER_STORE_H
+#define ENTITY_PLAYER_STORE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Player.h"
+#include "../math/Vec2.h"
+
+// Player state in structure-of-arrays layout, indexed by entity id
+// (0 .. size() - 1). Entities are never removed during a match; a player
+// with lives <= 0 is simply out. Entity e plays as PlayerId(e + 1), which is
+// also the owner tag on its bullets.
+class PlayerStore {
+public:
+    PlayerStore();
+
+    int size() const;
+    void clear();
+
+    // Appends a player built from the template (position, radius, tuning)
+    // and returns its entity id. The template's id is replaced.
+    int add(const Player& p);
+
+    // AoS copy of one player (rendering, bullet spawning, debugging).
+    Player get(int e) const;
+    // Same, with the kinematic fields taken from the start of the last step.
+    Player getPrevious(int e) const;
+
+    // Copies the kinematic fields into the previous-step arrays.
+    void savePrevious();
+
+    void applyMovement(int e, float dt, bool moveForward, bool moveBackward, bool turnLeft, bool turnRight);
+    void setArmRelative(int e, float relRad);
+    void addArmRelative(int e, float deltaRelRad);
+    // Puts the arm at fraction t of its [armMinRelRad, armMaxRelRad] range.
+    void setArmFraction(int e, float t);
+
+    // Heading and arm vectors as of the last change to either angle.
+    PlayerPose pose(int e) const;
+
+    bool alive(int e) const;
+    int aliveCount() const;
+
+    Vec2 position(int e) const;
+    void setPosition(int e, const Vec2& p);
+
+    float* posX();
+    float* posY();
+    const float* posX() const;
+    const float* posY() const;
+    const float* prevX() const;
+    const float* prevY() const;
+    const float* headRadius() const;
+
+    int* lives();
+    const int* lives() const;
+
+    // Raw copy of every component array (current and previous step), for
+    // snapshots. readState() resizes the store to `players` entries.
+    static size_t stateBytes(int players);
+    void writeState(uint8_t* dst) const;
+    void readState(const uint8_t* src, int players);
+
+    // Fingerprint of the simulation state (not the previous-step copies).
+    uint64_t hash(uint64_t h) const;
+
+    // Trigger state: fire cooldown and whether fire was held last step
+    // (shots are edge-triggered).
+    float* cooldown();
+    uint8_t* fireHeld();
+    const float* cooldown() const;
+    const uint8_t* fireHeld() const;
+
+private:
+    void refreshPose(int e);
+
+    int count;
+
+    std::vector<float> px;
+    std::vector<float> py;
+    std::vector<float> heading;
+    std::vector<float> radius;
+    std::vector<float> arm;
+    std::vector<float> armMin;
+    std::vector<float> armMax;
+    std::vector<float> speed;
+    std::vector<float> turnSpeed;
+    std::vector<int> life;
+    std::vector<float> phase;
+    std::vector<uint8_t> walk;
+
+    // Derived from heading/arm by refreshPose(); not part of snapshots or the hash.
+    std::vector<float> headCos;
+    std::vector<float> headSin;
+    std::vector<float> armCos;
+    std::vector<float> armSin;
+
+    std::vector<float> cool;
+    std::vector<uint8_t> held;
+
+    std::vector<float> prevPx;
+    std::vector<float> prevPy;
+    std::vector<float> prevHeading;
+    std::vector<float> prevArm;
+    std::vector<float> prevPhase;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef GAME_BITMAP_FONT_H
+#define GAME_BITMAP_FONT_H
+
+#include <cstdint>
+
+#include "RenderBackend.h"
+
+// Built-in 5x7 font standing in for the GLUT bitmap fonts where GLUT is not
+// available (CPU rasterizer, GL contexts created without GLUT).
+namespace BitmapFont {
+
+const int kColumns = 5;
+const int kRows = 7;
+// Horizontal pixels per character at scale 1, spacing included.
+const int kAdvance = 6;
+
+// kColumns bytes, one per column with bit 0 at the top row. Characters
+// outside ASCII 32..126 come back as '?'.
+const uint8_t* glyph(char c);
+
+// Integer pixel scale that brings the font to roughly the height of the
+// GLUT font it replaces.
+int scaleFor(TextFont font);
+
+} // namespace BitmapFont
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef GAME_CAMERA_H
+#define GAME_CAMERA_H
+
+#include "../math/Rect.h"
+#include "../math/Vec2.h"
+#include "../world/Arena.h"
+
+// View onto the arena for a window of a given size, Y down. At zoom 1
+// without following it is the fixed camera the game always had: the arena's
+// bounding square stretched over the whole window, with nothing culled.
+// Zooming in or following switches to the same scale on both axes, narrowed
+// around the arena center or the target; the view then stays inside the
+// arena's box where it can.
+class Camera {
+public:
+    // Closest zoom allowed, in screen pixels per world unit.
+    static constexpr float kMaxPixelsPerUnit = 8.0f;
+
+    Camera();
+
+    void setViewport(int width, int height);
+
+    // Magnification relative to the whole-arena view; clamped on update().
+    void setZoom(float zoom);
+    void zoomBy(float factor);
+    float zoom() const;
+
+    void setFollow(bool follow);
+    bool isFollowing() const;
+
+    // Recomputes the view for a frame. `target` only matters when following.
+    void update(const Arena& arena, const Vec2& target);
+
+    // World rectangle mapped onto the viewport.
+    const Rect& view() const;
+    // What the backend should cull against: the view, or unbounded for the
+    // whole-arena view.
+    Rect cullRect() const;
+    float pixelsPerUnit() const;
+
+    bool showsWholeArena() const;
+
+private:
+    int viewportW;
+    int viewportH;
+    float zoomLevel;
+    bool following;
+
+    Rect rect;
+    float ppu;
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef GAME_FIXED_STEP_CLOCK_H
+#define GAME_FIXED_STEP_CLOCK_H
+
+// Accumulator that turns variable wall-clock frame times into a whole number
+// of fixed simulation steps. Time beyond the catch-up cap is dropped, so a long
+// hitch slows the game down briefly instead of stalling it with a burst of steps.
+class FixedStepClock {
+public:
+    explicit FixedStepClock(float stepSeconds = 1.0f / 60.0f, int maxStepsPerFrame = 5);
+
+    // Adds the elapsed frame time and returns how many steps to simulate now.
+    int advance(float frameSeconds);
+
+    // Fraction of a step left in the accumulator, in [0, 1); used to blend the
+    // previous and current simulation states when rendering.
+    float alpha() const;
+
+    float step() const;
+
+    // Wall time discarded by the catch-up cap since construction.
+    double droppedSeconds() const;
+
+private:
+    float stepSec;
+    int maxSteps;
+    float accumulator;
+    double dropped;
+};
+
+#endif
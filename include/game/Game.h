@@ -1,28 +1,57 @@
 #ifndef GAME_GAME_H
 #define GAME_GAME_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
 #include "../entity/Player.h"
-#include "../entity/Bullet.h"
+#include "../entity/PlayerStore.h"
+#include "../entity/BulletPool.h"
 #include "../world/Arena.h"
 #include "../world/Obstacle.h"
+#include "../world/ObstacleGrid.h"
+#include "../world/EntityGrid.h"
+#include "../io/SvgLoader.h"
 #include "InputState.h"
+#include "GameSnapshot.h"
+
+class RenderBackend;
 
 enum class GameState {
     RUNNING,
     GAME_OVER
 };
 
+// Work done by the player/world resolver during the last update().
+struct ResolveStats {
+    int iterations;       // push-out passes run, summed over players
+    int obstaclesTested;  // obstacle overlap tests (grid neighborhood only)
+    int pairsTested;      // player-player overlap tests (grid neighborhood only)
+};
+
 class Game {
 public:
     Game();
 
     bool loadFromSvg(const std::string& path);
+    // Same, from an already parsed scene (generated maps, benchmarks).
+    void loadScene(const SvgSceneData& data);
+
+    // Adds a player beyond the two from the map and returns its entity id.
+    // It is driven by setPlayerCommand and survives reset() (lives restored).
+    int addPlayer(const Vec2& pos, float headRadius);
+    int playerCount() const;
+    const PlayerStore& getPlayers() const;
+
+    // Controls for entity e from the next update() on. Entities 0 and 1 are
+    // overwritten from the InputState every step (see setInputDrivesPlayers).
+    void setPlayerCommand(int e, const PlayerCommand& cmd);
 
     void update(float deltaTime);
-    void render() const;
+    // Draws through `backend` (current for the duration of the call); alpha
+    // in [0, 1] blends the previous and current simulation steps.
+    void render(RenderBackend& backend, float alpha = 1.0f) const;
 
     void onKeyDown(unsigned char key);
     void onKeyUp(unsigned char key);
@@ -34,37 +63,103 @@ public:
     void reset();
 
     bool isRunning() const;
+    // Player number (entity + 1) that won the finished match; 0 for a draw
+    // or while the match is still running.
+    int getWinnerId() const;
 
     const Arena& getArena() const;
 
+    // Window size used to map mouse X to P1's arm angle.
+    void setViewportSize(int w, int h);
+
+    // Replaces the whole input state at once (scripted/headless drivers).
+    void setInput(const InputState& in);
+    const InputState& getInput() const;
+    int getViewportWidth() const;
+
+    // Number of reset() calls so far; lets recorders notice resets triggered
+    // from key events between steps.
+    unsigned getResetCount() const;
+
+    // Saves / restores all mutable state (see GameSnapshot). Restore fails,
+    // leaving the game untouched, on a snapshot from an incompatible Game.
+    void saveSnapshot(GameSnapshot& out) const;
+    bool restoreSnapshot(const GameSnapshot& in);
+
+    // Injects a bullet owned by entity `owner` (-1 for none); false when the
+    // pool is full. For scripted scenarios and benchmarks.
+    bool addBullet(const Vec2& pos, const Vec2& vel, float radius, int owner);
+    int bulletCount() const;
+    const BulletPool& getBullets() const;
+    const std::vector<Obstacle>& getObstacles() const;
+    const ObstacleGrid& getObstacleGrid() const;
+    // Version for Renderer::drawStaticLayer when drawing the obstacles
+    // outside render(); changes only when a scene is loaded.
+    unsigned getStaticLayerVersion() const;
+
+    // When off, players 1 and 2 also take their controls from
+    // setPlayerCommand (network server) instead of the InputState.
+    void setInputDrivesPlayers(bool on);
+
+    // Fingerprint of the full mutable simulation state (players, bullets,
+    // match state). Equal hashes after the same inputs mean identical runs.
+    uint64_t stateHash() const;
+
+    const ResolveStats& lastResolveStats() const;
+
+    // Shots lost to a full bullet pool since the scene was loaded.
+    long long droppedBulletCount() const;
+
 private:
     void updatePlayers(float dt);
     void updateBullets(float dt);
     void handleCollisions();
     void checkGameOver();
 
-    void spawnBulletFromPlayer(const Player& p);
+    void applyScene(const SvgSceneData& data);
+
+    // Pushes entity e out of nearby obstacles and back inside the arena until
+    // nothing moves (at most kMaxResolvePasses). Returns whether it was moved.
+    bool resolveWorldForPlayer(int e);
+    // One round of pairwise separation over the player grid; marks the moved
+    // entities in `touched` and returns whether any pair overlapped.
+    bool separatePlayers();
+
+    void commandsFromInput();
+    void spawnBulletFromPlayer(const Player& p, const PlayerPose& pose);
 
 private:
     GameState state;
 
     Arena arena;
     std::vector<Obstacle> obstacles;
+    ObstacleGrid obstacleGrid;
 
-    Player player1;
-    Player player2;
+    // Entity 0 is player 1, entity 1 is player 2. The store also keeps the
+    // state at the start of the last step, for render interpolation.
+    PlayerStore players;
+    EntityGrid playerGrid;
+    std::vector<PlayerCommand> commands;
+    std::vector<uint8_t> touched;
 
-    std::vector<Bullet> bullets;
+    BulletPool bullets;
 
     InputState input;
+    bool inputDrivesPlayers;
 
+    // Player number (entity + 1) of the last one standing; 0 for a draw.
     int winnerId;
+    unsigned resetCount;
+
+    int viewportWidth;
+    int viewportHeight;
 
-    bool prevMouseLeft;
-    bool prevKey5;
+    ResolveStats resolveStats;
+    long long droppedBullets;
 
-    float shootCooldownP1;
-    float shootCooldownP2;
+    // Changes whenever the arena/obstacles may have changed, so the renderer
+    // knows to rebuild its cached static layer. Unique across Game instances.
+    unsigned staticLayerVersion;
 };
 
 #endif
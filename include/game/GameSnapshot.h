@@ -0,0 +1,30 @@
+#ifndef GAME_GAME_SNAPSHOT_H
+#define GAME_GAME_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Copy of everything in a Game that changes during play: match state, input,
+// players (including trigger state and commands) and bullets. The arena,
+// obstacles and their grid are not included, so saving and restoring cost
+// only memcpy's proportional to the live entities.
+//
+// The buffer is one packed block (a POD header followed by the raw component
+// arrays) and is reused: saving into the same snapshot again does not
+// allocate unless the state grew. Only restore into the Game (or a copy of
+// it) that produced the snapshot.
+class GameSnapshot {
+public:
+    GameSnapshot();
+
+    bool empty() const;
+    size_t size() const;
+    const uint8_t* data() const;
+
+private:
+    friend class Game;
+    std::vector<uint8_t> bytes;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef GAME_GL_RENDER_BACKEND_H
+#define GAME_GL_RENDER_BACKEND_H
+
+#include "RenderBackend.h"
+#include "RenderBatch.h"
+
+// OpenGL output. Batched (default) appends everything to per-frame vertex
+// buffers and submits them in a few draw calls; immediate mode uses
+// glBegin/glEnd per primitive. Batching silently falls back to immediate if
+// the context lacks buffer objects.
+//
+// Every call needs a current GL context. The static layer is kept in static
+// vertex buffers (batched) or a display list (immediate).
+class GlRenderBackend : public RenderBackend {
+public:
+    GlRenderBackend();
+
+    void setBatching(bool enabled);
+    bool isBatching() const;
+
+    // Text through glBitmap with the built-in 5x7 font instead of GLUT
+    // bitmap fonts, for contexts not created by GLUT (offscreen benches).
+    void setBuiltinFont(bool enabled);
+
+    void beginFrame() override;
+    void endFrame() override;
+
+    bool beginStaticLayer(unsigned version) override;
+    void endStaticLayer() override;
+
+    void fillEllipse(const Vec2& c, float rx, float ry, float cr, float sr, Rgba8 color) override;
+    void strokeEllipse(const Vec2& c, float rx, float ry, float cr, float sr, float widthPx, Rgba8 color) override;
+    void outlinedCircle(const Vec2& c, float r, Rgba8 fill, Rgba8 stroke, float widthPx) override;
+    void fillQuad(const Vec2 p[4], Rgba8 color) override;
+    void strokeQuad(const Vec2 p[4], float widthPx, Rgba8 color) override;
+    void drawText(float x, float y, const char* text, TextFont font, Rgba8 color) override;
+
+    RenderStats frameStats() const override;
+
+private:
+    bool batching() const;
+    void setColor(Rgba8 c);
+    void setLineWidth(float w);
+    void emitVertex(float x, float y);
+    void beginImmediate(unsigned int mode);
+    void replayStaticLayer();
+
+private:
+    bool batchingEnabled;
+    bool builtinFont;
+    RenderBatch batch;
+
+    // Immediate-mode state cache so repeated colors/widths are not re-sent.
+    Rgba8 curColor;
+    bool colorValid;
+    float curLineWidth;
+
+    // Static layer: the batch's captured buffers or a display list.
+    bool staticBatched;
+    bool recordingStatic;
+    unsigned int staticList;
+    RenderStats staticListStats;
+    RenderStats listStart;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef GAME_INPUT_SCRIPT_H
+#define GAME_INPUT_SCRIPT_H
+
+#include <cstdint>
+
+#include "InputState.h"
+
+// Deterministic, seeded input generator used to drive both players without a
+// window (benchmarks, batch runs). Each player holds a randomly chosen
+// movement for a random number of ticks, sweeps its arm and fires
+// periodically, so every simulation path gets exercised.
+class InputScript {
+public:
+    explicit InputScript(uint32_t seed = 1, int viewportWidth = 500);
+
+    // Writes the input for the next tick into `in`.
+    void step(InputState& in);
+
+private:
+    uint32_t nextRandom();
+    int randomRange(int lo, int hi);
+
+    void pickAction(int& action, int& holdTicks);
+
+private:
+    uint32_t rngState;
+    int viewportW;
+    int tick;
+
+    int p1Action;
+    int p1Hold;
+    int p2Action;
+    int p2Hold;
+
+    int mouseX;
+    int mouseDir;
+    int p2ArmDir;
+};
+
+#endif
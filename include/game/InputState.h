@@ -3,6 +3,15 @@
 
 #include <cstdint>
 
+// Special key codes as delivered by GLUT's special-key callbacks (GLUT_KEY_*).
+// Mirrored here so the simulation core does not depend on GLUT headers.
+enum SpecialKeyCode : int {
+    SPECIAL_KEY_LEFT  = 100,
+    SPECIAL_KEY_UP    = 101,
+    SPECIAL_KEY_RIGHT = 102,
+    SPECIAL_KEY_DOWN  = 103
+};
+
 struct InputState {
     bool keys[256];
     bool specialKeys[256];
@@ -16,5 +25,26 @@ struct InputState {
     void clear();
 };
 
-#endif
+// One player's controls for a single step. Players 1 and 2 get theirs from
+// InputState (keyboard/mouse); any further players are driven by commands
+// set through Game::setPlayerCommand (bots, load tests).
+struct PlayerCommand {
+    bool forward;
+    bool backward;
+    bool turnLeft;
+    bool turnRight;
+    bool fire;          // edge-triggered, subject to the fire cooldown
+
+    bool aim;           // if set, put the arm at aimFraction of its range
+    float aimFraction;  // 0 = armMinRelRad, 1 = armMaxRelRad
+    float armRate;      // otherwise turn the arm at this rate (rad/s)
 
+    PlayerCommand();
+};
+
+// The local keyboard/mouse layouts: player 1 (WASD/arrows, mouse X aims,
+// left button fires) and player 2 (OKL;, 4/6 turn the arm, 5 fires).
+PlayerCommand player1Command(const InputState& in, int viewportWidth);
+PlayerCommand player2Command(const InputState& in);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef GAME_MATCH_POOL_H
+#define GAME_MATCH_POOL_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Game.h"
+#include "../util/WorkStealingPool.h"
+
+struct MatchResult {
+    int scenario;      // index returned by addScenario
+    uint32_t seed;     // InputScript seed that drove the match
+    long long ticks;   // simulation steps run
+    bool finished;     // reached game over before the tick limit
+    int winnerId;      // 0 for a draw or an unfinished match
+    int livesP1;
+    int livesP2;
+};
+
+// Runs many independent headless matches across cores. Scenarios are loaded
+// Game instances used as templates; each match copies one, drives it with a
+// seeded InputScript and steps it to the end (or a tick limit) on a
+// work-stealing pool. Only one Game per worker is alive at a time, so
+// thousands of matches cost no more memory than a handful.
+class MatchPool {
+public:
+    // threads <= 0 uses every hardware thread.
+    explicit MatchPool(int threads = 0);
+
+    int threadCount() const;
+
+    int addScenario(const Game& prototype);
+    int scenarioCount() const;
+
+    // Queues a match on scenario `scenario`; returns its index in results().
+    int addMatch(int scenario, uint32_t seed);
+    int matchCount() const;
+    void clearMatches();
+
+    // Plays every queued match and fills results(). Blocks until done.
+    void run(long long maxTicks, float dt = 1.0f / 60.0f);
+
+    const std::vector<MatchResult>& results() const;
+    long long totalTicks() const;
+    double lastRunSeconds() const;
+    uint64_t steals() const;
+
+private:
+    void playMatch(int i, long long maxTicks, float dt);
+
+private:
+    WorkStealingPool pool;
+    std::vector<Game> scenarios;
+    std::vector<MatchResult> matches;
+    double runSeconds;
+};
+
+#endif
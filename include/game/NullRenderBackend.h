@@ -0,0 +1,45 @@
+#ifndef GAME_NULL_RENDER_BACKEND_H
+#define GAME_NULL_RENDER_BACKEND_H
+
+#include "RenderBackend.h"
+
+// Draws nothing and only counts. The counters follow the immediate GL path:
+// one draw call per primitive, a fan of segments + 2 vertices per fill, a
+// loop of `segments` per outline, and a state change whenever the color or
+// line width differs from the previous one. The static layer is counted once
+// and replayed from the cache like a display list.
+//
+// Needs no GL context, so drawing cost can be measured (and compared across
+// builds) on headless machines.
+class NullRenderBackend : public RenderBackend {
+public:
+    NullRenderBackend();
+
+    void beginFrame() override;
+    void endFrame() override;
+
+    bool beginStaticLayer(unsigned version) override;
+    void endStaticLayer() override;
+
+    void fillEllipse(const Vec2& c, float rx, float ry, float cr, float sr, Rgba8 color) override;
+    void strokeEllipse(const Vec2& c, float rx, float ry, float cr, float sr, float widthPx, Rgba8 color) override;
+    void fillQuad(const Vec2 p[4], Rgba8 color) override;
+    void strokeQuad(const Vec2 p[4], float widthPx, Rgba8 color) override;
+    void drawText(float x, float y, const char* text, TextFont font, Rgba8 color) override;
+
+private:
+    void primitive(long drawCalls, long vertices, Rgba8 color);
+    void setLineWidth(float w);
+    void replayStaticLayer();
+
+private:
+    Rgba8 curColor;
+    bool colorValid;
+    float curLineWidth;
+
+    bool recordingStatic;
+    RenderStats staticStats;
+    RenderStats staticStart;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef GAME_RECORDING_RENDER_BACKEND_H
+#define GAME_RECORDING_RENDER_BACKEND_H
+
+#include <cstdint>
+#include <vector>
+
+#include "RenderBackend.h"
+
+// One captured draw call. Parameters depend on the op:
+//   FILL_ELLIPSE / STROKE_ELLIPSE  v = cx, cy, rx, ry, cos, sin
+//   FILL_CIRCLE / STROKE_CIRCLE    v = cx, cy, r
+//   OUTLINED_CIRCLE                v = cx, cy, r; color2 = outline
+//   FILL_QUAD / STROKE_QUAD        v = x0, y0 ... x3, y3
+//   TEXT                           v = x, y; characters at textOffset
+//   BEGIN_STATIC                   version
+// `width` is the stroke width in pixels.
+struct RenderCommand {
+    enum class Op : uint8_t {
+        FILL_ELLIPSE, STROKE_ELLIPSE, FILL_CIRCLE, STROKE_CIRCLE, OUTLINED_CIRCLE,
+        FILL_QUAD, STROKE_QUAD, TEXT, BEGIN_STATIC, END_STATIC
+    };
+
+    Op op;
+    TextFont font;
+    Rgba8 color;
+    Rgba8 color2;
+    float width;
+    float v[8];
+    unsigned version;
+    int textOffset;
+};
+
+// Captures the frame's draw calls so they can be inspected, fingerprinted
+// or replayed into another backend later (render regression checks, moving
+// drawing off the simulation thread).
+//
+// The static layer is recorded every frame between BEGIN_STATIC and
+// END_STATIC, so a recording is self-contained; replay lets the target use
+// its own cache for it.
+class RecordingRenderBackend : public RenderBackend {
+public:
+    RecordingRenderBackend();
+
+    // Drops the previous frame's commands.
+    void beginFrame() override;
+    void endFrame() override;
+
+    bool beginStaticLayer(unsigned version) override;
+    void endStaticLayer() override;
+
+    void fillEllipse(const Vec2& c, float rx, float ry, float cr, float sr, Rgba8 color) override;
+    void strokeEllipse(const Vec2& c, float rx, float ry, float cr, float sr, float widthPx, Rgba8 color) override;
+    void fillCircle(const Vec2& c, float r, Rgba8 color) override;
+    void strokeCircle(const Vec2& c, float r, float widthPx, Rgba8 color) override;
+    void outlinedCircle(const Vec2& c, float r, Rgba8 fill, Rgba8 stroke, float widthPx) override;
+    void fillQuad(const Vec2 p[4], Rgba8 color) override;
+    void strokeQuad(const Vec2 p[4], float widthPx, Rgba8 color) override;
+    void drawText(float x, float y, const char* text, TextFont font, Rgba8 color) override;
+
+    const std::vector<RenderCommand>& commands() const;
+    // NUL-terminated string of a TEXT command.
+    const char* text(const RenderCommand& cmd) const;
+
+    // Issues the recorded commands on `target`, between the caller's
+    // beginFrame/endFrame. The target's pixel scale is left alone.
+    void replay(RenderBackend& target) const;
+
+    // Fingerprint of the command stream (ops, parameters, text), for
+    // comparing frames across builds.
+    uint64_t hash() const;
+
+private:
+    RenderCommand& push(RenderCommand::Op op, Rgba8 color);
+
+private:
+    std::vector<RenderCommand> cmds;
+    std::vector<char> chars;
+};
+
+#endif
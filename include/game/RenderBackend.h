@@ -0,0 +1,113 @@
+#ifndef GAME_RENDER_BACKEND_H
+#define GAME_RENDER_BACKEND_H
+
+#include <cstdint>
+
+#include "../math/Rect.h"
+#include "../math/Vec2.h"
+
+struct Rgba8 {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+Rgba8 rgb(float r, float g, float b);
+
+// The two GLUT bitmap fonts the game uses: 8x13 and Helvetica 18.
+enum class TextFont : uint8_t { SMALL, LARGE };
+
+// Work done for one frame. Backends that do not draw report what the
+// immediate GL path would have sent.
+struct RenderStats {
+    long primitives;    // draw* calls received
+    long vertices;
+    long drawCalls;
+    long stateChanges;  // color / line width changes actually sent
+};
+
+// Where the Renderer's primitives go: GL, the CPU rasterizer, a counter or a
+// recording. The Renderer composes the scene (players, HUD...) out of these
+// calls; a backend only knows how to emit them.
+//
+// Coordinates are world units with Y down; stroke widths are in pixels.
+class RenderBackend {
+public:
+    RenderBackend();
+    virtual ~RenderBackend();
+
+    // World-to-screen scale. Curves are tessellated for the on-screen radius
+    // and pixel widths converted with it.
+    virtual void setPixelsPerUnit(float pixelsPerUnit);
+    float pixelsPerUnit() const;
+
+    // World rectangle on screen. The Renderer skips what lies outside it;
+    // unbounded (the default) draws everything.
+    void setViewRect(const Rect& view);
+    const Rect& viewRect() const;
+
+    virtual void beginFrame() = 0;
+    virtual void endFrame() = 0;
+
+    // Arena and obstacles are cached by the backend. beginStaticLayer returns
+    // true when they must be drawn now, followed by endStaticLayer; false
+    // means the cached copy was replayed. The cache is stale when `version`
+    // or the pixel scale changes, when the view leaves the area it covers,
+    // or after invalidateStaticLayer().
+    virtual bool beginStaticLayer(unsigned version) = 0;
+    virtual void endStaticLayer() = 0;
+    void invalidateStaticLayer();
+
+    // Area the static layer covers: while it is being drawn, the view plus a
+    // margin of half its size on every side, so a moving camera re-records
+    // it only every half screen.
+    const Rect& staticLayerRect() const;
+
+    virtual void fillEllipse(const Vec2& c, float rx, float ry, float cr, float sr, Rgba8 color) = 0;
+    virtual void strokeEllipse(const Vec2& c, float rx, float ry, float cr, float sr, float widthPx, Rgba8 color) = 0;
+    // Default to the ellipse calls.
+    virtual void fillCircle(const Vec2& c, float r, Rgba8 color);
+    virtual void strokeCircle(const Vec2& c, float r, float widthPx, Rgba8 color);
+    // Filled circle with an outline on top (obstacles, bullets).
+    virtual void outlinedCircle(const Vec2& c, float r, Rgba8 fill, Rgba8 stroke, float widthPx);
+    // Convex quad, either winding.
+    virtual void fillQuad(const Vec2 p[4], Rgba8 color) = 0;
+    virtual void strokeQuad(const Vec2 p[4], float widthPx, Rgba8 color) = 0;
+    // (x, y) is the baseline start, as with glRasterPos.
+    virtual void drawText(float x, float y, const char* text, TextFont font, Rgba8 color) = 0;
+
+    // Counters of the frame in progress, or of the last one after endFrame.
+    virtual RenderStats frameStats() const;
+
+protected:
+    // Polygon segments for a circle of `radius` world units: the fewest whose
+    // error stays under a quarter pixel. Always divides kMaxSegments.
+    int segmentsForRadius(float radius) const;
+    // Half of a line width given in pixels, in world units.
+    float halfWidthWorld(float widthPx) const;
+
+    // Static layer bookkeeping: staticLayerStale remembers `version` and the
+    // area to cover, and staticLayerRecorded marks the cache valid for them
+    // and the current scale.
+    bool staticLayerStale(unsigned version);
+    void staticLayerRecorded();
+
+public:
+    static const int kMaxSegments = 96;
+
+protected:
+    RenderStats stats;
+
+private:
+    float ppu;
+    Rect view;
+    bool staticValid;
+    unsigned staticVersion;
+    unsigned pendingVersion;
+    float staticPpu;
+    Rect staticRect;
+    Rect pendingRect;
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef GAME_RENDER_BATCH_H
+#define GAME_RENDER_BATCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "RenderBackend.h"
+#include "../math/Vec2.h"
+
+// Per-frame vertex streams for the batched GL path.
+//
+// Geometry is appended in painter's order and submitted in as few draw calls
+// as the order allows: consecutive triangles go out in one glDrawArrays,
+// consecutive filled+outlined circles in one instanced draw. Switching between
+// the two kinds (or calling flush) closes the current run.
+//
+// Everything here targets GL 1.5 VBOs plus, when available, GLSL 1.20 with
+// instanced arrays (GL 3.3 / ARB_instanced_arrays); without the latter the
+// caller is told to expand circles into triangles itself. Mesa's llvmpipe
+// provides both.
+class RenderBatch {
+public:
+    struct Vertex {
+        float x;
+        float y;
+        Rgba8 color;
+    };
+
+    struct CircleInstance {
+        float x;
+        float y;
+        float radius;
+        float halfWidth;
+        Rgba8 fill;
+        Rgba8 stroke;
+    };
+
+    RenderBatch();
+
+    // Creates GL objects on first use. Needs a current context; returns false
+    // if buffer objects are unavailable (the caller then stays immediate).
+    bool init();
+    bool ready() const;
+    bool supportsInstancing() const;
+
+    void addTriangle(const Vec2& a, const Vec2& b, const Vec2& c, Rgba8 color);
+    void addQuad(const Vec2& p0, const Vec2& p1, const Vec2& p2, const Vec2& p3, Rgba8 color);
+
+    // `segments` is the tessellation wanted for this instance; one instanced
+    // draw uses the finest level requested by any instance in it.
+    void addCircleInstance(const CircleInstance& inst, int segments);
+
+    // Submits everything queued so far.
+    void flush();
+
+    // Between beginCapture and endCapture, flushed runs are uploaded into
+    // static buffers instead of being drawn; drawCaptured replays them. One
+    // capture is kept at a time; beginCapture discards the previous one.
+    void beginCapture();
+    void endCapture();
+    void drawCaptured();
+    void clearCaptured();
+    bool hasCaptured() const;
+
+    void resetStats();
+    long verticesSubmitted() const;
+    long drawCalls() const;
+
+private:
+    enum class Run { NONE, TRIANGLES, CIRCLES };
+
+    struct CapturedRun {
+        Run kind;
+        unsigned int vbo;
+        int count;      // triangle vertices, or circle instances
+        int segments;
+    };
+
+    void beginRun(Run kind);
+    void flushTriangles();
+    void flushCircles();
+    void drawTriangleBuffer(unsigned int vbo, int vertexCount);
+    void drawCircleBuffer(unsigned int vbo, int instanceCount, int segments);
+    bool buildCircleProgram();
+    void ensureCircleMesh(int segments);
+
+private:
+    bool initTried;
+    bool initOk;
+    bool instancing;
+
+    Run run;
+
+    std::vector<Vertex> triangles;
+    std::vector<CircleInstance> circles;
+    int circleSegments;
+
+    bool capturing;
+    bool captured;
+    std::vector<CapturedRun> capturedRuns;
+
+    unsigned int streamVbo;
+    unsigned int instanceVbo;
+    unsigned int meshVbo;
+    unsigned int circleProgram;
+
+    // meshFirst[n] / meshCount[n]: vertex range of the n-segment circle mesh
+    // inside meshVbo (count 0 = not built yet).
+    std::vector<int> meshFirst;
+    std::vector<int> meshCount;
+    std::vector<float> meshData;
+
+    long vertexCounter;
+    long drawCallCounter;
+};
+
+#endif
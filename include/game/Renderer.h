@@ -1,20 +1,81 @@
 #ifndef GAME_RENDERER_H
 #define GAME_RENDERER_H
 
+#include <vector>
+
+#include "../math/Rect.h"
 #include "../world/Arena.h"
 #include "../world/Obstacle.h"
+#include "../world/ObstacleGrid.h"
 #include "../entity/Player.h"
 #include "../entity/Bullet.h"
 
+class RenderBackend;
+
+// Composes the scene (arena, players, bullets, HUD) out of primitives and
+// sends them to the current backend. Without one set, a null backend counts
+// the work and draws nothing. The current backend and all scratch state are
+// per thread, so separate threads can draw separate games at once.
 class Renderer {
 public:
+    // For the calling thread. Not owned; nullptr goes back to the built-in
+    // null backend.
+    static void setBackend(RenderBackend* backend);
+    static RenderBackend& backend();
+
+    // Makes a backend current until the end of the scope.
+    class BackendScope {
+    public:
+        explicit BackendScope(RenderBackend& backend);
+        ~BackendScope();
+
+        BackendScope(const BackendScope&) = delete;
+        BackendScope& operator=(const BackendScope&) = delete;
+
+    private:
+        RenderBackend* previous;
+    };
+
+    // World-to-screen scale of the current backend; circle tessellation is
+    // chosen from the on-screen radius so small primitives get fewer segments.
+    static void setPixelsPerUnit(float pixelsPerUnit);
+    // World rectangle on screen; see RenderBackend::setViewRect.
+    static void setViewRect(const Rect& view);
+
+    // Frame bracket on the current backend.
+    static void beginFrame();
+    static void endFrame();
+
+    static long verticesThisFrame();
+    static long drawCallsThisFrame();
+
+    // Arena outline plus the obstacles, cached by the backend and replayed on
+    // later frames. The cache is rebuilt when `version` changes (the game
+    // bumps it when a scene is loaded), when the pixel scale changes or when
+    // the view leaves the area it covers. With a bounded view only the
+    // obstacles in that area are drawn, found through `grid` (built over
+    // `obstacles`), in their original order.
+    static void drawStaticLayer(const Arena& arena, const std::vector<Obstacle>& obstacles,
+                                const ObstacleGrid& grid, unsigned version);
+    static void invalidateStaticLayer();
+
     static void drawArena(const Arena& arena);
     static void drawObstacle(const Obstacle& obstacle);
+    // `pose` must match the player's heading and arm; the one-argument form
+    // derives it with Angle::sincos.
+    // Players and bullets outside the backend's view are skipped.
+    static void drawPlayer(const Player& player, const PlayerPose& pose);
     static void drawPlayer(const Player& player);
     static void drawBullet(const Bullet& bullet);
 
+    // Screen text is placed in the view, or over the arena when the view is unbounded.
     static void drawHud(const Arena& arena, int livesP1, int livesP2);
     static void drawGameOver(const Arena& arena, int winnerId);
+
+    // Per-zone timings from the Profiler, listed under the HUD.
+    static void setProfileOverlay(bool visible);
+    static bool isProfileOverlay();
+    static void drawProfileOverlay(const Arena& arena);
 };
 
 #endif
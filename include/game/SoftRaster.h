@@ -0,0 +1,138 @@
+#ifndef GAME_SOFT_RASTER_H
+#define GAME_SOFT_RASTER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "RenderBackend.h"
+#include "../math/Vec2.h"
+
+class WorkStealingPool;
+
+// CPU renderer for headless frames: draws the Renderer's primitives into an
+// RGBA8 framebuffer without a GL context.
+//
+// Primitives are recorded in painter's order and only rasterized by finish().
+// finish() bins them into 64x64 tiles and renders the tiles independently
+// (in parallel when threads > 1), each tile walking its shapes in order, so
+// the result does not depend on the thread count. Edges are antialiased
+// analytically from the signed distance to the shape (one pixel ramp);
+// coverage is computed four pixels at a time with SSE2 and interior runs of
+// opaque shapes are plain stores.
+//
+// As a RenderBackend, the static layer is kept as a copy of the framebuffer
+// and each rasterized shape counts as a draw call.
+class SoftRaster : public RenderBackend {
+public:
+    SoftRaster();
+    ~SoftRaster();
+
+    SoftRaster(const SoftRaster&) = delete;
+    SoftRaster& operator=(const SoftRaster&) = delete;
+
+    // Reallocates the framebuffer; false (and no change) for sizes outside
+    // 1..16384. Drops the saved background.
+    bool resize(int width, int height);
+    int width() const;
+    int height() const;
+
+    // Row-major, top row first; each pixel is R, G, B, A bytes in memory.
+    const uint32_t* pixels() const;
+
+    // World point (x, y) maps to pixel ((x - originX) * s, (y - originY) * s).
+    void setView(float originX, float originY, float pixelsPerUnit);
+    void setPixelsPerUnit(float pixelsPerUnit) override;
+    // Uniform scale that fits the square of half side `halfExtent` around
+    // `center`, centered in the framebuffer. Returns the scale.
+    float fitView(const Vec2& center, float halfExtent);
+
+    // 1 renders on the calling thread; 0 picks the hardware thread count.
+    void setThreads(int threads);
+    int threads() const;
+
+    // Color of each frame's background.
+    void setClearColor(Rgba8 clear);
+
+    // Starts a frame that begins from the clear color; endFrame is finish().
+    void beginFrame() override;
+    void endFrame() override;
+    // Renders what was recorded so far and keeps the result; later frames
+    // can start from it with restoreBackground() instead of redrawing.
+    void captureBackground();
+    bool hasBackground() const;
+    // Drops everything recorded in this frame; it now starts from the
+    // captured background.
+    void restoreBackground();
+
+    bool beginStaticLayer(unsigned version) override;
+    void endStaticLayer() override;
+
+    void fillCircle(const Vec2& c, float r, Rgba8 color) override;
+    void strokeCircle(const Vec2& c, float r, float widthPx, Rgba8 color) override;
+    // Ellipse with radii (rx, ry) rotated by the angle whose cos/sin are (cr, sr).
+    void fillEllipse(const Vec2& c, float rx, float ry, float cr, float sr, Rgba8 color) override;
+    void strokeEllipse(const Vec2& c, float rx, float ry, float cr, float sr, float widthPx, Rgba8 color) override;
+    void fillQuad(const Vec2 p[4], Rgba8 color) override;
+    void strokeQuad(const Vec2 p[4], float widthPx, Rgba8 color) override;
+    // Built-in 5x7 font in place of the GLUT bitmaps.
+    void drawText(float x, float y, const char* text, TextFont font, Rgba8 color) override;
+
+    // Rasterizes every recorded primitive into the framebuffer.
+    void finish();
+
+    // Wall time of the last finish().
+    double millisecondsLastFrame() const;
+
+private:
+    enum class Kind : uint8_t { CIRCLE, RING, ELLIPSE, ELLIPSE_RING, POLYGON, TEXT };
+
+    // One primitive in pixel space with its clipped pixel bounds
+    // [x0, x1) x [y0, y1). Parameters depend on the kind (see SoftRaster.cpp).
+    struct Shape {
+        Kind kind;
+        Rgba8 color;
+        int x0, y0, x1, y1;
+        float p[12];
+        int textOffset;
+        int textLength;
+    };
+
+    // What a tile starts from in finish(): the clear color, the captured
+    // background, or the framebuffer as left by an earlier finish().
+    enum class Base { CLEAR, BACKGROUND, KEEP };
+
+    bool addShape(Shape& s, float minX, float minY, float maxX, float maxY);
+    void addPolygon(const Vec2* px, int n, Rgba8 color);
+    void renderTile(int tile);
+    void rasterRow(const Shape& s, int y, int xa, int xb, uint32_t* row) const;
+
+private:
+    int w;
+    int h;
+    std::vector<uint32_t> frame;
+    std::vector<uint32_t> background;
+    bool backgroundValid;
+
+    float viewX;
+    float viewY;
+    float scale;
+
+    Base base;
+    Rgba8 clearColor;
+
+    std::vector<Shape> shapes;
+    std::vector<char> text;
+
+    int tilesX;
+    int tilesY;
+    std::vector<std::vector<int>> bins;
+
+    int threadCount;
+    std::unique_ptr<WorkStealingPool> pool;
+
+    double lastMs;
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef IO_ARENA_GENERATOR_H
+#define IO_ARENA_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+
+#include "SvgLoader.h"
+
+enum class ArenaLayout {
+    UNIFORM,    // spread evenly over the disk
+    CLUSTERED,  // dense clumps with open ground between them
+    RING,       // concentric rings, opened by a doorway on each side
+    CORRIDOR    // parallel walls of packed obstacles with doorways
+};
+
+struct ArenaGenParams {
+    ArenaLayout layout;
+    long long obstacles;
+    uint32_t seed;
+
+    ArenaGenParams();
+};
+
+// Seeded stress arenas for load/tick/render scaling runs. The arena grows
+// with the obstacle count so the obstacle density of a layout is about the
+// same from 10^2 to 10^6 obstacles, and obstacles keep the size of the
+// hand-made maps. Both players (head radius as in assets/arena.svg) start on
+// the horizontal axis with free space around them. The same parameters give
+// the same scene.
+class ArenaGenerator {
+public:
+    static const int kLayoutCount = 4;
+
+    static void generate(const ArenaGenParams& params, SvgSceneData& out);
+
+    // Arena (blue), players (green/red) and obstacles (black), as SvgLoader reads them.
+    static bool writeSvg(const std::string& path, const SvgSceneData& scene);
+
+    static const char* layoutName(ArenaLayout layout);
+    static bool parseLayout(const std::string& name, ArenaLayout& out);
+};
+
+#endif
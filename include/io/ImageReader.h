@@ -0,0 +1,22 @@
+#ifndef IO_IMAGE_READER_H
+#define IO_IMAGE_READER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Reads images back into RGBA8 framebuffers (R, G, B, A bytes per pixel, top
+// row first), for comparing frames with stored references. PNG support
+// covers what image tools commonly write for screenshots: 8-bit gray, RGB
+// and RGBA (with or without alpha), any filter, no interlacing. Inflate is
+// built in, so no zlib is needed. Returns false on anything else or on a
+// damaged file.
+class ImageReader {
+public:
+    static bool readPpm(const std::string& path, std::vector<uint32_t>& rgba, int& width, int& height);
+    static bool readPng(const std::string& path, std::vector<uint32_t>& rgba, int& width, int& height);
+    // PNG when the path ends in ".png", PPM otherwise.
+    static bool read(const std::string& path, std::vector<uint32_t>& rgba, int& width, int& height);
+};
+
+#endif
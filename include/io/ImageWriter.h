@@ -0,0 +1,19 @@
+#ifndef IO_IMAGE_WRITER_H
+#define IO_IMAGE_WRITER_H
+
+#include <cstdint>
+#include <string>
+
+// Writes RGBA8 framebuffers (R, G, B, A bytes per pixel, top row first) as
+// 24-bit images; alpha is dropped. PNG output needs no zlib: it uses fixed
+// Huffman deflate with "same as the previous pixel" matches only, which is
+// enough for flat-shaded frames and keeps the writer self-contained.
+class ImageWriter {
+public:
+    static bool writePpm(const std::string& path, const uint32_t* rgba, int width, int height);
+    static bool writePng(const std::string& path, const uint32_t* rgba, int width, int height);
+    // PNG when the path ends in ".png", PPM otherwise.
+    static bool write(const std::string& path, const uint32_t* rgba, int width, int height);
+};
+
+#endif
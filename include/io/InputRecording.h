@@ -0,0 +1,86 @@
+#ifndef IO_INPUT_RECORDING_H
+#define IO_INPUT_RECORDING_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../game/InputState.h"
+
+// Per-tick input of a session (keys, special keys, mouse X and button), plus
+// the viewport width used to map mouse X, and resets triggered between steps.
+//
+// File layout: a fixed little-endian header, then one record per tick on
+// which something changed:
+//   varint  ticks since the previous record (the first is relative to tick 0)
+//   u8      flags: 1 key toggles, 2 mouse X, 4 mouse button toggled,
+//                  8 viewport width, 16 reset before this tick
+//   [varint count, varint index...]  toggled keys; 256+ are special keys
+//   [zigzag varint]                  mouse X delta
+//   [varint]                         viewport width
+// Held inputs cost nothing, so a long session is a few bytes per change.
+struct InputRecordingInfo {
+    uint32_t simHz;
+    uint64_t tickCount;
+    uint64_t mapHash;    // SceneCache::contentHash of the SVG played on
+    uint64_t finalHash;  // Game::stateHash after the last tick, 0 if unknown
+
+    InputRecordingInfo();
+};
+
+class InputRecorder {
+public:
+    InputRecorder();
+
+    void begin(uint32_t simHz, uint64_t mapHash);
+
+    // Appends the input used for the next tick.
+    void record(const InputState& in, int viewportWidth, bool resetBefore);
+
+    uint64_t ticks() const;
+    const std::vector<uint8_t>& body() const;
+
+    // Writes header + body; finalHash goes into the header for verification.
+    bool save(const std::string& path, uint64_t finalHash) const;
+
+private:
+    InputRecordingInfo info;
+    std::vector<uint8_t> data;
+
+    InputState last;
+    int lastViewportWidth;
+    uint64_t lastRecordTick;
+};
+
+class InputReplay {
+public:
+    InputReplay();
+
+    bool load(const std::string& path);
+    const std::string& error() const;
+    const InputRecordingInfo& info() const;
+
+    // Rewinds to tick 0.
+    void restart();
+
+    // Produces the input of the next tick; false once the recording ends.
+    bool next(InputState& in, int& viewportWidth, bool& resetBefore);
+
+private:
+    bool fail(const char* msg);
+
+private:
+    InputRecordingInfo header;
+    std::vector<uint8_t> data;
+    std::string err;
+
+    size_t cursor;
+    uint64_t tick;
+    uint64_t nextChangeTick;
+    bool hasPending;
+
+    InputState current;
+    int viewportWidth;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef IO_MAPPED_FILE_H
+#define IO_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only memory mapping of a whole file (POSIX mmap). Falls back to reading
+// into a heap buffer when the file cannot be mapped (e.g. pipes). Move-only.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& o) noexcept;
+    MappedFile& operator=(MappedFile&& o) noexcept;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const;
+    const char* data() const;
+    size_t size() const;
+    std::string_view view() const;
+
+private:
+    const char* ptr;
+    size_t len;
+    bool mapped;
+    bool opened;
+    std::string fallback;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef IO_SCENE_CACHE_H
+#define IO_SCENE_CACHE_H
+
+#include <cstdint>
+#include <string>
+
+#include "SvgLoader.h"
+#include "../world/ObstacleGrid.h"
+
+// Compiled binary form of a loaded SVG scene plus its obstacle grid, so a
+// later launch can skip XML parsing, color classification, arena selection
+// and the grid build.
+//
+// Cache files are named after a 64-bit content hash of the source SVG and
+// live in $TRABALHOCG_CACHE_DIR, else $XDG_CACHE_HOME/trabalhocg, else
+// ~/.cache/trabalhocg. The file is a versioned POD header followed by 16-byte
+// aligned sections in host byte order (tagged, so a foreign-endian file is
+// rejected); it records the source size and a payload checksum, and anything
+// that fails validation is ignored and rebuilt.
+// Setting TRABALHOCG_NO_SCENE_CACHE disables the cache.
+//
+// The content hash says nothing about the code that produced the data, so
+// files also carry kBuilderVersion, which is part of their name too. Every
+// new file trims the directory back to kMaxDirectoryBytes, dropping the
+// least recently used files first (hits refresh a file's time).
+class SceneCache {
+public:
+    // Bump whenever SvgLoader or ObstacleGrid::build would produce different
+    // output for the same SVG; older files are then never read again.
+    static constexpr uint32_t kBuilderVersion = 1;
+
+    static constexpr uint64_t kMaxDirectoryBytes = 256ull << 20;
+
+    enum class Result {
+        HIT,        // loaded from a valid cache file
+        BUILT,      // parsed the SVG and wrote a new cache file
+        UNCACHED,   // parsed the SVG; cache disabled or not writable
+        FAILED      // the SVG itself could not be loaded
+    };
+
+    // Loads `svgPath` into `scene`/`grid`, through the cache when possible.
+    static Result load(const std::string& svgPath, SvgSceneData& scene, ObstacleGrid& grid);
+
+    // Overrides the cache directory (empty string restores the default lookup).
+    static void setDirectory(const std::string& dir);
+    static std::string directory();
+
+    // Non-cryptographic 64-bit hash used as the cache key.
+    static uint64_t contentHash(const void* data, size_t size);
+    // contentHash of a whole file; false if it cannot be read.
+    static bool hashFile(const std::string& path, uint64_t& hash);
+
+    static bool read(const std::string& cachePath, uint64_t sourceHash, uint64_t sourceSize,
+                     SvgSceneData& scene, ObstacleGrid& grid);
+    static bool write(const std::string& cachePath, uint64_t sourceHash, uint64_t sourceSize,
+                      const SvgSceneData& scene, const ObstacleGrid& grid);
+
+    // Deletes the oldest cache files in `dir` until it holds at most
+    // `maxBytes`; `keep` (a path in `dir`) is never deleted.
+    static void trim(const std::string& dir, uint64_t maxBytes, const std::string& keep);
+};
+
+#endif
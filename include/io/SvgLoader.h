@@ -25,25 +25,14 @@ struct SvgSceneData {
     SvgSceneData();
 };
 
+// Loads the initial scene from an SVG file in one streaming pass (see
+// XmlSaxParser). Circles inside <g> groups are placed through the accumulated
+// `transform`s, fill is resolved from attributes, `style` and inheritance, and
+// anything under <defs> or display:none is ignored. The result is stored by
+// SceneCache: bump SceneCache::kBuilderVersion when it changes.
 class SvgLoader {
 public:
     static bool load(const std::string& path, SvgSceneData& out);
-
-private:
-    static bool parseFloat(const char* s, float& out);
-    static bool parseCircleAttributes(
-        const char* cxStr,
-        const char* cyStr,
-        const char* rStr,
-        float& cx,
-        float& cy,
-        float& r
-    );
-
-    static bool isBlueFill(const char* fill);
-    static bool isGreenFill(const char* fill);
-    static bool isRedFill(const char* fill);
-    static bool isBlackFill(const char* fill);
 };
 
 #endif
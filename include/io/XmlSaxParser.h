@@ -0,0 +1,47 @@
+#ifndef IO_XML_SAX_PARSER_H
+#define IO_XML_SAX_PARSER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Attribute of the element currently being reported. Both views point into
+// the parsed text and are only valid during the callback; entity references
+// in values are not expanded.
+struct XmlAttribute {
+    std::string_view name;
+    std::string_view value;
+};
+
+class XmlSaxHandler {
+public:
+    virtual ~XmlSaxHandler();
+
+    // selfClosing elements (<a/>) get no matching endElement call.
+    virtual void startElement(std::string_view name, const XmlAttribute* attrs, int attrCount, bool selfClosing) = 0;
+    virtual void endElement(std::string_view name) = 0;
+};
+
+// Single-pass, non-validating streaming XML parser. It reports elements and
+// attributes as views into the input and never builds a tree: memory use is
+// bounded by the nesting depth and the largest attribute count. Comments,
+// processing instructions, DOCTYPE, CDATA and character data are skipped.
+class XmlSaxParser {
+public:
+    XmlSaxParser();
+
+    // Returns false on malformed input; error() then describes the problem.
+    bool parse(std::string_view text, XmlSaxHandler& handler);
+
+    const std::string& error() const;
+
+private:
+    bool fail(std::string_view text, size_t pos, const char* msg);
+
+private:
+    std::vector<XmlAttribute> attrs;
+    std::vector<std::string_view> openElements;
+    std::string err;
+};
+
+#endif
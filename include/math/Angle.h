@@ -2,6 +2,8 @@
 #define MATH_ANGLE_H
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace Angle {
 
@@ -14,18 +16,57 @@ static inline float clamp(float v, float lo, float hi) {
     return (v < lo) ? lo : ((v > hi) ? hi : v);
 }
 
+static inline float twoPi() { return 2.0f * pi(); }
+
+// Constant time for any finite angle (one floor, no loop per turn). Angles
+// within one turn of the range come out exactly as a single +-2*pi step would
+// leave them, so stepping a heading by small deltas is unaffected.
 static inline float wrapPi(float a) {
-    while (a <= -pi()) a += 2.0f * pi();
-    while (a >  pi()) a -= 2.0f * pi();
+    a -= twoPi() * std::floor(a * (1.0f / twoPi()) + 0.5f);
+    // The rounded quotient can be off by one next to the boundaries.
+    if (a <= -pi()) a += twoPi();
+    if (a >  pi()) a -= twoPi();
     return a;
 }
 
 static inline float wrap2Pi(float a) {
-    while (a < 0.0f) a += 2.0f * pi();
-    while (a >= 2.0f * pi()) a -= 2.0f * pi();
+    a -= twoPi() * std::floor(a * (1.0f / twoPi()));
+    if (a < 0.0f) a += twoPi();
+    if (a >= twoPi()) a -= twoPi();
     return a;
 }
 
+// Sine and cosine together, without libm and without branches. The angle is
+// reduced by the nearest multiple of pi/2 (pi/2 split in three parts,
+// Cody-Waite style) and two short minimax polynomials are evaluated on
+// [-pi/4, pi/4]. Max absolute error: 9.3e-8 for |a| <= 100, under 1e-6 for
+// |a| <= 65536 (measured by the "pose" bench suite); larger angles should be
+// wrapped first. Pure float arithmetic, so results are the same on every
+// platform, but they differ from std::sin/std::cos in the last bit or two:
+// use it for drawing, not for simulation state.
+static inline void sincos(float a, float& s, float& c) {
+    // Adding and removing 1.5 * 2^23 rounds to the nearest integer.
+    const float k = (a * (2.0f / pi()) + 12582912.0f) - 12582912.0f;
+    const int q = int(k);
+    const float r = ((a - k * 1.5703125f) - k * 4.837512969970703125e-4f) - k * 7.54978995489188216e-8f;
+    const float r2 = r * r;
+
+    const float sr = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+    const float cr = 1.0f - 0.5f * r2 +
+                     r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+    // Odd quadrants swap sin and cos and the signs follow the quadrant; done
+    // on the bit patterns so random angles don't cost branch mispredictions.
+    uint32_t sb, cb;
+    std::memcpy(&sb, &sr, sizeof(sb));
+    std::memcpy(&cb, &cr, sizeof(cb));
+    const uint32_t swap = 0u - uint32_t(q & 1);
+    const uint32_t sOut = ((sb & ~swap) | (cb & swap)) ^ (uint32_t(q & 2) << 30);
+    const uint32_t cOut = ((cb & ~swap) | (sb & swap)) ^ (uint32_t((q + 1) & 2) << 30);
+    std::memcpy(&s, &sOut, sizeof(s));
+    std::memcpy(&c, &cOut, sizeof(c));
+}
+
 } // namespace Angle
 
 #endif
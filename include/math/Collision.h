@@ -16,6 +16,47 @@ bool circleInsideArena(const Vec2& p, float r, const Arena& arena);
 
 bool circleHitsObstacle(const Vec2& p, float r, const Obstacle& ob);
 
+// Swept (continuous) tests. A circle of radius r moving from p0 to p1 over the
+// step is tested against a circle at c; on contact `t` receives the time of
+// impact in [0, 1] (0 when they already overlap at p0). Unlike the end-position
+// tests above, nothing is missed when the step is longer than the target.
+bool sweepCircleCircle(const Vec2& p0, const Vec2& p1, float r, const Vec2& c, float cr, float& t);
+
+// Both circles moving linearly over the same step (a: a0 -> a1, b: b0 -> b1).
+bool sweepCircles(const Vec2& a0, const Vec2& a1, float ar,
+                  const Vec2& b0, const Vec2& b1, float br, float& t);
+
+/* ===== Batch queries ===== */
+
+// Circles in structure-of-arrays form: `count` entries from each pointer.
+struct CircleSpan {
+    const float* x;
+    const float* y;
+    const float* r;
+    int count;
+};
+
+// sweepCircleCircle against every circle of the span at once. Returns the
+// index of the earliest contact (the lowest index on equal times) or -1, and
+// its time in `t`. Every path computes each time with the same IEEE
+// operations as the scalar test, so the result is bit-identical to calling
+// sweepCircleCircle in order and keeping the first minimum.
+int sweepCircleFirst(const Vec2& p0, const Vec2& p1, float r, const CircleSpan& circles, float& t);
+
+// Kernel used by the batch queries. The best one the CPU supports is picked
+// on first use; TRABALHOCG_SIMD=scalar|sse|avx2 overrides it.
+enum class BatchLevel {
+    SCALAR,
+    SSE,   // 4 lanes
+    AVX2   // 8 lanes
+};
+
+BatchLevel batchLevel();
+// False (level unchanged) if the CPU or build lacks it.
+bool setBatchLevel(BatchLevel level);
+bool batchLevelSupported(BatchLevel level);
+const char* batchLevelName(BatchLevel level);
+
 } // namespace Collision
 
 #endif
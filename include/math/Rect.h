@@ -0,0 +1,52 @@
+#ifndef MATH_RECT_H
+#define MATH_RECT_H
+
+#include <limits>
+
+#include "Vec2.h"
+
+// Axis-aligned world rectangle (Y down, so min is the top-left corner).
+// Defined inline like Vec2; culling tests run once per drawn object.
+struct Rect {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+
+    constexpr Rect() : minX(0.0f), minY(0.0f), maxX(0.0f), maxY(0.0f) {}
+    constexpr Rect(float x0, float y0, float x1, float y1) : minX(x0), minY(y0), maxX(x1), maxY(y1) {}
+
+    // Covers the whole plane: nothing is culled against it.
+    static constexpr Rect unbounded() {
+        return Rect(-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                    std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
+    }
+
+    static constexpr Rect around(const Vec2& c, float halfW, float halfH) {
+        return Rect(c.x - halfW, c.y - halfH, c.x + halfW, c.y + halfH);
+    }
+
+    bool isBounded() const {
+        return maxX - minX < std::numeric_limits<float>::infinity() &&
+               maxY - minY < std::numeric_limits<float>::infinity();
+    }
+
+    constexpr float width() const { return maxX - minX; }
+    constexpr float height() const { return maxY - minY; }
+
+    constexpr bool contains(const Rect& o) const {
+        return o.minX >= minX && o.minY >= minY && o.maxX <= maxX && o.maxY <= maxY;
+    }
+
+    // Conservative: tests the circle's bounding box.
+    constexpr bool overlapsCircle(const Vec2& c, float r) const {
+        return c.x + r >= minX && c.x - r <= maxX && c.y + r >= minY && c.y - r <= maxY;
+    }
+
+    // Grown by `margin` world units on every side.
+    constexpr Rect expanded(float margin) const {
+        return Rect(minX - margin, minY - margin, maxX + margin, maxY + margin);
+    }
+};
+
+#endif
@@ -3,33 +3,40 @@
 
 #include <cmath>
 
+// Defined inline so the collision and physics loops do not pay a call per
+// operator (the build has no LTO).
 struct Vec2 {
     float x;
     float y;
 
-    Vec2();
-    Vec2(float px, float py);
+    constexpr Vec2() : x(0.0f), y(0.0f) {}
+    constexpr Vec2(float px, float py) : x(px), y(py) {}
 
-    Vec2 operator+(const Vec2& o) const;
-    Vec2 operator-(const Vec2& o) const;
-    Vec2 operator*(float s) const;
-    Vec2 operator/(float s) const;
+    constexpr Vec2 operator+(const Vec2& o) const { return Vec2(x + o.x, y + o.y); }
+    constexpr Vec2 operator-(const Vec2& o) const { return Vec2(x - o.x, y - o.y); }
+    constexpr Vec2 operator*(float s) const { return Vec2(x * s, y * s); }
+    constexpr Vec2 operator/(float s) const { return Vec2(x / s, y / s); }
 
-    Vec2& operator+=(const Vec2& o);
-    Vec2& operator-=(const Vec2& o);
-    Vec2& operator*=(float s);
-    Vec2& operator/=(float s);
+    constexpr Vec2& operator+=(const Vec2& o) { x += o.x; y += o.y; return *this; }
+    constexpr Vec2& operator-=(const Vec2& o) { x -= o.x; y -= o.y; return *this; }
+    constexpr Vec2& operator*=(float s) { x *= s; y *= s; return *this; }
+    constexpr Vec2& operator/=(float s) { x /= s; y /= s; return *this; }
 
-    float length() const;
-    float lengthSq() const;
+    float length() const { return std::sqrt(x * x + y * y); }
+    constexpr float lengthSq() const { return x * x + y * y; }
 
-    Vec2 normalized() const;
+    Vec2 normalized() const {
+        float len = length();
+        if (len == 0.0f) return Vec2(0.0f, 0.0f);
+        return Vec2(x / len, y / len);
+    }
 
-    static float dot(const Vec2& a, const Vec2& b);
-    static float cross(const Vec2& a, const Vec2& b);
+    static constexpr float dot(const Vec2& a, const Vec2& b) { return a.x * b.x + a.y * b.y; }
+    static constexpr float cross(const Vec2& a, const Vec2& b) { return a.x * b.y - a.y * b.x; }
 };
 
-Vec2 operator*(float s, const Vec2& v);
+constexpr Vec2 operator*(float s, const Vec2& v) {
+    return Vec2(v.x * s, v.y * s);
+}
 
 #endif
-
@@ -0,0 +1,57 @@
+#ifndef NET_LINK_CONDITIONER_H
+#define NET_LINK_CONDITIONER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "UdpSocket.h"
+
+// Outgoing side of a socket with simulated packet loss and one-way latency
+// (plus uniform jitter, which may reorder packets). Both ends of a
+// connection condition what they send, so a localhost test sees loss in both
+// directions and a round trip of twice the latency. With the defaults every
+// packet goes straight out.
+class LinkConditioner {
+public:
+    explicit LinkConditioner(UdpSocket& socket, uint32_t seed = 1);
+
+    void configure(float lossFraction, int latencyMs, int jitterMs);
+    bool isIdeal() const;
+
+    // Drops, delays or sends the datagram. Counts it as sent either way.
+    void send(const NetAddress& to, const uint8_t* data, size_t size, uint64_t nowUs);
+    // Sends the delayed datagrams that are due.
+    void flush(uint64_t nowUs);
+
+    // Payload bytes and datagrams handed to send(), and how many were dropped.
+    uint64_t bytesSent() const;
+    uint64_t packetsSent() const;
+    uint64_t packetsDropped() const;
+
+private:
+    struct Pending {
+        uint64_t dueUs;
+        NetAddress to;
+        std::vector<uint8_t> data;
+    };
+
+    uint32_t nextRandom();
+
+private:
+    UdpSocket& sock;
+    uint32_t rngState;
+
+    float loss;
+    int latencyUs;
+    int jitterUs;
+
+    // Kept sorted by due time.
+    std::vector<Pending> queue;
+
+    uint64_t sentBytes;
+    uint64_t sentPackets;
+    uint64_t droppedPackets;
+};
+
+#endif
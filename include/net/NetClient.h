@@ -0,0 +1,113 @@
+#ifndef NET_NET_CLIENT_H
+#define NET_NET_CLIENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LinkConditioner.h"
+#include "NetProtocol.h"
+#include "UdpSocket.h"
+
+// Replicated state at one instant, ready to draw.
+struct NetView {
+    bool running;
+    int winnerId;
+    std::vector<Player> players;
+    std::vector<Bullet> bullets;
+
+    NetView();
+};
+
+// Traffic and latency seen by one client.
+struct NetClientReport {
+    uint64_t bytesReceived;
+    uint64_t snapshots;
+    uint64_t undecodable;       // baseline no longer held; the server falls back to full
+    std::vector<float> latencyMs;  // input sent -> first snapshot that includes it
+
+    NetClientReport();
+};
+
+// Thin client: sends one PlayerCommand per tick and keeps the snapshots it
+// receives, rendering a little behind the newest one so it can always
+// interpolate between two of them. It never simulates.
+class NetClient {
+public:
+    enum class Status {
+        IDLE,
+        CONNECTING,
+        CONNECTED,
+        FAILED
+    };
+
+    NetClient();
+
+    // Opens a local socket and starts the handshake; `mapHash` must match the
+    // server's map (0 skips the check).
+    bool connect(const NetAddress& server, uint64_t mapHash, std::string& error);
+    void disconnect(uint64_t nowUs);
+
+    // Reads pending datagrams and retries the handshake.
+    void poll(uint64_t nowUs);
+
+    Status status() const;
+    const std::string& error() const;
+
+    // Valid once connected.
+    int entity() const;
+    float simulationRate() const;
+    const Arena& arena() const;
+
+    void sendCommand(const PlayerCommand& cmd, uint64_t nowUs);
+
+    // State interpolated at the render time for `nowUs`; false until the
+    // first snapshot arrives.
+    bool sample(uint64_t nowUs, NetView& out) const;
+
+    LinkConditioner& link();
+    const NetClientReport& report() const;
+
+private:
+    void handleWelcome(Net::ByteReader& r);
+    void handleSnapshot(Net::ByteReader& r, uint64_t nowUs);
+
+    Net::WorldFrame* slot(uint32_t tick);
+    const Net::WorldFrame* frame(uint32_t tick) const;
+    double serverTicks(uint64_t nowUs) const;
+
+private:
+    UdpSocket socket;
+    LinkConditioner conditioner;
+    NetAddress server;
+    uint64_t expectedMapHash;
+
+    Status state;
+    std::string lastError;
+    uint64_t helloSentUs;
+    uint64_t connectStartUs;
+
+    int ownEntity;
+    float simHz;
+    int snapshotInterval;
+    Arena serverArena;
+    Net::Quantizer quantizer;
+
+    std::vector<Net::WorldFrame> frames;  // ring of kFrameHistory, by tick
+    uint32_t newestTick;
+    uint32_t oldestTick;
+    // Local time in ticks minus server tick, lowest seen (slowly relaxed).
+    double tickOffset;
+    bool haveOffset;
+
+    uint32_t inputSeq;
+    uint32_t lastAckedInput;
+    std::vector<PlayerCommand> sentCommands;  // ring, by sequence
+    std::vector<uint64_t> sentTimes;
+
+    NetClientReport stats;
+    std::vector<uint8_t> packet;
+    std::vector<uint8_t> recvBuf;
+};
+
+#endif
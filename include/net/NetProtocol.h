@@ -0,0 +1,163 @@
+#ifndef NET_NET_PROTOCOL_H
+#define NET_NET_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../entity/Player.h"
+#include "../entity/Bullet.h"
+#include "../world/Arena.h"
+#include "../game/InputState.h"
+
+class Game;
+
+// Wire format shared by NetServer and NetClient. Every datagram starts with
+// a one-byte message type; integers are little-endian, counts and deltas are
+// LEB128 varints.
+//
+//   HELLO     client -> server  version, map hash
+//   WELCOME   server -> client  version, entity, sim rate, snapshot interval,
+//                               map hash, arena center/radius
+//   INPUT     client -> server  newest input sequence, acked snapshot tick,
+//                               the last few commands (newest first), so a
+//                               lost packet is covered by the next one
+//   SNAPSHOT  server -> client  tick, baseline tick (0 = full), last applied
+//                               input sequence, match state, then the world
+//                               frame delta-coded against the baseline
+//   BYE       either way        disconnect
+namespace Net {
+
+const uint32_t kProtocolVersion = 1;
+const uint16_t kDefaultPort = 27515;
+// Largest datagram either side reads.
+const size_t kMaxDatagram = 65507;
+// Commands repeated in each INPUT packet.
+const int kInputRedundancy = 4;
+// Snapshots kept on both sides for delta baselines.
+const int kFrameHistory = 64;
+
+enum MessageType : uint8_t {
+    MSG_HELLO = 1,
+    MSG_WELCOME = 2,
+    MSG_INPUT = 3,
+    MSG_SNAPSHOT = 4,
+    MSG_BYE = 5
+};
+
+uint64_t nowMicros();
+
+/* ===== Byte streams ===== */
+
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<uint8_t>& out);
+
+    void u8(uint8_t v);
+    void u16(uint16_t v);
+    void u32(uint32_t v);
+    void u64(uint64_t v);
+    void f32(float v);
+    void varint(uint64_t v);
+    void svarint(int64_t v);
+
+private:
+    std::vector<uint8_t>& buf;
+};
+
+// Reads past the end return zero and clear ok().
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size);
+
+    uint8_t u8();
+    uint16_t u16();
+    uint32_t u32();
+    uint64_t u64();
+    float f32();
+    uint64_t varint();
+    int64_t svarint();
+
+    bool ok() const;
+    bool atEnd() const;
+
+private:
+    const uint8_t* p;
+    size_t size;
+    size_t pos;
+    bool good;
+};
+
+/* ===== Commands ===== */
+
+void writeCommand(ByteWriter& w, const PlayerCommand& c);
+PlayerCommand readCommand(ByteReader& r);
+
+/* ===== World frames ===== */
+
+// Per-entity fields, each quantized to 16 bits, in delta-coding order.
+enum PlayerField {
+    PF_X, PF_Y,        // relative to the arena center, in units of radius / 32000
+    PF_HEADING,        // [0, 2pi) over 65536 steps
+    PF_ARM,            // signed, 1/10000 rad
+    PF_PHASE,          // walk phase modulo 2pi
+    PF_RADIUS,         // 1/16 unit
+    PF_LIVES,
+    PF_WALKING,
+    kPlayerFields
+};
+
+enum BulletField {
+    BF_X, BF_Y,        // as PF_X / PF_Y
+    BF_VX, BF_VY,      // signed, 1/8 unit/s
+    BF_RADIUS,         // 1/16 unit
+    BF_OWNER,
+    kBulletFields
+};
+
+// One quantized snapshot of the replicated state.
+struct WorldFrame {
+    uint32_t tick;
+    uint8_t state;     // 0 running, 1 game over
+    uint16_t winner;
+    std::vector<uint16_t> players;  // kPlayerFields per player
+    std::vector<uint16_t> bullets;  // kBulletFields per bullet
+
+    WorldFrame();
+
+    int playerCount() const;
+    int bulletCount() const;
+};
+
+// Maps world values to and from the 16-bit fields of a WorldFrame.
+class Quantizer {
+public:
+    Quantizer();
+    explicit Quantizer(const Arena& arena);
+
+    void capture(const Game& game, uint32_t tick, WorldFrame& out) const;
+
+    Player player(const WorldFrame& f, int e) const;
+    Bullet bullet(const WorldFrame& f, int i) const;
+
+    Vec2 position(uint16_t qx, uint16_t qy) const;
+
+private:
+    uint16_t quantizeCoord(float v, float center) const;
+
+private:
+    Arena arena;
+    float scale;  // quantization steps per world unit
+};
+
+// Appends `cur` coded against `base` (null for a full frame). Each entity
+// writes a bit mask of the fields that differ from the same slot of the
+// baseline, then those fields as zigzag varint deltas; slots the baseline
+// lacks count as all zero. An unchanged player costs one byte.
+void encodeFrame(const WorldFrame& cur, const WorldFrame* base, ByteWriter& w);
+// Reverse of encodeFrame; `out.tick`, state and winner are left untouched.
+bool decodeFrame(ByteReader& r, const WorldFrame* base, WorldFrame& out);
+
+} // namespace Net
+
+#endif
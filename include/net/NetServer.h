@@ -0,0 +1,98 @@
+#ifndef NET_NET_SERVER_H
+#define NET_NET_SERVER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LinkConditioner.h"
+#include "NetProtocol.h"
+#include "UdpSocket.h"
+
+class Game;
+
+// Traffic counters for one connected client.
+struct NetClientStats {
+    uint64_t bytesSent;      // snapshot payload bytes
+    uint64_t snapshots;
+    uint64_t fullSnapshots;  // sent without a baseline
+    uint64_t inputPackets;
+
+    NetClientStats();
+};
+
+// Authoritative server: owns the simulation, takes each client's commands
+// over UDP and sends every client a snapshot every `snapshotInterval` ticks,
+// delta-coded against the newest snapshot that client acknowledged.
+// Clients take over the map's players in join order; later ones get a new
+// player from Game::addPlayer. A finished match restarts after a pause.
+class NetServer {
+public:
+    NetServer(Game& game, uint64_t mapHash);
+
+    bool start(uint16_t port, std::string& error);
+    uint16_t port() const;
+
+    void setSimulationRate(float hz);
+    void setSnapshotInterval(int ticks);
+    LinkConditioner& link();
+
+    // Reads every pending datagram, then runs one simulation step and sends
+    // the snapshots that are due.
+    void step(uint64_t nowUs);
+    uint32_t tick() const;
+
+    struct ClientInfo {
+        NetAddress address;
+        int entity;
+        NetClientStats stats;
+    };
+    std::vector<ClientInfo> clients() const;
+
+private:
+    struct Client {
+        NetAddress address;
+        int entity;
+        uint64_t lastHeardUs;
+
+        uint32_t lastInputSeq;    // newest command received
+        uint32_t appliedInputSeq; // newest command a step has used
+        PlayerCommand command;
+        bool firePending;         // a press seen since the last step
+
+        uint32_t ackedTick;       // newest snapshot the client decoded
+        NetClientStats stats;
+    };
+
+    void receive(uint64_t nowUs);
+    void handleHello(const NetAddress& from, Net::ByteReader& r, uint64_t nowUs);
+    void handleInput(Client& c, Net::ByteReader& r, uint64_t nowUs);
+    void dropIdleClients(uint64_t nowUs);
+    void sendWelcome(const Client& c, uint64_t nowUs);
+    void sendSnapshot(Client& c, uint64_t nowUs);
+
+    Client* findClient(const NetAddress& a);
+    int freeEntity() const;
+    const Net::WorldFrame* historyFrame(uint32_t tick) const;
+
+private:
+    Game& game;
+    uint64_t mapHash;
+
+    UdpSocket socket;
+    LinkConditioner conditioner;
+
+    float simHz;
+    int snapshotInterval;
+    uint32_t currentTick;
+    int gameOverTicks;
+
+    Net::Quantizer quantizer;
+    std::vector<Net::WorldFrame> history;  // ring of kFrameHistory, by tick
+    std::vector<Client> connected;
+
+    std::vector<uint8_t> packet;
+    std::vector<uint8_t> recvBuf;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef NET_UDP_SOCKET_H
+#define NET_UDP_SOCKET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// IPv4 endpoint, host byte order.
+struct NetAddress {
+    uint32_t ip;
+    uint16_t port;
+
+    NetAddress();
+    NetAddress(uint32_t ip, uint16_t port);
+
+    // "host:port" or "host" (port left as `defaultPort`); host may be a name.
+    static bool parse(const std::string& text, uint16_t defaultPort, NetAddress& out);
+    static NetAddress loopback(uint16_t port);
+
+    std::string toString() const;
+
+    bool operator==(const NetAddress& o) const;
+    bool operator!=(const NetAddress& o) const;
+};
+
+// Non-blocking POSIX UDP socket.
+class UdpSocket {
+public:
+    UdpSocket();
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    // Binds to `port` on every interface (0 picks a free port).
+    bool open(uint16_t port, std::string& error);
+    void close();
+    bool isOpen() const;
+    uint16_t localPort() const;
+
+    bool send(const NetAddress& to, const uint8_t* data, size_t size);
+    // Size of the datagram read into `buf`, or -1 when nothing is queued.
+    int receive(NetAddress& from, uint8_t* buf, size_t capacity);
+    // Waits up to timeoutMs for a datagram; false on timeout.
+    bool waitReadable(int timeoutMs) const;
+
+private:
+    int fd;
+    uint16_t boundPort;
+};
+
+#endif
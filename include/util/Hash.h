@@ -0,0 +1,29 @@
+#ifndef UTIL_HASH_H
+#define UTIL_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Hash {
+
+static const uint64_t kSeed = 0xcbf29ce484222325ull;
+
+// FNV-1a over raw bytes, chainable through `h`. Used for state fingerprints
+// (replay verification), not for hash tables or anything adversarial.
+static inline uint64_t bytes(const void* data, size_t size, uint64_t h = kSeed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+template <typename T>
+static inline uint64_t value(const T& v, uint64_t h) {
+    return bytes(&v, sizeof(T), h);
+}
+
+} // namespace Hash
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef UTIL_PROFILER_H
+#define UTIL_PROFILER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Phases timed by the built-in profiler.
+enum class ProfileZone : uint8_t {
+    FRAME,              // frame mark to frame mark
+    UPDATE_PLAYERS,
+    UPDATE_BULLETS,
+    HANDLE_COLLISIONS,
+    CHECK_GAME_OVER,
+    DRAW_STATIC,        // drawStaticLayer (arena + obstacles)
+    DRAW_PLAYERS,
+    DRAW_BULLETS,
+    DRAW_HUD,           // drawHud, drawGameOver, overlay text
+    RENDER_SUBMIT,      // Renderer::endFrame (batched draw calls)
+    COUNT
+};
+
+// Rolling numbers for one zone over the events still in the ring.
+struct ProfileZoneStats {
+    int calls;
+    double meanUs;
+    double p50Us;
+    double p99Us;
+    double maxUs;
+    double perFrameUs;  // total time per FRAME mark (0 without frame marks)
+
+    ProfileZoneStats();
+};
+
+// Process-wide event profiler. Scopes record (zone, thread, start, duration)
+// into a fixed ring of the newest kCapacity events. Writers from any thread
+// claim a slot with one atomic increment and publish it with a per-slot
+// sequence number, so readers never block them and skip slots being
+// rewritten. Disabled (the default), a scope costs one relaxed load.
+class Profiler {
+public:
+    static const uint32_t kCapacity = 1u << 16;
+
+    static void setEnabled(bool on);
+    static bool isEnabled();
+
+    static const char* zoneName(ProfileZone zone);
+
+    // Nanoseconds since the first use of the profiler.
+    static uint64_t nowNs();
+
+    static void record(ProfileZone zone, uint64_t startNs, uint64_t endNs);
+    // Closes the current frame and opens the next one.
+    static void frameMark();
+
+    class Scope {
+    public:
+        explicit Scope(ProfileZone zone);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ProfileZone zone;
+        uint64_t start;
+    };
+
+    struct Event {
+        uint64_t startNs;
+        uint32_t durationNs;
+        ProfileZone zone;
+        uint16_t thread;
+    };
+
+    // Consistent copy of the events in the ring, oldest first.
+    static void snapshot(std::vector<Event>& out);
+    static void clear();
+    // Events recorded since the start, including ones already overwritten.
+    static uint64_t totalEvents();
+
+    // Per-zone statistics over the newest `maxEvents` events.
+    static void summarize(std::vector<ProfileZoneStats>& out, uint32_t maxEvents = 8192);
+
+    // One row per event: zone,thread,start_us,duration_us.
+    static bool writeCsv(const std::string& path);
+    // Chrome trace-event JSON (chrome://tracing, Perfetto), complete events.
+    static bool writeChromeTrace(const std::string& path);
+};
+
+#endif
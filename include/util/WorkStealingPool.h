@@ -0,0 +1,63 @@
+#ifndef UTIL_WORK_STEALING_POOL_H
+#define UTIL_WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads, each with its own task deque. A worker takes
+// from the back of its own deque and, when that runs dry, steals from the
+// front of the others, so uneven task lengths still keep every core busy.
+// The calling thread takes part as worker 0, so a 1-thread pool runs inline.
+class WorkStealingPool {
+public:
+    // threads <= 0 picks std::thread::hardware_concurrency().
+    explicit WorkStealingPool(int threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int threadCount() const;
+
+    // Runs fn(i) for every i in [0, count) and returns once all have finished.
+    // Indices are dealt round-robin across the workers' deques. Not reentrant.
+    void parallelFor(int count, const std::function<void(int)>& fn);
+
+    // Tasks taken from another worker's deque since construction.
+    uint64_t steals() const;
+
+private:
+    struct Queue {
+        std::mutex m;
+        std::deque<int> items;
+    };
+
+    void workerLoop(int w);
+    void drain(int w);
+    bool popLocal(int w, int& item);
+    bool steal(int w, int& item);
+
+private:
+    int workerCount;
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex m;
+    std::condition_variable wake;
+    std::condition_variable done;
+    uint64_t generation;
+    bool stopping;
+
+    const std::function<void(int)>* job;
+    std::atomic<int> remaining;
+    std::atomic<uint64_t> stealCount;
+};
+
+#endif
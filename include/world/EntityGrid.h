@@ -0,0 +1,64 @@
+#ifndef WORLD_ENTITY_GRID_H
+#define WORLD_ENTITY_GRID_H
+
+#include <vector>
+
+#include "Arena.h"
+
+// Uniform grid over moving circles (players), rebuilt every tick. Each entity
+// is registered only in the cell holding its center and queries are widened
+// by the largest radius, so an entity is reported at most once per query.
+// Storage is CSR like ObstacleGrid and is reused between builds.
+class EntityGrid {
+public:
+    EntityGrid();
+
+    // Registers every entity with alive[e] > 0. Cells cover the arena; centers
+    // outside it are clamped into the border cells.
+    void build(const float* x, const float* y, const float* r, const int* alive, int n, const Arena& arena);
+
+    float maxRadius() const;
+
+    // Calls fn(int entity) for every entity whose circle may overlap the box.
+    // Stops as soon as fn returns true and reports whether that happened.
+    template <typename Fn>
+    bool queryBox(float minX, float minY, float maxX, float maxY, Fn&& fn) const {
+        if (items.empty()) return false;
+
+        int c0 = cellCoord(minX - maxR - originX);
+        int r0 = cellCoord(minY - maxR - originY);
+        int c1 = cellCoord(maxX + maxR - originX);
+        int r1 = cellCoord(maxY + maxR - originY);
+
+        for (int row = r0; row <= r1; ++row) {
+            for (int col = c0; col <= c1; ++col) {
+                int c = row * cells + col;
+                for (int k = cellStart[c]; k < cellStart[c + 1]; ++k) {
+                    if (fn(items[k])) return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    int cellCoord(float offset) const {
+        int v = int(offset * invCell);
+        if (v < 0) return 0;
+        if (v >= cells) return cells - 1;
+        return v;
+    }
+
+private:
+    float originX;
+    float originY;
+    float invCell;
+    float maxR;
+    int cells;  // per axis
+
+    std::vector<int> cellStart;
+    std::vector<int> items;
+    std::vector<int> cellOf;
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef WORLD_OBSTACLE_GRID_H
+#define WORLD_OBSTACLE_GRID_H
+
+#include <algorithm>
+#include <vector>
+
+#include "../math/Vec2.h"
+#include "Obstacle.h"
+
+// Static uniform grid over the obstacles, built once per loaded map.
+// Cells are stored CSR-style: cellStart[c]..cellStart[c + 1] indexes into the
+// entry arrays, which hold a copy of each obstacle's circle in
+// structure-of-arrays form so a cell is one contiguous span for the batch
+// narrowphase (Collision::sweepCircleFirst). An obstacle is registered in
+// every cell its bounding box overlaps, so box queries may report it more
+// than once.
+class ObstacleGrid {
+public:
+    // One registration; also the record layout of the scene cache.
+    struct Entry {
+        float x;
+        float y;
+        float r;
+        int index;
+    };
+
+    ObstacleGrid();
+
+    // The result is stored by SceneCache: bump SceneCache::kBuilderVersion
+    // when it changes.
+    void build(const std::vector<Obstacle>& obstacles);
+    void clear();
+
+    // Installs a grid produced earlier by build() (e.g. from the scene cache).
+    // Returns false, leaving the grid empty, if the arrays are inconsistent.
+    bool assign(float originX, float originY, float cellSize, int cols, int rows,
+                const int* cellStart, const Entry* entries, int entryCount, int obstacleCount);
+
+    float gridOriginX() const;
+    float gridOriginY() const;
+    const std::vector<int>& cellStartArray() const;
+    int entryCount() const;
+    Entry entry(int k) const;
+
+    bool empty() const;
+    float cellSize() const;
+    int columns() const;
+    int rows() const;
+
+    // Index of the first obstacle touched by a circle of radius r sweeping from
+    // p0 to p1 this tick, or -1; `toi` (optional) receives the time of impact
+    // in [0, 1]. Only cells covered by the swept circle are examined.
+    int findHit(const Vec2& p0, const Vec2& p1, float r, float* toi = nullptr) const;
+
+    // Calls fn(const Entry&) for every entry in the cells overlapped by the box.
+    // Stops as soon as fn returns true and reports whether that happened.
+    template <typename Fn>
+    bool queryBox(float minX, float minY, float maxX, float maxY, Fn&& fn) const {
+        if (entryIndex.empty()) return false;
+        if (maxX < originX || maxY < originY) return false;
+        if (minX > originX + float(cols) * cell || minY > originY + float(rowCount) * cell) return false;
+
+        int c0 = cellCoord(minX - originX, cols);
+        int r0 = cellCoord(minY - originY, rowCount);
+        int c1 = cellCoord(maxX - originX, cols);
+        int r1 = cellCoord(maxY - originY, rowCount);
+
+        for (int row = r0; row <= r1; ++row) {
+            for (int col = c0; col <= c1; ++col) {
+                int c = row * cols + col;
+                for (int k = cellStart[c]; k < cellStart[c + 1]; ++k) {
+                    if (fn(entry(k))) return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Calls fn(const Entry&) once per obstacle registered in the cells
+    // overlapped by the box (a superset of the obstacles touching it). An
+    // obstacle is reported from the first of its cells inside the box only.
+    template <typename Fn>
+    void forEachInBox(float minX, float minY, float maxX, float maxY, Fn&& fn) const {
+        if (entryIndex.empty()) return;
+        if (maxX < originX || maxY < originY) return;
+        if (minX > originX + float(cols) * cell || minY > originY + float(rowCount) * cell) return;
+
+        int c0 = cellCoord(minX - originX, cols);
+        int r0 = cellCoord(minY - originY, rowCount);
+        int c1 = cellCoord(maxX - originX, cols);
+        int r1 = cellCoord(maxY - originY, rowCount);
+
+        for (int row = r0; row <= r1; ++row) {
+            for (int col = c0; col <= c1; ++col) {
+                int c = row * cols + col;
+                for (int k = cellStart[c]; k < cellStart[c + 1]; ++k) {
+                    float x = entryX[k], y = entryY[k], r = entryR[k];
+                    int firstCol = std::max(cellCoord(x - r - originX, cols), c0);
+                    int firstRow = std::max(cellCoord(y - r - originY, rowCount), r0);
+                    if (firstCol == col && firstRow == row) fn(entry(k));
+                }
+            }
+        }
+    }
+
+private:
+    int cellCoord(float offset, int limit) const {
+        int v = int(offset * invCell);
+        if (v < 0) return 0;
+        if (v >= limit) return limit - 1;
+        return v;
+    }
+
+private:
+    float originX;
+    float originY;
+    float cell;
+    float invCell;
+    int cols;
+    int rowCount;
+
+    std::vector<int> cellStart;
+    std::vector<float> entryX;
+    std::vector<float> entryY;
+    std::vector<float> entryR;
+    std::vector<int> entryIndex;
+};
+
+#endif
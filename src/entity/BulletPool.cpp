@@ -0,0 +1,158 @@
+#include "../../include/entity/BulletPool.h"
+#include "../../include/util/Hash.h"
+
+#include <algorithm>
+#include <cstring>
+
+BulletPool::BulletPool(int capacity)
+    : count(0),
+      cap(capacity > 0 ? capacity : 1),
+      px(size_t(cap)),
+      py(size_t(cap)),
+      ox(size_t(cap)),
+      oy(size_t(cap)),
+      vx(size_t(cap)),
+      vy(size_t(cap)),
+      rad(size_t(cap)),
+      own(size_t(cap)),
+      outside(size_t(cap)) {}
+
+int BulletPool::size() const { return count; }
+int BulletPool::capacity() const { return cap; }
+bool BulletPool::empty() const { return count == 0; }
+bool BulletPool::full() const { return count >= cap; }
+
+void BulletPool::reserve(int capacity) {
+    if (capacity <= cap) return;
+    cap = capacity;
+    for (std::vector<float>* a : {&px, &py, &ox, &oy, &vx, &vy, &rad}) a->resize(size_t(cap));
+    own.resize(size_t(cap));
+    outside.resize(size_t(cap));
+}
+
+bool BulletPool::spawn(const Vec2& p, const Vec2& v, float r, int owner) {
+    if (count >= cap) return false;
+    int i = count++;
+    px[i] = p.x;
+    py[i] = p.y;
+    ox[i] = p.x;
+    oy[i] = p.y;
+    vx[i] = v.x;
+    vy[i] = v.y;
+    rad[i] = r;
+    own[i] = owner;
+    return true;
+}
+
+void BulletPool::removeAt(int i) {
+    if (i < 0 || i >= count) return;
+    int last = --count;
+    if (i == last) return;
+    px[i] = px[last];
+    py[i] = py[last];
+    ox[i] = ox[last];
+    oy[i] = oy[last];
+    vx[i] = vx[last];
+    vy[i] = vy[last];
+    rad[i] = rad[last];
+    own[i] = own[last];
+}
+
+void BulletPool::clear() {
+    count = 0;
+}
+
+void BulletPool::savePrevious() {
+    std::copy(px.begin(), px.begin() + count, ox.begin());
+    std::copy(py.begin(), py.begin() + count, oy.begin());
+}
+
+void BulletPool::integrate(float dt) {
+    const int n = count;
+    float* __restrict x = px.data();
+    float* __restrict y = py.data();
+    const float* __restrict velx = vx.data();
+    const float* __restrict vely = vy.data();
+
+    for (int i = 0; i < n; ++i) {
+        x[i] += velx[i] * dt;
+        y[i] += vely[i] * dt;
+    }
+}
+
+void BulletPool::removeOutside(const Arena& arena) {
+    const int n = count;
+    const float* __restrict x = px.data();
+    const float* __restrict y = py.data();
+    uint8_t* __restrict out = outside.data();
+
+    const float cx = arena.center.x;
+    const float cy = arena.center.y;
+    const float r2 = arena.radius * arena.radius;
+
+    // Branch-free so the compiler can vectorize the test.
+    for (int i = 0; i < n; ++i) {
+        float dx = x[i] - cx;
+        float dy = y[i] - cy;
+        out[i] = (dx * dx + dy * dy > r2) ? 1 : 0;
+    }
+
+    // Walk backwards so the bullet swapped in from the end was already checked.
+    for (int i = n - 1; i >= 0; --i) {
+        if (out[i]) removeAt(i);
+    }
+}
+
+Bullet BulletPool::get(int i) const {
+    Bullet b;
+    b.spawn(Vec2(px[i], py[i]), Vec2(vx[i], vy[i]), rad[i], own[i]);
+    return b;
+}
+
+const float* BulletPool::posX() const { return px.data(); }
+const float* BulletPool::posY() const { return py.data(); }
+const float* BulletPool::prevX() const { return ox.data(); }
+const float* BulletPool::prevY() const { return oy.data(); }
+const float* BulletPool::velX() const { return vx.data(); }
+const float* BulletPool::velY() const { return vy.data(); }
+const float* BulletPool::radius() const { return rad.data(); }
+const int* BulletPool::owner() const { return own.data(); }
+
+uint64_t BulletPool::hash(uint64_t h) const {
+    const size_t n = size_t(count);
+    h = Hash::value(count, h);
+    h = Hash::bytes(px.data(), n * sizeof(float), h);
+    h = Hash::bytes(py.data(), n * sizeof(float), h);
+    h = Hash::bytes(vx.data(), n * sizeof(float), h);
+    h = Hash::bytes(vy.data(), n * sizeof(float), h);
+    h = Hash::bytes(rad.data(), n * sizeof(float), h);
+    h = Hash::bytes(own.data(), n * sizeof(int), h);
+    return h;
+}
+
+size_t BulletPool::stateBytes(int bullets) {
+    return size_t(bullets) * (7 * sizeof(float) + sizeof(int));
+}
+
+void BulletPool::writeState(uint8_t* dst) const {
+    const size_t n = size_t(count);
+    const std::vector<float>* floats[] = { &px, &py, &ox, &oy, &vx, &vy, &rad };
+    for (const std::vector<float>* a : floats) {
+        std::memcpy(dst, a->data(), n * sizeof(float));
+        dst += n * sizeof(float);
+    }
+    std::memcpy(dst, own.data(), n * sizeof(int));
+}
+
+bool BulletPool::readState(const uint8_t* src, int bullets) {
+    if (bullets < 0 || bullets > cap) return false;
+    const size_t n = size_t(bullets);
+    std::vector<float>* floats[] = { &px, &py, &ox, &oy, &vx, &vy, &rad };
+    for (std::vector<float>* a : floats) {
+        std::memcpy(a->data(), src, n * sizeof(float));
+        src += n * sizeof(float);
+    }
+    std::memcpy(own.data(), src, n * sizeof(int));
+    count = bullets;
+    return true;
+}
@@ -41,27 +41,30 @@ Vec2 Player::forward() const {
 }
 
 void Player::applyMovement(float dt, bool moveForward, bool moveBackward, bool turnLeft, bool turnRight) {
+    turnStep(headingRad, turnSpeedRad, dt, turnLeft, turnRight);
+    walking = walkStep(pos, walkPhase, forward(), moveSpeed, dt, moveForward, moveBackward);
+}
+
+bool Player::turnStep(float& headingRad, float turnSpeedRad, float dt, bool turnLeft, bool turnRight) {
     float turn = 0.0f;
     if (turnLeft)  turn += 1.0f;
     if (turnRight) turn -= 1.0f;
+    if (turn == 0.0f) return false;
 
-    if (turn != 0.0f) {
-        headingRad += turn * turnSpeedRad * dt;
-        headingRad = Angle::wrap2Pi(headingRad);
-    }
+    headingRad = Angle::wrap2Pi(headingRad + turn * turnSpeedRad * dt);
+    return true;
+}
 
+bool Player::walkStep(Vec2& pos, float& walkPhase, const Vec2& forward, float moveSpeed, float dt,
+                      bool moveForward, bool moveBackward) {
     float move = 0.0f;
     if (moveForward)  move += 1.0f;
     if (moveBackward) move -= 1.0f;
+    if (move == 0.0f) return false;
 
-    if (move != 0.0f) {
-        Vec2 dir = forward();
-        pos += dir * (move * moveSpeed * dt);
-        walkPhase += dt * 8.0f;
-        walking = true;
-    } else {
-        walking = false;
-    }
+    pos += forward * (move * moveSpeed * dt);
+    walkPhase += dt * 8.0f;
+    return true;
 }
 
 void Player::setArmRelative(float relRad) {
@@ -79,6 +82,32 @@ Vec2 Player::armWorldDir() const {
     return Vec2(std::cos(a), -std::sin(a));
 }
 
+PlayerPose Player::pose() const {
+    float a = headingRad + armRelRad;
+    return PlayerPose::fromAngles(std::cos(headingRad), std::sin(headingRad), std::cos(a), std::sin(a));
+}
+
+PlayerPose Player::approxPose() const {
+    float ch, sh, ca, sa;
+    Angle::sincos(headingRad, sh, ch);
+    Angle::sincos(headingRad + armRelRad, sa, ca);
+    return PlayerPose::fromAngles(ch, sh, ca, sa);
+}
+
 void Player::clampArm() {
     armRelRad = Angle::clamp(armRelRad, armMinRelRad, armMaxRelRad);
 }
+
+PlayerPose PlayerPose::fromAngles(float cosHeading, float sinHeading, float cosArm, float sinArm) {
+    PlayerPose p;
+    p.forward = Vec2(cosHeading, -sinHeading);
+    p.left = Vec2(p.forward.y, -p.forward.x);
+    p.right = Vec2(-p.forward.y, p.forward.x);
+    p.armDir = Vec2(cosArm, -sinArm);
+    return p;
+}
+
+Vec2 PlayerPose::weaponTip(const Vec2& pos, float headRadius) const {
+    Vec2 weaponBase = pos + right * headRadius;
+    return weaponBase + armDir * (headRadius * 1.65f);
+}
@@ -0,0 +1,226 @@
+#include "../../include/entity/PlayerStore.h"
+#include "../../include/math/Angle.h"
+#include "../../include/util/Hash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+PlayerStore::PlayerStore()
+    : count(0) {}
+
+int PlayerStore::size() const { return count; }
+
+void PlayerStore::clear() {
+    count = 0;
+    px.clear(); py.clear(); heading.clear(); radius.clear();
+    arm.clear(); armMin.clear(); armMax.clear();
+    speed.clear(); turnSpeed.clear(); life.clear(); phase.clear(); walk.clear();
+    headCos.clear(); headSin.clear(); armCos.clear(); armSin.clear();
+    cool.clear(); held.clear();
+    prevPx.clear(); prevPy.clear(); prevHeading.clear(); prevArm.clear(); prevPhase.clear();
+}
+
+int PlayerStore::add(const Player& p) {
+    int e = count++;
+    px.push_back(p.pos.x);
+    py.push_back(p.pos.y);
+    heading.push_back(p.headingRad);
+    radius.push_back(p.headRadius);
+    arm.push_back(p.armRelRad);
+    armMin.push_back(p.armMinRelRad);
+    armMax.push_back(p.armMaxRelRad);
+    speed.push_back(p.moveSpeed);
+    turnSpeed.push_back(p.turnSpeedRad);
+    life.push_back(p.lives);
+    phase.push_back(p.walkPhase);
+    walk.push_back(p.walking ? 1 : 0);
+    headCos.push_back(0.0f);
+    headSin.push_back(0.0f);
+    armCos.push_back(0.0f);
+    armSin.push_back(0.0f);
+    cool.push_back(0.0f);
+    held.push_back(0);
+    prevPx.push_back(p.pos.x);
+    prevPy.push_back(p.pos.y);
+    prevHeading.push_back(p.headingRad);
+    prevArm.push_back(p.armRelRad);
+    prevPhase.push_back(p.walkPhase);
+    refreshPose(e);
+    return e;
+}
+
+Player PlayerStore::get(int e) const {
+    Player p;
+    p.id = PlayerId(e + 1);
+    p.pos = Vec2(px[e], py[e]);
+    p.headingRad = heading[e];
+    p.headRadius = radius[e];
+    p.armRelRad = arm[e];
+    p.armMinRelRad = armMin[e];
+    p.armMaxRelRad = armMax[e];
+    p.moveSpeed = speed[e];
+    p.turnSpeedRad = turnSpeed[e];
+    p.lives = life[e];
+    p.walkPhase = phase[e];
+    p.walking = walk[e] != 0;
+    return p;
+}
+
+Player PlayerStore::getPrevious(int e) const {
+    Player p = get(e);
+    p.pos = Vec2(prevPx[e], prevPy[e]);
+    p.headingRad = prevHeading[e];
+    p.armRelRad = prevArm[e];
+    p.walkPhase = prevPhase[e];
+    return p;
+}
+
+void PlayerStore::savePrevious() {
+    std::copy(px.begin(), px.begin() + count, prevPx.begin());
+    std::copy(py.begin(), py.begin() + count, prevPy.begin());
+    std::copy(heading.begin(), heading.begin() + count, prevHeading.begin());
+    std::copy(arm.begin(), arm.begin() + count, prevArm.begin());
+    std::copy(phase.begin(), phase.begin() + count, prevPhase.begin());
+}
+
+// Player's movement rules on the component arrays; walking reads the cached
+// heading vector, which equals Player::forward() once refreshed.
+void PlayerStore::applyMovement(int e, float dt, bool moveForward, bool moveBackward, bool turnLeft, bool turnRight) {
+    if (Player::turnStep(heading[e], turnSpeed[e], dt, turnLeft, turnRight)) refreshPose(e);
+
+    Vec2 p(px[e], py[e]);
+    bool walked = Player::walkStep(p, phase[e], Vec2(headCos[e], -headSin[e]), speed[e], dt, moveForward, moveBackward);
+    px[e] = p.x;
+    py[e] = p.y;
+    walk[e] = walked ? 1 : 0;
+}
+
+void PlayerStore::setArmRelative(int e, float relRad) {
+    float a = Angle::clamp(relRad, armMin[e], armMax[e]);
+    if (a == arm[e]) return;
+    arm[e] = a;
+    refreshPose(e);
+}
+
+void PlayerStore::addArmRelative(int e, float deltaRelRad) {
+    float a = Angle::clamp(arm[e] + deltaRelRad, armMin[e], armMax[e]);
+    if (a == arm[e]) return;
+    arm[e] = a;
+    refreshPose(e);
+}
+
+void PlayerStore::setArmFraction(int e, float t) {
+    setArmRelative(e, armMin[e] + (armMax[e] - armMin[e]) * t);
+}
+
+// The only place the simulation evaluates cos/sin: once per heading or arm
+// change instead of on every movement step, bullet spawn and draw.
+void PlayerStore::refreshPose(int e) {
+    float a = heading[e] + arm[e];
+    headCos[e] = std::cos(heading[e]);
+    headSin[e] = std::sin(heading[e]);
+    armCos[e] = std::cos(a);
+    armSin[e] = std::sin(a);
+}
+
+PlayerPose PlayerStore::pose(int e) const {
+    return PlayerPose::fromAngles(headCos[e], headSin[e], armCos[e], armSin[e]);
+}
+
+bool PlayerStore::alive(int e) const { return life[e] > 0; }
+
+int PlayerStore::aliveCount() const {
+    int n = 0;
+    for (int e = 0; e < count; ++e) n += (life[e] > 0) ? 1 : 0;
+    return n;
+}
+
+Vec2 PlayerStore::position(int e) const { return Vec2(px[e], py[e]); }
+
+void PlayerStore::setPosition(int e, const Vec2& p) {
+    px[e] = p.x;
+    py[e] = p.y;
+}
+
+float* PlayerStore::posX() { return px.data(); }
+float* PlayerStore::posY() { return py.data(); }
+const float* PlayerStore::posX() const { return px.data(); }
+const float* PlayerStore::posY() const { return py.data(); }
+const float* PlayerStore::prevX() const { return prevPx.data(); }
+const float* PlayerStore::prevY() const { return prevPy.data(); }
+const float* PlayerStore::headRadius() const { return radius.data(); }
+
+int* PlayerStore::lives() { return life.data(); }
+const int* PlayerStore::lives() const { return life.data(); }
+
+float* PlayerStore::cooldown() { return cool.data(); }
+uint8_t* PlayerStore::fireHeld() { return held.data(); }
+const float* PlayerStore::cooldown() const { return cool.data(); }
+const uint8_t* PlayerStore::fireHeld() const { return held.data(); }
+
+uint64_t PlayerStore::hash(uint64_t h) const {
+    const size_t n = size_t(count);
+    h = Hash::value(count, h);
+    h = Hash::bytes(px.data(), n * sizeof(float), h);
+    h = Hash::bytes(py.data(), n * sizeof(float), h);
+    h = Hash::bytes(heading.data(), n * sizeof(float), h);
+    h = Hash::bytes(radius.data(), n * sizeof(float), h);
+    h = Hash::bytes(arm.data(), n * sizeof(float), h);
+    h = Hash::bytes(life.data(), n * sizeof(int), h);
+    h = Hash::bytes(phase.data(), n * sizeof(float), h);
+    h = Hash::bytes(walk.data(), n, h);
+    h = Hash::bytes(cool.data(), n * sizeof(float), h);
+    h = Hash::bytes(held.data(), n, h);
+    return h;
+}
+
+static const int kFloatArrays = 16;
+
+size_t PlayerStore::stateBytes(int players) {
+    size_t n = size_t(players);
+    return n * (kFloatArrays * sizeof(float) + sizeof(int) + 2 * sizeof(uint8_t));
+}
+
+void PlayerStore::writeState(uint8_t* dst) const {
+    const size_t n = size_t(count);
+    const std::vector<float>* floats[kFloatArrays] = {
+        &px, &py, &heading, &radius, &arm, &armMin, &armMax, &speed, &turnSpeed,
+        &phase, &cool, &prevPx, &prevPy, &prevHeading, &prevArm, &prevPhase
+    };
+    for (const std::vector<float>* a : floats) {
+        std::memcpy(dst, a->data(), n * sizeof(float));
+        dst += n * sizeof(float);
+    }
+    std::memcpy(dst, life.data(), n * sizeof(int));
+    dst += n * sizeof(int);
+    std::memcpy(dst, walk.data(), n);
+    dst += n;
+    std::memcpy(dst, held.data(), n);
+}
+
+void PlayerStore::readState(const uint8_t* src, int players) {
+    const size_t n = size_t(players);
+    count = players;
+    // Same order as writeState().
+    std::vector<float>* floats[kFloatArrays] = {
+        &px, &py, &heading, &radius, &arm, &armMin, &armMax, &speed, &turnSpeed,
+        &phase, &cool, &prevPx, &prevPy, &prevHeading, &prevArm, &prevPhase
+    };
+    for (std::vector<float>* a : floats) {
+        a->resize(n);
+        std::memcpy(a->data(), src, n * sizeof(float));
+        src += n * sizeof(float);
+    }
+    life.resize(n);
+    std::memcpy(life.data(), src, n * sizeof(int));
+    src += n * sizeof(int);
+    walk.resize(n);
+    std::memcpy(walk.data(), src, n);
+    src += n;
+    held.resize(n);
+    std::memcpy(held.data(), src, n);
+
+    headCos.resize(n); headSin.resize(n); armCos.resize(n); armSin.resize(n);
+    for (int e = 0; e < players; ++e) refreshPose(e);
+}
@@ -0,0 +1,76 @@
+#include "../../include/game/Camera.h"
+
+#include <algorithm>
+
+Camera::Camera()
+    : viewportW(500), viewportH(500), zoomLevel(1.0f), following(false), rect(), ppu(1.0f) {}
+
+void Camera::setViewport(int width, int height) {
+    viewportW = std::max(width, 1);
+    viewportH = std::max(height, 1);
+}
+
+void Camera::setZoom(float zoom) {
+    zoomLevel = std::max(zoom, 1.0f);
+}
+
+void Camera::zoomBy(float factor) {
+    setZoom(zoomLevel * factor);
+}
+
+float Camera::zoom() const {
+    return zoomLevel;
+}
+
+void Camera::setFollow(bool follow) {
+    following = follow;
+}
+
+bool Camera::isFollowing() const {
+    return following;
+}
+
+// One view axis: centered on `want`, but kept inside [lo, hi] when it fits.
+static float clampAxis(float want, float half, float lo, float hi) {
+    if (2.0f * half >= hi - lo) return 0.5f * (lo + hi);
+    return std::min(std::max(want, lo + half), hi - half);
+}
+
+void Camera::update(const Arena& arena, const Vec2& target) {
+    float pixels = float(std::min(viewportW, viewportH));
+    float fit = pixels / (2.0f * std::max(arena.radius, 1e-3f));
+
+    // Tiny arenas may already be closer than the limit at zoom 1.
+    float maxZoom = std::max(1.0f, kMaxPixelsPerUnit / fit);
+    zoomLevel = std::min(zoomLevel, maxZoom);
+    ppu = fit * zoomLevel;
+
+    // Stretched over the window; the scale above is the shorter axis's.
+    if (showsWholeArena()) {
+        rect = Rect::around(arena.center, arena.radius, arena.radius);
+        return;
+    }
+
+    float halfW = 0.5f * float(viewportW) / ppu;
+    float halfH = 0.5f * float(viewportH) / ppu;
+    Vec2 want = following ? target : arena.center;
+    Vec2 c(clampAxis(want.x, halfW, arena.center.x - arena.radius, arena.center.x + arena.radius),
+           clampAxis(want.y, halfH, arena.center.y - arena.radius, arena.center.y + arena.radius));
+    rect = Rect::around(c, halfW, halfH);
+}
+
+const Rect& Camera::view() const {
+    return rect;
+}
+
+Rect Camera::cullRect() const {
+    return showsWholeArena() ? Rect::unbounded() : rect;
+}
+
+bool Camera::showsWholeArena() const {
+    return zoomLevel == 1.0f && !following;
+}
+
+float Camera::pixelsPerUnit() const {
+    return ppu;
+}
@@ -0,0 +1,37 @@
+#include "../../include/game/FixedStepClock.h"
+#include <cmath>
+
+FixedStepClock::FixedStepClock(float stepSeconds, int maxStepsPerFrame)
+    : stepSec(stepSeconds > 0.0f ? stepSeconds : 1.0f / 60.0f),
+      maxSteps(maxStepsPerFrame > 0 ? maxStepsPerFrame : 1),
+      accumulator(0.0f),
+      dropped(0.0) {}
+
+int FixedStepClock::advance(float frameSeconds) {
+    if (frameSeconds > 0.0f) accumulator += frameSeconds;
+
+    int steps = 0;
+    while (accumulator >= stepSec && steps < maxSteps) {
+        accumulator -= stepSec;
+        ++steps;
+    }
+
+    if (accumulator >= stepSec) {
+        float keep = std::fmod(accumulator, stepSec);
+        dropped += double(accumulator - keep);
+        accumulator = keep;
+    }
+    return steps;
+}
+
+float FixedStepClock::alpha() const {
+    return accumulator / stepSec;
+}
+
+float FixedStepClock::step() const {
+    return stepSec;
+}
+
+double FixedStepClock::droppedSeconds() const {
+    return dropped;
+}
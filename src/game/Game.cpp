@@ -1,256 +1,580 @@
 #include "../../include/game/Game.h"
-#include "../../include/game/Renderer.h"
 #include "../../include/math/Collision.h"
 #include "../../include/math/Angle.h"
-#include "../../include/io/SvgLoader.h"
+#include "../../include/io/SceneCache.h"
+#include "../../include/util/Hash.h"
+#include "../../include/util/Profiler.h"
 
-#include <GL/glut.h>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
+#include <type_traits>
 
 Game::Game()
     : state(GameState::RUNNING),
+      inputDrivesPlayers(true),
       winnerId(0),
-      prevMouseLeft(false),
-      prevKey5(false),
-      shootCooldownP1(0.0f),
-      shootCooldownP2(0.0f) {}
+      resetCount(0),
+      viewportWidth(500),
+      viewportHeight(500),
+      resolveStats(),
+      droppedBullets(0),
+      staticLayerVersion(0) {}
+
+// Bullet pool room per player. A player fires at most every 0.15 s, so this
+// holds every shot that stays in flight for up to 9.6 s.
+static const int kBulletsPerPlayer = 64;
+
+static unsigned nextStaticLayerVersion() {
+    static std::atomic<unsigned> counter(0);
+    return ++counter;
+}
 
 bool Game::loadFromSvg(const std::string& path) {
     SvgSceneData data;
-    if (!SvgLoader::load(path, data)) return false;
+    if (SceneCache::load(path, data, obstacleGrid) == SceneCache::Result::FAILED) return false;
+
+    applyScene(data);
+    return true;
+}
 
+void Game::loadScene(const SvgSceneData& data) {
+    obstacleGrid.build(data.obstacles);
+    applyScene(data);
+}
+
+// Expects obstacleGrid to be built for data.obstacles already.
+void Game::applyScene(const SvgSceneData& data) {
     arena = data.arena;
     obstacles = data.obstacles;
+    // Only a new scene changes the static geometry; reset() keeps it.
+    staticLayerVersion = nextStaticLayerVersion();
+    droppedBullets = 0;
+
+    players.clear();
 
-    player1.setDefaults(PlayerId::P1);
-    player2.setDefaults(PlayerId::P2);
+    Player p1;
+    p1.setDefaults(PlayerId::P1);
+    p1.resetAt(data.player1Pos, data.player1HeadRadius);
+    players.add(p1);
 
-    player1.resetAt(data.player1Pos, data.player1HeadRadius);
-    player2.resetAt(data.player2Pos, data.player2HeadRadius);
+    Player p2;
+    p2.setDefaults(PlayerId::P2);
+    p2.resetAt(data.player2Pos, data.player2HeadRadius);
+    players.add(p2);
+
+    commands.assign(2, PlayerCommand());
+    touched.assign(2, 0);
 
     reset();
-    return true;
+}
+
+int Game::addPlayer(const Vec2& pos, float headRadius) {
+    Player p;
+    p.setDefaults(PlayerId(players.size() + 1));
+    p.resetAt(pos, headRadius);
+
+    commands.push_back(PlayerCommand());
+    touched.push_back(0);
+    int e = players.add(p);
+    bullets.reserve(players.size() * kBulletsPerPlayer);
+    return e;
+}
+
+int Game::playerCount() const {
+    return players.size();
+}
+
+const PlayerStore& Game::getPlayers() const {
+    return players;
+}
+
+void Game::setPlayerCommand(int e, const PlayerCommand& cmd) {
+    if (e >= 0 && e < (int)commands.size()) commands[e] = cmd;
 }
 
 void Game::reset() {
     state = GameState::RUNNING;
     winnerId = 0;
+    ++resetCount;
 
     bullets.clear();
 
-    player1.lives = 3;
-    player2.lives = 3;
-
-    prevMouseLeft = false;
-    prevKey5 = false;
-
-    shootCooldownP1 = 0.0f;
-    shootCooldownP2 = 0.0f;
+    int* lives = players.lives();
+    float* cooldown = players.cooldown();
+    uint8_t* fireHeld = players.fireHeld();
+    for (int e = 0; e < players.size(); ++e) {
+        lives[e] = 3;
+        cooldown[e] = 0.0f;
+        fireHeld[e] = 0;
+    }
+    std::fill(commands.begin(), commands.end(), PlayerCommand());
 
     input.clear();
+
+    players.savePrevious();
 }
 
 bool Game::isRunning() const {
     return state == GameState::RUNNING;
 }
 
+int Game::getWinnerId() const {
+    return winnerId;
+}
+
 const Arena& Game::getArena() const {
     return arena;
 }
 
-static float mapMouseXToArmRel(int mouseX, int winW, float minRel, float maxRel) {
-    if (winW <= 1) return 0.0f;
-    float t = float(mouseX) / float(winW - 1);
-    return minRel + (maxRel - minRel) * t;
+void Game::setViewportSize(int w, int h) {
+    viewportWidth = w;
+    viewportHeight = h;
 }
 
-static void keepInsideArena(Player& p, const Arena& a) {
-    float pr = p.headRadius;
-    Vec2 d = p.pos - a.center;
-    float dist = std::sqrt(d.lengthSq());
-    float maxDist = a.radius - pr;
+void Game::setInput(const InputState& in) {
+    input = in;
+}
 
-    if (dist > maxDist) {
-        Vec2 n = (dist > 1e-6f) ? (d / dist) : Vec2(1.0f, 0.0f);
-        p.pos = a.center + n * maxDist;
+const InputState& Game::getInput() const {
+    return input;
+}
+
+int Game::getViewportWidth() const {
+    return viewportWidth;
+}
+
+unsigned Game::getResetCount() const {
+    return resetCount;
+}
+
+uint64_t Game::stateHash() const {
+    uint64_t h = Hash::kSeed;
+    h = Hash::value(int(state), h);
+    h = Hash::value(winnerId, h);
+    h = players.hash(h);
+    h = bullets.hash(h);
+    return h;
+}
+
+/* ===================== Snapshots ===================== */
+
+namespace {
+
+const uint32_t kSnapshotVersion = 1;
+
+// Fixed-size front of the snapshot block; the component arrays follow.
+struct SnapshotHeader {
+    uint32_t version;
+    int32_t state;
+    int32_t winnerId;
+    uint32_t resetCount;
+    int32_t playerCount;
+    int32_t bulletCount;
+    InputState input;
+};
+
+static_assert(std::is_trivially_copyable<SnapshotHeader>::value, "snapshot header must be POD");
+static_assert(std::is_trivially_copyable<PlayerCommand>::value, "commands are copied raw");
+
+} // namespace
+
+void Game::saveSnapshot(GameSnapshot& out) const {
+    const int n = players.size();
+    const size_t commandBytes = size_t(n) * sizeof(PlayerCommand);
+    out.bytes.resize(sizeof(SnapshotHeader) + commandBytes +
+                     PlayerStore::stateBytes(n) + BulletPool::stateBytes(bullets.size()));
+
+    SnapshotHeader h;
+    h.version = kSnapshotVersion;
+    h.state = int32_t(state);
+    h.winnerId = winnerId;
+    h.resetCount = resetCount;
+    h.playerCount = n;
+    h.bulletCount = bullets.size();
+    h.input = input;
+
+    uint8_t* p = out.bytes.data();
+    std::memcpy(p, &h, sizeof(h));
+    p += sizeof(h);
+    if (commandBytes) std::memcpy(p, commands.data(), commandBytes);
+    p += commandBytes;
+    players.writeState(p);
+    p += PlayerStore::stateBytes(n);
+    bullets.writeState(p);
+}
+
+bool Game::restoreSnapshot(const GameSnapshot& in) {
+    if (in.bytes.size() < sizeof(SnapshotHeader)) return false;
+
+    SnapshotHeader h;
+    std::memcpy(&h, in.bytes.data(), sizeof(h));
+    if (h.version != kSnapshotVersion || h.playerCount < 0 || h.bulletCount < 0) return false;
+    if (h.bulletCount > bullets.capacity()) return false;
+
+    const size_t commandBytes = size_t(h.playerCount) * sizeof(PlayerCommand);
+    if (in.bytes.size() != sizeof(SnapshotHeader) + commandBytes + PlayerStore::stateBytes(h.playerCount) +
+                           BulletPool::stateBytes(h.bulletCount)) {
+        return false;
     }
+
+    state = GameState(h.state);
+    winnerId = h.winnerId;
+    resetCount = h.resetCount;
+    input = h.input;
+
+    const uint8_t* p = in.bytes.data() + sizeof(h);
+    commands.resize(size_t(h.playerCount));
+    if (commandBytes) std::memcpy(commands.data(), p, commandBytes);
+    p += commandBytes;
+    touched.assign(size_t(h.playerCount), 0);
+    players.readState(p, h.playerCount);
+    p += PlayerStore::stateBytes(h.playerCount);
+    bullets.readState(p, h.bulletCount);
+    return true;
+}
+
+bool Game::addBullet(const Vec2& pos, const Vec2& vel, float radius, int owner) {
+    return bullets.spawn(pos, vel, radius, owner >= 0 ? owner + 1 : 0);
+}
+
+int Game::bulletCount() const {
+    return bullets.size();
+}
+
+const BulletPool& Game::getBullets() const {
+    return bullets;
 }
 
-static void pushOutOfObstacle(Player& p, const Obstacle& ob) {
-    float pr = p.headRadius;
-    Vec2 d = p.pos - ob.pos;
+const std::vector<Obstacle>& Game::getObstacles() const {
+    return obstacles;
+}
+
+const ObstacleGrid& Game::getObstacleGrid() const {
+    return obstacleGrid;
+}
+
+unsigned Game::getStaticLayerVersion() const {
+    return staticLayerVersion;
+}
+
+void Game::setInputDrivesPlayers(bool on) {
+    inputDrivesPlayers = on;
+}
+
+const ResolveStats& Game::lastResolveStats() const {
+    return resolveStats;
+}
+
+long long Game::droppedBulletCount() const {
+    return droppedBullets;
+}
+
+// Upper bounds on the resolver loops; both stop early once nothing moves.
+static const int kMaxResolvePasses = 3;
+static const int kMaxSeparationRounds = 3;
+
+// Below this many players, rebuilding the player grid costs more than testing
+// every player directly.
+static const int kPlayerGridMinPlayers = 16;
+
+// Calls fn(entity) for the players that may overlap the box: from the grid
+// when it was built this step, otherwise simply all of them.
+template <typename Fn>
+static void forPlayersNear(const EntityGrid& grid, bool useGrid, int n,
+                           float minX, float minY, float maxX, float maxY, Fn&& fn) {
+    if (useGrid) {
+        grid.queryBox(minX, minY, maxX, maxY, [&](int e) { fn(e); return false; });
+    } else {
+        for (int e = 0; e < n; ++e) fn(e);
+    }
+}
+
+static bool keepInsideArena(Vec2& pos, float pr, const Arena& a) {
+    Vec2 d = pos - a.center;
     float dist = std::sqrt(d.lengthSq());
-    float minDist = pr + ob.radius;
+    float maxDist = a.radius - pr;
 
-    if (dist < minDist) {
+    if (dist > maxDist) {
         Vec2 n = (dist > 1e-6f) ? (d / dist) : Vec2(1.0f, 0.0f);
-        p.pos += n * (minDist - dist);
+        pos = a.center + n * maxDist;
+        return true;
     }
+    return false;
 }
 
-static void separatePlayers(Player& a, Player& b) {
-    if (a.lives <= 0 || b.lives <= 0) return;
+static bool pushOutOfObstacle(Vec2& pos, float pr, const Vec2& obPos, float obRadius) {
+    Vec2 d = pos - obPos;
+    float minDist = pr + obRadius;
 
-    float ra = a.headRadius;
-    float rb = b.headRadius;
+    // Cheap reject before the sqrt; most neighbors are not touching.
+    float distSq = d.lengthSq();
+    if (distSq >= minDist * minDist) return false;
 
-    Vec2 d = a.pos - b.pos;
-    float dist = std::sqrt(d.lengthSq());
+    float dist = std::sqrt(distSq);
+    Vec2 n = (dist > 1e-6f) ? (d / dist) : Vec2(1.0f, 0.0f);
+    pos += n * (minDist - dist);
+    return true;
+}
+
+static bool separatePair(Vec2& a, float ra, Vec2& b, float rb) {
+    Vec2 d = a - b;
     float minDist = ra + rb;
 
-    if (dist < minDist) {
-        Vec2 n = (dist > 1e-6f) ? (d / dist) : Vec2(1.0f, 0.0f);
-        float push = (minDist - dist) * 0.5f;
-        a.pos += n * push;
-        b.pos -= n * push;
+    float distSq = d.lengthSq();
+    if (distSq >= minDist * minDist) return false;
+
+    float dist = std::sqrt(distSq);
+    Vec2 n = (dist > 1e-6f) ? (d / dist) : Vec2(1.0f, 0.0f);
+    float push = (minDist - dist) * 0.5f;
+    a += n * push;
+    b -= n * push;
+    return true;
+}
+
+bool Game::resolveWorldForPlayer(int e) {
+    Vec2 pos = players.position(e);
+    const float pr = players.headRadius()[e];
+    bool moved = keepInsideArena(pos, pr, arena);
+
+    for (int it = 0; it < kMaxResolvePasses; ++it) {
+        resolveStats.iterations++;
+
+        // Only obstacles whose cells overlap the player's box can touch it.
+        // A push may carry the player past that box; the next pass re-queries.
+        // Each obstacle is tested once, however many of those cells hold it.
+        bool corrected = false;
+        obstacleGrid.forEachInBox(pos.x - pr, pos.y - pr, pos.x + pr, pos.y + pr,
+                                  [&](const ObstacleGrid::Entry& en) {
+                                      resolveStats.obstaclesTested++;
+                                      if (pushOutOfObstacle(pos, pr, Vec2(en.x, en.y), en.r)) corrected = true;
+                                  });
+        if (keepInsideArena(pos, pr, arena)) corrected = true;
+
+        if (!corrected) break;
+        moved = true;
     }
+
+    players.setPosition(e, pos);
+    return moved;
 }
 
-static void resolveWorldForPlayer(Player& p, const Arena& a, const std::vector<Obstacle>& obs) {
-    keepInsideArena(p, a);
-    for (int it = 0; it < 3; ++it) {
-        for (const auto& ob : obs) pushOutOfObstacle(p, ob);
-        keepInsideArena(p, a);
+bool Game::separatePlayers() {
+    const int n = players.size();
+    float* x = players.posX();
+    float* y = players.posY();
+    const float* r = players.headRadius();
+    const int* lives = players.lives();
+
+    const bool useGrid = n >= kPlayerGridMinPlayers;
+    if (useGrid) playerGrid.build(x, y, r, lives, n, arena);
+    std::fill(touched.begin(), touched.end(), 0);
+
+    bool any = false;
+    for (int i = 0; i < n; ++i) {
+        if (lives[i] <= 0) continue;
+
+        // Each pair is handled once, from its lower entity id.
+        forPlayersNear(playerGrid, useGrid, n, x[i] - r[i], y[i] - r[i], x[i] + r[i], y[i] + r[i], [&](int j) {
+            if (j <= i || lives[j] <= 0) return;
+            resolveStats.pairsTested++;
+
+            Vec2 a(x[i], y[i]);
+            Vec2 b(x[j], y[j]);
+            if (separatePair(a, r[i], b, r[j])) {
+                x[i] = a.x; y[i] = a.y;
+                x[j] = b.x; y[j] = b.y;
+                touched[i] = touched[j] = 1;
+                any = true;
+            }
+        });
     }
+    return any;
 }
 
-void Game::spawnBulletFromPlayer(const Player& p) {
+void Game::spawnBulletFromPlayer(const Player& p, const PlayerPose& pose) {
     if (p.lives <= 0) return;
 
     float R = p.headRadius;
-
-    Vec2 f = p.forward();
-    // FIX: correct perpendiculars for Y-down
-    Vec2 left(f.y, -f.x);
-    Vec2 right(-f.y, f.x);
-
-    Vec2 weaponBase = p.pos + right * R;
-    Vec2 weaponDir = p.armWorldDir();
-
-    float weaponLen = R * 1.65f;
+    Vec2 weaponDir = pose.armDir;
 
     float br = R * 0.15f;
-    Vec2 weaponTip = weaponBase + weaponDir * weaponLen;
+    Vec2 weaponTip = pose.weaponTip(p.pos, R);
     Vec2 spawnPos = weaponTip - weaponDir * (br * 0.6f);
 
     float bulletSpeed = 2.0f * p.moveSpeed;
     Vec2 vel = weaponDir * bulletSpeed;
 
-    Bullet b;
-    b.spawn(spawnPos, vel, br, (int)p.id);
-    bullets.push_back(b);
+    if (!bullets.spawn(spawnPos, vel, br, (int)p.id)) ++droppedBullets;
 }
 
 void Game::update(float dt) {
+    // Snapshot first, even when paused, so interpolation settles on the final state.
+    players.savePrevious();
+    bullets.savePrevious();
+
     if (state != GameState::RUNNING) return;
 
-    shootCooldownP1 = std::max(0.0f, shootCooldownP1 - dt);
-    shootCooldownP2 = std::max(0.0f, shootCooldownP2 - dt);
+    float* cooldown = players.cooldown();
+    for (int e = 0; e < players.size(); ++e) cooldown[e] = std::max(0.0f, cooldown[e] - dt);
 
-    updatePlayers(dt);
-    updateBullets(dt);
-    handleCollisions();
-    checkGameOver();
+    {
+        Profiler::Scope scope(ProfileZone::UPDATE_PLAYERS);
+        updatePlayers(dt);
+    }
+    {
+        Profiler::Scope scope(ProfileZone::UPDATE_BULLETS);
+        updateBullets(dt);
+    }
+    {
+        Profiler::Scope scope(ProfileZone::HANDLE_COLLISIONS);
+        handleCollisions();
+    }
+    {
+        Profiler::Scope scope(ProfileZone::CHECK_GAME_OVER);
+        checkGameOver();
+    }
 }
 
-void Game::updatePlayers(float dt) {
-    bool p1Forward   = input.keys['w'] || input.keys['W'] || input.specialKeys[GLUT_KEY_UP];
-    bool p1Backward  = input.keys['s'] || input.keys['S'] || input.specialKeys[GLUT_KEY_DOWN];
-    bool p1TurnLeft  = input.keys['a'] || input.keys['A'] || input.specialKeys[GLUT_KEY_LEFT];
-    bool p1TurnRight = input.keys['d'] || input.keys['D'] || input.specialKeys[GLUT_KEY_RIGHT];
-    player1.applyMovement(dt, p1Forward, p1Backward, p1TurnLeft, p1TurnRight);
-
-    bool p2Forward   = input.keys['o'] || input.keys['O'];
-    bool p2Backward  = input.keys['l'] || input.keys['L'];
-    bool p2TurnLeft  = input.keys['k'] || input.keys['K'];
-    bool p2TurnRight = input.keys[';'] || input.keys['p'] || input.keys['P'] || input.keys[231];
-    player2.applyMovement(dt, p2Forward, p2Backward, p2TurnLeft, p2TurnRight);
-
-    int winW = glutGet(GLUT_WINDOW_WIDTH);
-    float p1Rel = mapMouseXToArmRel(input.mouseX, winW, player1.armMinRelRad, player1.armMaxRelRad);
-    player1.setArmRelative(p1Rel);
-
-    float weaponSpeed = Angle::degToRad(120.0f);
-    if (input.keys['4']) player2.addArmRelative(+weaponSpeed * dt);
-    if (input.keys['6']) player2.addArmRelative(-weaponSpeed * dt);
-
-    resolveWorldForPlayer(player1, arena, obstacles);
-    resolveWorldForPlayer(player2, arena, obstacles);
-
-    for (int it = 0; it < 3; ++it) {
-        separatePlayers(player1, player2);
-        resolveWorldForPlayer(player1, arena, obstacles);
-        resolveWorldForPlayer(player2, arena, obstacles);
-    }
+void Game::commandsFromInput() {
+    if (!inputDrivesPlayers || commands.size() < 2) return;
 
-    bool mouseLeft = input.mouseLeftPressed;
-    bool key5 = input.keys['5'];
+    commands[0] = player1Command(input, viewportWidth);
+    commands[1] = player2Command(input);
+}
 
-    if (mouseLeft && !prevMouseLeft && shootCooldownP1 <= 0.0f) {
-        spawnBulletFromPlayer(player1);
-        shootCooldownP1 = 0.15f;
-    }
+void Game::updatePlayers(float dt) {
+    commandsFromInput();
 
-    if (key5 && !prevKey5 && shootCooldownP2 <= 0.0f) {
-        spawnBulletFromPlayer(player2);
-        shootCooldownP2 = 0.15f;
-    }
+    const int n = players.size();
+    const int* lives = players.lives();
 
-    prevMouseLeft = mouseLeft;
-    prevKey5 = key5;
-}
+    for (int e = 0; e < n; ++e) {
+        if (lives[e] <= 0) continue;
+        const PlayerCommand& c = commands[e];
+        players.applyMovement(e, dt, c.forward, c.backward, c.turnLeft, c.turnRight);
 
-void Game::updateBullets(float dt) {
-    for (auto& b : bullets) {
-        if (!b.alive) continue;
-        b.update(dt);
-        if (b.isOutsideArena(arena)) b.alive = false;
+        if (c.aim) players.setArmFraction(e, c.aimFraction);
+        else if (c.armRate != 0.0f) players.addArmRelative(e, c.armRate * dt);
     }
-}
 
-void Game::handleCollisions() {
-    for (auto& b : bullets) {
-        if (!b.alive) continue;
+    resolveStats = ResolveStats();
+    for (int e = 0; e < n; ++e) {
+        if (lives[e] > 0) resolveWorldForPlayer(e);
+    }
 
-        for (const auto& ob : obstacles) {
-            if (b.hitsObstacle(ob)) {
-                b.alive = false;
-                break;
-            }
+    // World pushes can shove players back into each other; alternate until a
+    // round leaves everyone apart.
+    for (int it = 0; it < kMaxSeparationRounds; ++it) {
+        if (!separatePlayers()) break;
+        for (int e = 0; e < n; ++e) {
+            if (touched[e]) resolveWorldForPlayer(e);
         }
+    }
 
-        if (!b.alive) continue;
-
-        Player* targets[2] = { &player1, &player2 };
-        for (Player* pl : targets) {
-            if (pl->lives <= 0) continue;
-            if ((int)pl->id == b.ownerId) continue;
-
-            if (Collision::circleCircle(b.pos, b.radius, pl->pos, pl->headRadius)) {
-                pl->lives--;
-                b.alive = false;
-            }
+    float* cooldown = players.cooldown();
+    uint8_t* fireHeld = players.fireHeld();
+    for (int e = 0; e < n; ++e) {
+        bool fire = commands[e].fire;
+        if (fire && !fireHeld[e] && cooldown[e] <= 0.0f && lives[e] > 0) {
+            spawnBulletFromPlayer(players.get(e), players.pose(e));
+            cooldown[e] = 0.15f;
         }
+        fireHeld[e] = fire ? 1 : 0;
     }
 }
 
-void Game::checkGameOver() {
-    if (player1.lives <= 0) { state = GameState::GAME_OVER; winnerId = 2; }
-    if (player2.lives <= 0) { state = GameState::GAME_OVER; winnerId = 1; }
+void Game::updateBullets(float dt) {
+    bullets.integrate(dt);
 }
 
-void Game::render() const {
-    Renderer::drawArena(arena);
-    for (const auto& ob : obstacles) Renderer::drawObstacle(ob);
+void Game::handleCollisions() {
+    const float* bx = bullets.posX();
+    const float* by = bullets.posY();
+    const float* bpx = bullets.prevX();
+    const float* bpy = bullets.prevY();
+    const float* br = bullets.radius();
+    const int* owner = bullets.owner();
+
+    const int n = players.size();
+    const float* px = players.posX();
+    const float* py = players.posY();
+    const float* ppx = players.prevX();
+    const float* ppy = players.prevY();
+    const float* pr = players.headRadius();
+    int* lives = players.lives();
+
+    // Players moved this step too, so bullets are swept against their motion
+    // (previous -> current position). The grid holds current positions, so
+    // queries are widened by the longest player move.
+    const bool useGrid = n >= kPlayerGridMinPlayers;
+    if (useGrid) playerGrid.build(px, py, pr, lives, n, arena);
+    float maxStepSq = 0.0f;
+    for (int e = 0; useGrid && e < n; ++e) {
+        float dx = px[e] - ppx[e];
+        float dy = py[e] - ppy[e];
+        if (lives[e] > 0) maxStepSq = std::max(maxStepSq, dx * dx + dy * dy);
+    }
+    const float maxStep = std::sqrt(maxStepSq);
+
+    int i = 0;
+    while (i < bullets.size()) {
+        Vec2 pos(bx[i], by[i]);
+        Vec2 prev(bpx[i], bpy[i]);
+        float r = br[i];
+
+        // The earliest contact along the path wins: an obstacle shields a
+        // player only if the bullet reaches it first.
+        float firstT = 2.0f;
+        bool hit = false;
+        if (obstacleGrid.findHit(prev, pos, r, &firstT) >= 0) hit = true;
+
+        int victim = -1;
+        float pad = r + maxStep;
+        forPlayersNear(playerGrid, useGrid, n,
+                       std::min(prev.x, pos.x) - pad, std::min(prev.y, pos.y) - pad,
+                       std::max(prev.x, pos.x) + pad, std::max(prev.y, pos.y) + pad,
+                       [&](int e) {
+                           if (lives[e] <= 0) return;
+                           if (e + 1 == owner[i]) return;
+
+                           float t;
+                           if (!Collision::sweepCircles(prev, pos, r, Vec2(ppx[e], ppy[e]),
+                                                        Vec2(px[e], py[e]), pr[e], t)) {
+                               return;
+                           }
+                           // Ties go to the lower entity id, independent of cell order.
+                           if (t < firstT || (victim >= 0 && t == firstT && e < victim)) {
+                               firstT = t;
+                               victim = e;
+                               hit = true;
+                           }
+                       });
+        if (victim >= 0) lives[victim]--;
+
+        // Swap-remove pulls the last bullet into slot i, so only advance on a miss.
+        if (hit) bullets.removeAt(i);
+        else ++i;
+    }
+
+    bullets.removeOutside(arena);
+}
 
-    if (player1.lives > 0) Renderer::drawPlayer(player1);
-    if (player2.lives > 0) Renderer::drawPlayer(player2);
+void Game::checkGameOver() {
+    if (players.size() < 2) return;
 
-    for (const auto& b : bullets) if (b.alive) Renderer::drawBullet(b);
+    const int* lives = players.lives();
+    int alive = 0;
+    int last = -1;
+    for (int e = 0; e < players.size(); ++e) {
+        if (lives[e] > 0) { ++alive; last = e; }
+    }
 
-    Renderer::drawHud(arena, player1.lives, player2.lives);
-    if (state == GameState::GAME_OVER) Renderer::drawGameOver(arena, winnerId);
+    if (alive <= 1) {
+        state = GameState::GAME_OVER;
+        winnerId = (alive == 1) ? last + 1 : 0;
+    }
 }
 
 void Game::onKeyDown(unsigned char key) {
@@ -0,0 +1,65 @@
+#include "../../include/game/Game.h"
+#include "../../include/game/Renderer.h"
+#include "../../include/math/Angle.h"
+#include "../../include/util/Profiler.h"
+
+// Drawing lives in its own translation unit so the simulation core (Game.cpp)
+// does not depend on the Renderer. Nothing here touches GL; the backend does.
+
+static float lerp(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+static Vec2 lerp(const Vec2& a, const Vec2& b, float t) {
+    return Vec2(lerp(a.x, b.x, t), lerp(a.y, b.y, t));
+}
+
+// Blends the kinematic fields only; everything else comes from the current step.
+static Player interpolatePlayer(const Player& prev, const Player& cur, float t) {
+    Player p = cur;
+    p.pos = lerp(prev.pos, cur.pos, t);
+    p.headingRad = prev.headingRad + Angle::wrapPi(cur.headingRad - prev.headingRad) * t;
+    p.armRelRad = lerp(prev.armRelRad, cur.armRelRad, t);
+    p.walkPhase = lerp(prev.walkPhase, cur.walkPhase, t);
+    return p;
+}
+
+void Game::render(RenderBackend& backend, float alpha) const {
+    Renderer::BackendScope use(backend);
+    float t = Angle::clamp(alpha, 0.0f, 1.0f);
+
+    {
+        Profiler::Scope scope(ProfileZone::DRAW_STATIC);
+        Renderer::drawStaticLayer(arena, obstacles, obstacleGrid, staticLayerVersion);
+    }
+
+    {
+        Profiler::Scope scope(ProfileZone::DRAW_PLAYERS);
+        for (int e = 0; e < players.size(); ++e) {
+            if (!players.alive(e)) continue;
+            Player prev = players.getPrevious(e);
+            Player cur = players.get(e);
+            Player p = interpolatePlayer(prev, cur, t);
+            // Not turning or aiming: the step's cached vectors are exact.
+            bool sameAngles = prev.headingRad == cur.headingRad && prev.armRelRad == cur.armRelRad;
+            Renderer::drawPlayer(p, sameAngles ? players.pose(e) : p.approxPose());
+        }
+    }
+
+    {
+        Profiler::Scope scope(ProfileZone::DRAW_BULLETS);
+        const float* px = bullets.prevX();
+        const float* py = bullets.prevY();
+        for (int i = 0; i < bullets.size(); ++i) {
+            Bullet b = bullets.get(i);
+            b.pos = lerp(Vec2(px[i], py[i]), b.pos, t);
+            Renderer::drawBullet(b);
+        }
+    }
+
+    Profiler::Scope scope(ProfileZone::DRAW_HUD);
+    const int* lives = players.lives();
+    Renderer::drawHud(arena, players.size() > 0 ? lives[0] : 0, players.size() > 1 ? lives[1] : 0);
+    if (state == GameState::GAME_OVER) Renderer::drawGameOver(arena, winnerId);
+    Renderer::drawProfileOverlay(arena);
+}
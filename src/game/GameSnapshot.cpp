@@ -0,0 +1,7 @@
+#include "../../include/game/GameSnapshot.h"
+
+GameSnapshot::GameSnapshot() {}
+
+bool GameSnapshot::empty() const { return bytes.empty(); }
+size_t GameSnapshot::size() const { return bytes.size(); }
+const uint8_t* GameSnapshot::data() const { return bytes.data(); }
@@ -0,0 +1,316 @@
+#include "../../include/game/GlRenderBackend.h"
+#include "../../include/game/BitmapFont.h"
+#include <GL/glut.h>
+#include <algorithm>
+#include <cmath>
+
+/* ===================== Tessellation ===================== */
+
+// Every circle/ellipse reuses one unit-circle table; coarser levels step
+// through it with a stride, so all segment counts must divide kMaxSegments.
+struct UnitCircleTable {
+    float c[RenderBackend::kMaxSegments + 1];
+    float s[RenderBackend::kMaxSegments + 1];
+
+    UnitCircleTable() {
+        for (int i = 0; i <= RenderBackend::kMaxSegments; ++i) {
+            float a = 2.0f * 3.1415926535f * float(i) / float(RenderBackend::kMaxSegments);
+            c[i] = std::cos(a);
+            s[i] = std::sin(a);
+        }
+    }
+};
+
+static const UnitCircleTable& unitCircle() {
+    static const UnitCircleTable table;
+    return table;
+}
+
+// Point i (of the kMaxSegments table) on an ellipse rotated by (cr, sr), Y-down.
+static inline Vec2 ellipsePoint(const UnitCircleTable& t, int i, const Vec2& c,
+                                float rx, float ry, float cr, float sr) {
+    float ex = t.c[i] * rx;
+    float ey = -t.s[i] * ry;
+    return Vec2(c.x + ex * cr - ey * sr, c.y + ex * sr + ey * cr);
+}
+
+static void* glutFont(TextFont font) {
+    return (font == TextFont::LARGE) ? GLUT_BITMAP_HELVETICA_18 : GLUT_BITMAP_8_BY_13;
+}
+
+// One built-in glyph at the current raster position, baseline at its bottom.
+// Rows go bottom-up, most significant bit first, padded to the default
+// 4-byte unpack alignment.
+static void builtinGlyph(char c, int scale) {
+    const uint8_t* glyph = BitmapFont::glyph(c);
+    const int w = BitmapFont::kColumns * scale;
+    const int h = BitmapFont::kRows * scale;
+    GLubyte bits[BitmapFont::kRows * 4 * 4] = {};   // scale <= 4
+    for (int r = 0; r < h; ++r) {
+        int glyphRow = (h - 1 - r) / scale;
+        for (int x = 0; x < w; ++x) {
+            if (glyph[x / scale] & (1u << glyphRow)) bits[r * 4 + x / 8] |= GLubyte(0x80u >> (x % 8));
+        }
+    }
+    glBitmap(w, h, 0.0f, 0.0f, float(BitmapFont::kAdvance * scale), 0.0f, bits);
+}
+
+/* ===================== State ===================== */
+
+GlRenderBackend::GlRenderBackend()
+    : batchingEnabled(true), builtinFont(false), curColor{ 0, 0, 0, 0 }, colorValid(false), curLineWidth(-1.0f),
+      staticBatched(false), recordingStatic(false), staticList(0), staticListStats(), listStart() {}
+
+void GlRenderBackend::setBatching(bool enabled) {
+    batch.flush();
+    batchingEnabled = enabled;
+}
+
+void GlRenderBackend::setBuiltinFont(bool enabled) {
+    builtinFont = enabled;
+}
+
+bool GlRenderBackend::isBatching() const {
+    return batching();
+}
+
+bool GlRenderBackend::batching() const {
+    return batchingEnabled && batch.ready();
+}
+
+void GlRenderBackend::setColor(Rgba8 c) {
+    if (colorValid && c.r == curColor.r && c.g == curColor.g && c.b == curColor.b && c.a == curColor.a) return;
+    glColor4ub(c.r, c.g, c.b, c.a);
+    curColor = c;
+    colorValid = true;
+    ++stats.stateChanges;
+}
+
+void GlRenderBackend::setLineWidth(float w) {
+    if (w == curLineWidth) return;
+    glLineWidth(w);
+    curLineWidth = w;
+    ++stats.stateChanges;
+}
+
+inline void GlRenderBackend::emitVertex(float x, float y) {
+    glVertex2f(x, y);
+    ++stats.vertices;
+}
+
+void GlRenderBackend::beginImmediate(unsigned int mode) {
+    glBegin(mode);
+    ++stats.drawCalls;
+}
+
+void GlRenderBackend::beginFrame() {
+    if (batchingEnabled) batch.init();
+    batch.resetStats();
+    stats = RenderStats();
+
+    // Other code may have touched GL state between frames.
+    colorValid = false;
+    curLineWidth = -1.0f;
+}
+
+void GlRenderBackend::endFrame() {
+    batch.flush();
+    setLineWidth(1.0f);
+}
+
+RenderStats GlRenderBackend::frameStats() const {
+    RenderStats s = stats;
+    s.vertices += batch.verticesSubmitted();
+    s.drawCalls += batch.drawCalls();
+    return s;
+}
+
+/* ===================== Primitives ===================== */
+
+// Every primitive goes either straight to GL (immediate mode) or into the
+// per-frame batch. Outlines in the batch are real triangle bands rather than
+// GL lines, so fills and outlines share one stream and keep painter's order.
+
+void GlRenderBackend::fillEllipse(const Vec2& c, float rx, float ry, float cr, float sr, Rgba8 color) {
+    ++stats.primitives;
+    const UnitCircleTable& t = unitCircle();
+    int stride = kMaxSegments / segmentsForRadius(std::max(rx, ry));
+
+    if (batching()) {
+        Vec2 prev = ellipsePoint(t, 0, c, rx, ry, cr, sr);
+        for (int i = stride; i <= kMaxSegments; i += stride) {
+            Vec2 cur = ellipsePoint(t, i, c, rx, ry, cr, sr);
+            batch.addTriangle(c, prev, cur, color);
+            prev = cur;
+        }
+        return;
+    }
+
+    setColor(color);
+    beginImmediate(GL_TRIANGLE_FAN);
+    emitVertex(c.x, c.y);
+    for (int i = 0; i <= kMaxSegments; i += stride) {
+        Vec2 p = ellipsePoint(t, i, c, rx, ry, cr, sr);
+        emitVertex(p.x, p.y);
+    }
+    glEnd();
+}
+
+void GlRenderBackend::strokeEllipse(const Vec2& c, float rx, float ry, float cr, float sr, float widthPx, Rgba8 color) {
+    ++stats.primitives;
+    const UnitCircleTable& t = unitCircle();
+    int stride = kMaxSegments / segmentsForRadius(std::max(rx, ry));
+
+    if (batching()) {
+        float hw = halfWidthWorld(widthPx);
+        float inX = std::max(rx - hw, 0.0f), inY = std::max(ry - hw, 0.0f);
+        float outX = rx + hw, outY = ry + hw;
+
+        Vec2 in0 = ellipsePoint(t, 0, c, inX, inY, cr, sr);
+        Vec2 out0 = ellipsePoint(t, 0, c, outX, outY, cr, sr);
+        for (int i = stride; i <= kMaxSegments; i += stride) {
+            Vec2 in1 = ellipsePoint(t, i, c, inX, inY, cr, sr);
+            Vec2 out1 = ellipsePoint(t, i, c, outX, outY, cr, sr);
+            batch.addQuad(in0, out0, out1, in1, color);
+            in0 = in1;
+            out0 = out1;
+        }
+        return;
+    }
+
+    setColor(color);
+    setLineWidth(widthPx);
+    beginImmediate(GL_LINE_LOOP);
+    for (int i = 0; i < kMaxSegments; i += stride) {
+        Vec2 p = ellipsePoint(t, i, c, rx, ry, cr, sr);
+        emitVertex(p.x, p.y);
+    }
+    glEnd();
+}
+
+// One instance in the batched path.
+void GlRenderBackend::outlinedCircle(const Vec2& c, float r, Rgba8 fill, Rgba8 stroke, float widthPx) {
+    if (batching() && batch.supportsInstancing()) {
+        stats.primitives += 2;
+        RenderBatch::CircleInstance inst;
+        inst.x = c.x;
+        inst.y = c.y;
+        inst.radius = r;
+        inst.halfWidth = halfWidthWorld(widthPx);
+        inst.fill = fill;
+        inst.stroke = stroke;
+        batch.addCircleInstance(inst, segmentsForRadius(r));
+        return;
+    }
+    RenderBackend::outlinedCircle(c, r, fill, stroke, widthPx);
+}
+
+void GlRenderBackend::fillQuad(const Vec2 p[4], Rgba8 color) {
+    ++stats.primitives;
+    if (batching()) {
+        batch.addQuad(p[0], p[1], p[2], p[3], color);
+        return;
+    }
+
+    setColor(color);
+    beginImmediate(GL_QUADS);
+    for (int i = 0; i < 4; ++i) emitVertex(p[i].x, p[i].y);
+    glEnd();
+}
+
+void GlRenderBackend::strokeQuad(const Vec2 p[4], float widthPx, Rgba8 color) {
+    ++stats.primitives;
+    if (batching()) {
+        // One band per edge, extended by half the width so corners close.
+        float hw = halfWidthWorld(widthPx);
+        for (int i = 0; i < 4; ++i) {
+            Vec2 a = p[i];
+            Vec2 b = p[(i + 1) % 4];
+            Vec2 d = (b - a).normalized() * hw;
+            Vec2 n(-d.y, d.x);
+            batch.addQuad(a - d - n, b + d - n, b + d + n, a - d + n, color);
+        }
+        return;
+    }
+
+    setColor(color);
+    setLineWidth(widthPx);
+    beginImmediate(GL_LINE_LOOP);
+    for (int i = 0; i < 4; ++i) emitVertex(p[i].x, p[i].y);
+    glEnd();
+}
+
+// Text is drawn with bitmaps (GLUT or built-in), so pending batched geometry
+// has to be submitted first to stay underneath it.
+void GlRenderBackend::drawText(float x, float y, const char* text, TextFont font, Rgba8 color) {
+    ++stats.primitives;
+    batch.flush();
+    setColor(color);
+    glRasterPos2f(x, y);
+    if (builtinFont) {
+        int scale = std::min(BitmapFont::scaleFor(font), 4);
+        for (const char* c = text; *c; ++c) builtinGlyph(*c, scale);
+        return;
+    }
+    void* glut = glutFont(font);
+    for (const char* c = text; *c; ++c) glutBitmapCharacter(glut, *c);
+}
+
+/* ===================== Static layer cache ===================== */
+
+bool GlRenderBackend::beginStaticLayer(unsigned version) {
+    bool batched = batching();
+    bool stale = staticLayerStale(version) || batched != staticBatched;
+    if (!stale) {
+        replayStaticLayer();
+        return false;
+    }
+
+    if (batched) {
+        if (staticList) { glDeleteLists(staticList, 1); staticList = 0; }
+        batch.beginCapture();
+    } else {
+        batch.clearCaptured();
+        if (!staticList) staticList = glGenLists(1);
+        colorValid = false;
+        curLineWidth = -1.0f;
+        glNewList(staticList, GL_COMPILE);
+    }
+    staticBatched = batched;
+    recordingStatic = true;
+    listStart = stats;
+    return true;
+}
+
+void GlRenderBackend::endStaticLayer() {
+    if (!recordingStatic) return;
+    recordingStatic = false;
+    if (staticBatched) batch.endCapture();
+    else glEndList();
+
+    // Recording does not draw; the replay below adds the counters back.
+    staticListStats.primitives = stats.primitives - listStart.primitives;
+    staticListStats.vertices = stats.vertices - listStart.vertices;
+    staticListStats.drawCalls = stats.drawCalls - listStart.drawCalls;
+    staticListStats.stateChanges = stats.stateChanges - listStart.stateChanges;
+    stats = listStart;
+
+    staticLayerRecorded();
+    replayStaticLayer();
+}
+
+void GlRenderBackend::replayStaticLayer() {
+    stats.primitives += staticListStats.primitives;
+    if (staticBatched) {
+        batch.drawCaptured();
+    } else {
+        glCallList(staticList);
+        stats.vertices += staticListStats.vertices;
+        stats.drawCalls += staticListStats.drawCalls;
+        stats.stateChanges += staticListStats.stateChanges;
+    }
+
+    // The replayed commands changed the current color and line width.
+    colorValid = false;
+    curLineWidth = -1.0f;
+}
@@ -0,0 +1,80 @@
+#include "../../include/game/InputScript.h"
+
+// Movement actions: bit 0 forward, bit 1 backward, bit 2 turn left, bit 3 turn right.
+static const int kActions[] = {
+    0x0,        // idle
+    0x1,        // forward
+    0x1 | 0x4,  // forward + left
+    0x1 | 0x8,  // forward + right
+    0x2,        // backward
+    0x4,        // turn left in place
+    0x8         // turn right in place
+};
+static const int kActionCount = int(sizeof(kActions) / sizeof(kActions[0]));
+
+InputScript::InputScript(uint32_t seed, int viewportWidth)
+    : rngState(seed ? seed : 1u),
+      viewportW(viewportWidth > 1 ? viewportWidth : 2),
+      tick(0),
+      p1Action(0),
+      p1Hold(0),
+      p2Action(0),
+      p2Hold(0),
+      mouseX(viewportW / 2),
+      mouseDir(1),
+      p2ArmDir(1) {}
+
+uint32_t InputScript::nextRandom() {
+    // xorshift32: cheap and identical on every platform.
+    uint32_t x = rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rngState = x;
+    return x;
+}
+
+int InputScript::randomRange(int lo, int hi) {
+    return lo + int(nextRandom() % uint32_t(hi - lo + 1));
+}
+
+void InputScript::pickAction(int& action, int& holdTicks) {
+    action = kActions[randomRange(0, kActionCount - 1)];
+    holdTicks = randomRange(15, 90);
+}
+
+void InputScript::step(InputState& in) {
+    if (p1Hold <= 0) pickAction(p1Action, p1Hold);
+    if (p2Hold <= 0) pickAction(p2Action, p2Hold);
+    --p1Hold;
+    --p2Hold;
+
+    in.clear();
+
+    in.keys['w'] = (p1Action & 0x1) != 0;
+    in.keys['s'] = (p1Action & 0x2) != 0;
+    in.keys['a'] = (p1Action & 0x4) != 0;
+    in.keys['d'] = (p1Action & 0x8) != 0;
+
+    in.keys['o'] = (p2Action & 0x1) != 0;
+    in.keys['l'] = (p2Action & 0x2) != 0;
+    in.keys['k'] = (p2Action & 0x4) != 0;
+    in.keys[';'] = (p2Action & 0x8) != 0;
+
+    // P1 arm: mouse sweeps back and forth across the window.
+    mouseX += mouseDir * 7;
+    if (mouseX <= 0)             { mouseX = 0;             mouseDir = 1; }
+    if (mouseX >= viewportW - 1) { mouseX = viewportW - 1; mouseDir = -1; }
+    in.mouseX = mouseX;
+    in.mouseY = 0;
+
+    // P2 arm: occasionally flip direction.
+    if ((tick % 45) == 0 && (nextRandom() & 1u)) p2ArmDir = -p2ArmDir;
+    in.keys[(unsigned char)(p2ArmDir > 0 ? '4' : '6')] = true;
+
+    // Fire in press/release pairs so the edge-triggered shooting logic fires.
+    in.mouseLeftPressed = (tick % 12) < 2;
+    in.keys['5'] = ((tick + 6) % 14) < 2;
+
+    ++tick;
+}
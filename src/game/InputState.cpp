@@ -1,4 +1,5 @@
 #include "../../include/game/InputState.h"
+#include "../../include/math/Angle.h"
 #include <cstring>
 
 InputState::InputState() {
@@ -12,3 +13,44 @@ void InputState::clear() {
     mouseY = 0;
     mouseLeftPressed = false;
 }
+
+PlayerCommand::PlayerCommand()
+    : forward(false),
+      backward(false),
+      turnLeft(false),
+      turnRight(false),
+      fire(false),
+      aim(false),
+      aimFraction(0.5f),
+      armRate(0.0f) {}
+
+PlayerCommand player1Command(const InputState& in, int viewportWidth) {
+    PlayerCommand c;
+    c.forward   = in.keys['w'] || in.keys['W'] || in.specialKeys[SPECIAL_KEY_UP];
+    c.backward  = in.keys['s'] || in.keys['S'] || in.specialKeys[SPECIAL_KEY_DOWN];
+    c.turnLeft  = in.keys['a'] || in.keys['A'] || in.specialKeys[SPECIAL_KEY_LEFT];
+    c.turnRight = in.keys['d'] || in.keys['D'] || in.specialKeys[SPECIAL_KEY_RIGHT];
+    c.fire = in.mouseLeftPressed;
+    // Mouse X across the window sweeps the arm over its range (centred when
+    // the window has no width).
+    c.aim = true;
+    c.aimFraction = (viewportWidth > 1) ? float(in.mouseX) / float(viewportWidth - 1) : 0.5f;
+    c.armRate = 0.0f;
+    return c;
+}
+
+PlayerCommand player2Command(const InputState& in) {
+    PlayerCommand c;
+    c.forward   = in.keys['o'] || in.keys['O'];
+    c.backward  = in.keys['l'] || in.keys['L'];
+    c.turnLeft  = in.keys['k'] || in.keys['K'];
+    c.turnRight = in.keys[';'] || in.keys['p'] || in.keys['P'] || in.keys[231];
+    c.fire = in.keys['5'];
+    c.aim = false;
+
+    float weaponSpeed = Angle::degToRad(120.0f);
+    c.armRate = 0.0f;
+    if (in.keys['4']) c.armRate += weaponSpeed;
+    if (in.keys['6']) c.armRate -= weaponSpeed;
+    return c;
+}
@@ -0,0 +1,77 @@
+#include "../../include/game/MatchPool.h"
+#include "../../include/game/InputScript.h"
+
+#include <chrono>
+
+MatchPool::MatchPool(int threads)
+    : pool(threads),
+      runSeconds(0.0) {}
+
+int MatchPool::threadCount() const { return pool.threadCount(); }
+
+int MatchPool::addScenario(const Game& prototype) {
+    scenarios.push_back(prototype);
+    return int(scenarios.size()) - 1;
+}
+
+int MatchPool::scenarioCount() const { return int(scenarios.size()); }
+
+int MatchPool::addMatch(int scenario, uint32_t seed) {
+    if (scenario < 0 || scenario >= scenarioCount()) return -1;
+
+    MatchResult m = {};
+    m.scenario = scenario;
+    m.seed = seed;
+    matches.push_back(m);
+    return int(matches.size()) - 1;
+}
+
+int MatchPool::matchCount() const { return int(matches.size()); }
+
+void MatchPool::clearMatches() {
+    matches.clear();
+}
+
+void MatchPool::run(long long maxTicks, float dt) {
+    auto t0 = std::chrono::steady_clock::now();
+    pool.parallelFor(matchCount(), [&](int i) { playMatch(i, maxTicks, dt); });
+    runSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Each task writes only its own MatchResult slot; scenarios are read-only
+// while the pool runs.
+void MatchPool::playMatch(int i, long long maxTicks, float dt) {
+    MatchResult& m = matches[i];
+    Game game = scenarios[m.scenario];
+    game.reset();
+
+    InputScript script(m.seed);
+    InputState in;
+
+    long long t = 0;
+    while (t < maxTicks && game.isRunning()) {
+        script.step(in);
+        game.setInput(in);
+        game.update(dt);
+        ++t;
+    }
+
+    const PlayerStore& players = game.getPlayers();
+    m.ticks = t;
+    m.finished = !game.isRunning();
+    m.winnerId = game.getWinnerId();
+    m.livesP1 = players.size() > 0 ? players.lives()[0] : 0;
+    m.livesP2 = players.size() > 1 ? players.lives()[1] : 0;
+}
+
+const std::vector<MatchResult>& MatchPool::results() const { return matches; }
+
+long long MatchPool::totalTicks() const {
+    long long n = 0;
+    for (const MatchResult& m : matches) n += m.ticks;
+    return n;
+}
+
+double MatchPool::lastRunSeconds() const { return runSeconds; }
+
+uint64_t MatchPool::steals() const { return pool.steals(); }
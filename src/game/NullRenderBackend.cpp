@@ -0,0 +1,92 @@
+#include "../../include/game/NullRenderBackend.h"
+
+#include <algorithm>
+
+NullRenderBackend::NullRenderBackend()
+    : curColor{ 0, 0, 0, 0 }, colorValid(false), curLineWidth(-1.0f),
+      recordingStatic(false), staticStats(), staticStart() {}
+
+void NullRenderBackend::beginFrame() {
+    stats = RenderStats();
+    colorValid = false;
+    curLineWidth = -1.0f;
+}
+
+// The GL path resets the line width at the end of a frame.
+void NullRenderBackend::endFrame() {
+    setLineWidth(1.0f);
+}
+
+void NullRenderBackend::primitive(long drawCalls, long vertices, Rgba8 color) {
+    ++stats.primitives;
+    stats.drawCalls += drawCalls;
+    stats.vertices += vertices;
+    if (!colorValid || color.r != curColor.r || color.g != curColor.g || color.b != curColor.b || color.a != curColor.a) {
+        curColor = color;
+        colorValid = true;
+        ++stats.stateChanges;
+    }
+}
+
+void NullRenderBackend::setLineWidth(float w) {
+    if (w == curLineWidth) return;
+    curLineWidth = w;
+    ++stats.stateChanges;
+}
+
+void NullRenderBackend::fillEllipse(const Vec2&, float rx, float ry, float, float, Rgba8 color) {
+    primitive(1, segmentsForRadius(std::max(rx, ry)) + 2, color);
+}
+
+void NullRenderBackend::strokeEllipse(const Vec2&, float rx, float ry, float, float, float widthPx, Rgba8 color) {
+    primitive(1, segmentsForRadius(std::max(rx, ry)), color);
+    setLineWidth(widthPx);
+}
+
+void NullRenderBackend::fillQuad(const Vec2[4], Rgba8 color) {
+    primitive(1, 4, color);
+}
+
+void NullRenderBackend::strokeQuad(const Vec2[4], float widthPx, Rgba8 color) {
+    primitive(1, 4, color);
+    setLineWidth(widthPx);
+}
+
+// A bitmap string is a color change and a raster position, not a draw call.
+void NullRenderBackend::drawText(float, float, const char*, TextFont, Rgba8 color) {
+    primitive(0, 0, color);
+}
+
+bool NullRenderBackend::beginStaticLayer(unsigned version) {
+    if (!staticLayerStale(version)) {
+        replayStaticLayer();
+        return false;
+    }
+    colorValid = false;
+    curLineWidth = -1.0f;
+    recordingStatic = true;
+    staticStart = stats;
+    return true;
+}
+
+void NullRenderBackend::endStaticLayer() {
+    if (!recordingStatic) return;
+    recordingStatic = false;
+    staticStats.primitives = stats.primitives - staticStart.primitives;
+    staticStats.vertices = stats.vertices - staticStart.vertices;
+    staticStats.drawCalls = stats.drawCalls - staticStart.drawCalls;
+    staticStats.stateChanges = stats.stateChanges - staticStart.stateChanges;
+    stats = staticStart;
+
+    staticLayerRecorded();
+    replayStaticLayer();
+}
+
+void NullRenderBackend::replayStaticLayer() {
+    stats.primitives += staticStats.primitives;
+    stats.vertices += staticStats.vertices;
+    stats.drawCalls += staticStats.drawCalls;
+    stats.stateChanges += staticStats.stateChanges;
+    colorValid = false;
+    curLineWidth = -1.0f;
+}
@@ -0,0 +1,153 @@
+#include "../../include/game/RecordingRenderBackend.h"
+#include "../../include/util/Hash.h"
+
+#include <cstring>
+
+RecordingRenderBackend::RecordingRenderBackend() {}
+
+void RecordingRenderBackend::beginFrame() {
+    cmds.clear();
+    chars.clear();
+    stats = RenderStats();
+}
+
+void RecordingRenderBackend::endFrame() {}
+
+RenderCommand& RecordingRenderBackend::push(RenderCommand::Op op, Rgba8 color) {
+    RenderCommand cmd = RenderCommand();
+    cmd.op = op;
+    cmd.color = color;
+    cmds.push_back(cmd);
+    if (op != RenderCommand::Op::BEGIN_STATIC && op != RenderCommand::Op::END_STATIC) ++stats.primitives;
+    return cmds.back();
+}
+
+bool RecordingRenderBackend::beginStaticLayer(unsigned version) {
+    RenderCommand& cmd = push(RenderCommand::Op::BEGIN_STATIC, Rgba8());
+    cmd.version = version;
+    return true;
+}
+
+void RecordingRenderBackend::endStaticLayer() {
+    push(RenderCommand::Op::END_STATIC, Rgba8());
+}
+
+void RecordingRenderBackend::fillEllipse(const Vec2& c, float rx, float ry, float cr, float sr, Rgba8 color) {
+    RenderCommand& cmd = push(RenderCommand::Op::FILL_ELLIPSE, color);
+    float v[6] = { c.x, c.y, rx, ry, cr, sr };
+    std::memcpy(cmd.v, v, sizeof(v));
+}
+
+void RecordingRenderBackend::strokeEllipse(const Vec2& c, float rx, float ry, float cr, float sr, float widthPx, Rgba8 color) {
+    RenderCommand& cmd = push(RenderCommand::Op::STROKE_ELLIPSE, color);
+    float v[6] = { c.x, c.y, rx, ry, cr, sr };
+    std::memcpy(cmd.v, v, sizeof(v));
+    cmd.width = widthPx;
+}
+
+void RecordingRenderBackend::fillCircle(const Vec2& c, float r, Rgba8 color) {
+    RenderCommand& cmd = push(RenderCommand::Op::FILL_CIRCLE, color);
+    cmd.v[0] = c.x;
+    cmd.v[1] = c.y;
+    cmd.v[2] = r;
+}
+
+void RecordingRenderBackend::strokeCircle(const Vec2& c, float r, float widthPx, Rgba8 color) {
+    RenderCommand& cmd = push(RenderCommand::Op::STROKE_CIRCLE, color);
+    cmd.v[0] = c.x;
+    cmd.v[1] = c.y;
+    cmd.v[2] = r;
+    cmd.width = widthPx;
+}
+
+// Counted as two primitives, like the fill + outline it stands for.
+void RecordingRenderBackend::outlinedCircle(const Vec2& c, float r, Rgba8 fill, Rgba8 stroke, float widthPx) {
+    RenderCommand& cmd = push(RenderCommand::Op::OUTLINED_CIRCLE, fill);
+    cmd.color2 = stroke;
+    cmd.v[0] = c.x;
+    cmd.v[1] = c.y;
+    cmd.v[2] = r;
+    cmd.width = widthPx;
+    ++stats.primitives;
+}
+
+void RecordingRenderBackend::fillQuad(const Vec2 p[4], Rgba8 color) {
+    RenderCommand& cmd = push(RenderCommand::Op::FILL_QUAD, color);
+    for (int i = 0; i < 4; ++i) {
+        cmd.v[2 * i] = p[i].x;
+        cmd.v[2 * i + 1] = p[i].y;
+    }
+}
+
+void RecordingRenderBackend::strokeQuad(const Vec2 p[4], float widthPx, Rgba8 color) {
+    RenderCommand& cmd = push(RenderCommand::Op::STROKE_QUAD, color);
+    for (int i = 0; i < 4; ++i) {
+        cmd.v[2 * i] = p[i].x;
+        cmd.v[2 * i + 1] = p[i].y;
+    }
+    cmd.width = widthPx;
+}
+
+void RecordingRenderBackend::drawText(float x, float y, const char* text, TextFont font, Rgba8 color) {
+    RenderCommand& cmd = push(RenderCommand::Op::TEXT, color);
+    cmd.font = font;
+    cmd.v[0] = x;
+    cmd.v[1] = y;
+    cmd.textOffset = int(chars.size());
+    chars.insert(chars.end(), text, text + std::strlen(text) + 1);
+}
+
+const std::vector<RenderCommand>& RecordingRenderBackend::commands() const {
+    return cmds;
+}
+
+const char* RecordingRenderBackend::text(const RenderCommand& cmd) const {
+    return chars.data() + cmd.textOffset;
+}
+
+void RecordingRenderBackend::replay(RenderBackend& target) const {
+    typedef RenderCommand::Op Op;
+    for (size_t i = 0; i < cmds.size(); ++i) {
+        const RenderCommand& c = cmds[i];
+        const float* v = c.v;
+        switch (c.op) {
+        case Op::FILL_ELLIPSE: target.fillEllipse(Vec2(v[0], v[1]), v[2], v[3], v[4], v[5], c.color); break;
+        case Op::STROKE_ELLIPSE: target.strokeEllipse(Vec2(v[0], v[1]), v[2], v[3], v[4], v[5], c.width, c.color); break;
+        case Op::FILL_CIRCLE: target.fillCircle(Vec2(v[0], v[1]), v[2], c.color); break;
+        case Op::STROKE_CIRCLE: target.strokeCircle(Vec2(v[0], v[1]), v[2], c.width, c.color); break;
+        case Op::OUTLINED_CIRCLE: target.outlinedCircle(Vec2(v[0], v[1]), v[2], c.color, c.color2, c.width); break;
+        case Op::FILL_QUAD:
+        case Op::STROKE_QUAD: {
+            Vec2 p[4] = { Vec2(v[0], v[1]), Vec2(v[2], v[3]), Vec2(v[4], v[5]), Vec2(v[6], v[7]) };
+            if (c.op == Op::FILL_QUAD) target.fillQuad(p, c.color);
+            else target.strokeQuad(p, c.width, c.color);
+            break;
+        }
+        case Op::TEXT: target.drawText(v[0], v[1], text(c), c.font, c.color); break;
+        case Op::BEGIN_STATIC:
+            // Target's cache is current: skip to the matching END_STATIC.
+            if (!target.beginStaticLayer(c.version)) {
+                while (i + 1 < cmds.size() && cmds[i + 1].op != Op::END_STATIC) ++i;
+                ++i;
+            }
+            break;
+        case Op::END_STATIC: target.endStaticLayer(); break;
+        }
+    }
+}
+
+// Field by field: the struct has padding.
+uint64_t RecordingRenderBackend::hash() const {
+    uint64_t h = Hash::kSeed;
+    for (const RenderCommand& c : cmds) {
+        h = Hash::value(uint8_t(c.op), h);
+        h = Hash::value(uint8_t(c.font), h);
+        h = Hash::bytes(&c.color, sizeof(c.color), h);
+        h = Hash::bytes(&c.color2, sizeof(c.color2), h);
+        h = Hash::value(c.width, h);
+        h = Hash::bytes(c.v, sizeof(c.v), h);
+        h = Hash::value(c.version, h);
+        if (c.op == RenderCommand::Op::TEXT) h = Hash::bytes(text(c), std::strlen(text(c)), h);
+    }
+    return h;
+}
@@ -0,0 +1,116 @@
+#include "../../include/game/RenderBackend.h"
+
+#include <algorithm>
+#include <cmath>
+
+Rgba8 rgb(float r, float g, float b) {
+    auto to8 = [](float v) -> uint8_t {
+        v = (v < 0.0f) ? 0.0f : ((v > 1.0f) ? 1.0f : v);
+        return (uint8_t)std::lround(v * 255.0f);
+    };
+    Rgba8 c = { to8(r), to8(g), to8(b), 255 };
+    return c;
+}
+
+/* ===================== Tessellation ===================== */
+
+static const int kSegmentLevels[] = { 8, 12, 16, 24, 32, 48, 96 };
+
+// Max distance (in pixels) between a true circle and its polygon.
+static const float kMaxPixelError = 0.25f;
+
+// Sagitta of one segment per unit radius, r * (1 - cos(pi / n)) / r.
+struct SagittaTable {
+    float perUnit[sizeof(kSegmentLevels) / sizeof(kSegmentLevels[0])];
+
+    SagittaTable() {
+        for (size_t i = 0; i < sizeof(kSegmentLevels) / sizeof(kSegmentLevels[0]); ++i) {
+            perUnit[i] = 1.0f - std::cos(3.1415926535f / float(kSegmentLevels[i]));
+        }
+    }
+};
+
+static const SagittaTable& sagitta() {
+    static const SagittaTable table;
+    return table;
+}
+
+/* ===================== RenderBackend ===================== */
+
+RenderBackend::RenderBackend()
+    : stats(), ppu(1.0f), view(Rect::unbounded()), staticValid(false), staticVersion(0), pendingVersion(0),
+      staticPpu(0.0f), staticRect(Rect::unbounded()), pendingRect(Rect::unbounded()) {}
+
+RenderBackend::~RenderBackend() {}
+
+void RenderBackend::setPixelsPerUnit(float pixelsPerUnit) {
+    ppu = (pixelsPerUnit > 0.0f) ? pixelsPerUnit : 1.0f;
+}
+
+float RenderBackend::pixelsPerUnit() const {
+    return ppu;
+}
+
+void RenderBackend::setViewRect(const Rect& rect) {
+    view = rect;
+}
+
+const Rect& RenderBackend::viewRect() const {
+    return view;
+}
+
+void RenderBackend::invalidateStaticLayer() {
+    staticValid = false;
+}
+
+const Rect& RenderBackend::staticLayerRect() const {
+    return pendingRect;
+}
+
+bool RenderBackend::staticLayerStale(unsigned version) {
+    pendingVersion = version;
+    bool stale = !staticValid || version != staticVersion || ppu != staticPpu || !staticRect.contains(view);
+    if (stale) {
+        pendingRect = view.isBounded() ? view.expanded(0.5f * std::max(view.width(), view.height())) : view;
+    } else {
+        pendingRect = staticRect;
+    }
+    return stale;
+}
+
+void RenderBackend::staticLayerRecorded() {
+    staticValid = true;
+    staticVersion = pendingVersion;
+    staticPpu = ppu;
+    staticRect = pendingRect;
+}
+
+void RenderBackend::fillCircle(const Vec2& c, float r, Rgba8 color) {
+    fillEllipse(c, r, r, 1.0f, 0.0f, color);
+}
+
+void RenderBackend::strokeCircle(const Vec2& c, float r, float widthPx, Rgba8 color) {
+    strokeEllipse(c, r, r, 1.0f, 0.0f, widthPx, color);
+}
+
+void RenderBackend::outlinedCircle(const Vec2& c, float r, Rgba8 fill, Rgba8 stroke, float widthPx) {
+    fillCircle(c, r, fill);
+    strokeCircle(c, r, widthPx, stroke);
+}
+
+RenderStats RenderBackend::frameStats() const {
+    return stats;
+}
+
+int RenderBackend::segmentsForRadius(float radius) const {
+    float rPx = radius * ppu;
+    const SagittaTable& t = sagitta();
+    for (size_t i = 0; i < sizeof(kSegmentLevels) / sizeof(kSegmentLevels[0]); ++i) {
+        if (rPx * t.perUnit[i] <= kMaxPixelError) return kSegmentLevels[i];
+    }
+    return kMaxSegments;
+}
+
+float RenderBackend::halfWidthWorld(float widthPx) const {
+    return 0.5f * widthPx / ppu;
+}
@@ -0,0 +1,358 @@
+#define GL_GLEXT_PROTOTYPES
+#include "../../include/game/RenderBatch.h"
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+/* ===================== Circle instancing program ===================== */
+
+// Mesh vertices carry (cos, sin, radial, width, outline): the position is
+// center + dir * (radius * radial + halfWidth * width), so one mesh serves
+// every radius and keeps outlines a constant on-screen thickness.
+static const int kMeshFloats = 5;
+
+enum CircleAttrib {
+    ATTR_CORNER = 0,   // must be 0: compatibility contexts require attribute 0 to be an array
+    ATTR_OUTLINE = 1,
+    ATTR_INSTANCE = 2,
+    ATTR_FILL = 3,
+    ATTR_STROKE = 4
+};
+
+static const char* kCircleVs =
+    "#version 120\n"
+    "attribute vec4 aCorner;\n"
+    "attribute float aOutline;\n"
+    "attribute vec4 aInstance;\n"
+    "attribute vec4 aFill;\n"
+    "attribute vec4 aStroke;\n"
+    "varying vec4 vColor;\n"
+    "void main() {\n"
+    "    float d = aInstance.z * aCorner.z + aInstance.w * aCorner.w;\n"
+    "    vec2 p = aInstance.xy + vec2(aCorner.x, -aCorner.y) * d;\n"
+    "    vColor = mix(aFill, aStroke, aOutline);\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4(p, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* kCircleFs =
+    "#version 120\n"
+    "varying vec4 vColor;\n"
+    "void main() { gl_FragColor = vColor; }\n";
+
+static GLuint compileShader(GLenum type, const char* src) {
+    GLuint sh = glCreateShader(type);
+    glShaderSource(sh, 1, &src, nullptr);
+    glCompileShader(sh);
+    GLint ok = GL_FALSE;
+    glGetShaderiv(sh, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[512];
+        glGetShaderInfoLog(sh, sizeof(log), nullptr, log);
+        std::fprintf(stderr, "[RenderBatch] shader compile failed: %s\n", log);
+        glDeleteShader(sh);
+        return 0;
+    }
+    return sh;
+}
+
+static bool glVersionAtLeast(int wantMajor, int wantMinor) {
+    const char* v = (const char*)glGetString(GL_VERSION);
+    int major = 0, minor = 0;
+    if (!v || std::sscanf(v, "%d.%d", &major, &minor) != 2) return false;
+    return major > wantMajor || (major == wantMajor && minor >= wantMinor);
+}
+
+static bool hasExtension(const char* name) {
+    const char* ext = (const char*)glGetString(GL_EXTENSIONS);
+    return ext && std::strstr(ext, name) != nullptr;
+}
+
+/* ===================== RenderBatch ===================== */
+
+RenderBatch::RenderBatch()
+    : initTried(false),
+      initOk(false),
+      instancing(false),
+      run(Run::NONE),
+      circleSegments(0),
+      capturing(false),
+      captured(false),
+      streamVbo(0),
+      instanceVbo(0),
+      meshVbo(0),
+      circleProgram(0),
+      meshFirst(97, 0),
+      meshCount(97, 0),
+      vertexCounter(0),
+      drawCallCounter(0) {}
+
+bool RenderBatch::init() {
+    if (initTried) return initOk;
+    initTried = true;
+
+    if (!glVersionAtLeast(1, 5)) return false;
+
+    glGenBuffers(1, &streamVbo);
+    glGenBuffers(1, &instanceVbo);
+    glGenBuffers(1, &meshVbo);
+    initOk = true;
+
+    bool hasInstancedArrays = glVersionAtLeast(3, 3) || hasExtension("GL_ARB_instanced_arrays");
+    instancing = glVersionAtLeast(2, 0) && hasInstancedArrays && buildCircleProgram();
+    return true;
+}
+
+bool RenderBatch::ready() const { return initOk; }
+bool RenderBatch::supportsInstancing() const { return instancing; }
+
+bool RenderBatch::buildCircleProgram() {
+    GLuint vs = compileShader(GL_VERTEX_SHADER, kCircleVs);
+    GLuint fs = compileShader(GL_FRAGMENT_SHADER, kCircleFs);
+    if (!vs || !fs) return false;
+
+    GLuint prog = glCreateProgram();
+    glAttachShader(prog, vs);
+    glAttachShader(prog, fs);
+    glBindAttribLocation(prog, ATTR_CORNER, "aCorner");
+    glBindAttribLocation(prog, ATTR_OUTLINE, "aOutline");
+    glBindAttribLocation(prog, ATTR_INSTANCE, "aInstance");
+    glBindAttribLocation(prog, ATTR_FILL, "aFill");
+    glBindAttribLocation(prog, ATTR_STROKE, "aStroke");
+    glLinkProgram(prog);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        glDeleteProgram(prog);
+        return false;
+    }
+    circleProgram = prog;
+    return true;
+}
+
+void RenderBatch::ensureCircleMesh(int segments) {
+    if (segments < 3 || segments >= (int)meshCount.size()) return;
+    if (meshCount[segments] > 0) return;
+
+    auto push = [&](float c, float s, float radial, float width, float outline) {
+        meshData.push_back(c);
+        meshData.push_back(s);
+        meshData.push_back(radial);
+        meshData.push_back(width);
+        meshData.push_back(outline);
+    };
+
+    int first = int(meshData.size()) / kMeshFloats;
+    for (int i = 0; i < segments; ++i) {
+        float a0 = 2.0f * 3.1415926535f * float(i) / float(segments);
+        float a1 = 2.0f * 3.1415926535f * float(i + 1) / float(segments);
+        float c0 = std::cos(a0), s0 = std::sin(a0);
+        float c1 = std::cos(a1), s1 = std::sin(a1);
+
+        // Fill wedge.
+        push(0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        push(c0, s0, 1.0f, 0.0f, 0.0f);
+        push(c1, s1, 1.0f, 0.0f, 0.0f);
+
+        // Outline band, drawn after the wedge so it stays on top.
+        push(c0, s0, 1.0f, -1.0f, 1.0f);
+        push(c0, s0, 1.0f, 1.0f, 1.0f);
+        push(c1, s1, 1.0f, 1.0f, 1.0f);
+        push(c0, s0, 1.0f, -1.0f, 1.0f);
+        push(c1, s1, 1.0f, 1.0f, 1.0f);
+        push(c1, s1, 1.0f, -1.0f, 1.0f);
+    }
+    meshFirst[segments] = first;
+    meshCount[segments] = segments * 9;
+
+    glBindBuffer(GL_ARRAY_BUFFER, meshVbo);
+    glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(meshData.size() * sizeof(float)), meshData.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderBatch::beginRun(Run kind) {
+    if (run == kind) return;
+    flush();
+    run = kind;
+}
+
+void RenderBatch::addTriangle(const Vec2& a, const Vec2& b, const Vec2& c, Rgba8 color) {
+    beginRun(Run::TRIANGLES);
+    triangles.push_back({ a.x, a.y, color });
+    triangles.push_back({ b.x, b.y, color });
+    triangles.push_back({ c.x, c.y, color });
+}
+
+void RenderBatch::addQuad(const Vec2& p0, const Vec2& p1, const Vec2& p2, const Vec2& p3, Rgba8 color) {
+    addTriangle(p0, p1, p2, color);
+    addTriangle(p0, p2, p3, color);
+}
+
+void RenderBatch::addCircleInstance(const CircleInstance& inst, int segments) {
+    beginRun(Run::CIRCLES);
+    circles.push_back(inst);
+    if (segments > circleSegments) circleSegments = segments;
+}
+
+void RenderBatch::flush() {
+    if (run == Run::TRIANGLES) flushTriangles();
+    else if (run == Run::CIRCLES) flushCircles();
+    run = Run::NONE;
+}
+
+// Uploads `bytes` into a fresh static buffer (capture) or the given stream
+// buffer, orphaning its previous contents so the driver never stalls on an
+// in-flight draw.
+static void uploadBuffer(unsigned int vbo, const void* data, size_t bytes, bool isStatic) {
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (isStatic) {
+        glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(bytes), data, GL_STATIC_DRAW);
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(bytes), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, GLsizeiptr(bytes), data);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderBatch::flushTriangles() {
+    if (triangles.empty()) return;
+
+    const size_t bytes = triangles.size() * sizeof(Vertex);
+    const int count = int(triangles.size());
+
+    if (capturing) {
+        GLuint vbo = 0;
+        glGenBuffers(1, &vbo);
+        uploadBuffer(vbo, triangles.data(), bytes, true);
+        capturedRuns.push_back({ Run::TRIANGLES, vbo, count, 0 });
+    } else {
+        uploadBuffer(streamVbo, triangles.data(), bytes, false);
+        drawTriangleBuffer(streamVbo, count);
+    }
+    triangles.clear();
+}
+
+void RenderBatch::drawTriangleBuffer(unsigned int vbo, int vertexCount) {
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), (const void*)0);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), (const void*)offsetof(Vertex, color));
+
+    glDrawArrays(GL_TRIANGLES, 0, GLsizei(vertexCount));
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    vertexCounter += long(vertexCount);
+    ++drawCallCounter;
+}
+
+void RenderBatch::flushCircles() {
+    if (circles.empty()) return;
+
+    int segments = circleSegments;
+    circleSegments = 0;
+    ensureCircleMesh(segments);
+
+    const size_t bytes = circles.size() * sizeof(CircleInstance);
+    const int count = int(circles.size());
+
+    if (capturing) {
+        GLuint vbo = 0;
+        glGenBuffers(1, &vbo);
+        uploadBuffer(vbo, circles.data(), bytes, true);
+        capturedRuns.push_back({ Run::CIRCLES, vbo, count, segments });
+    } else {
+        uploadBuffer(instanceVbo, circles.data(), bytes, false);
+        drawCircleBuffer(instanceVbo, count, segments);
+    }
+    circles.clear();
+}
+
+void RenderBatch::drawCircleBuffer(unsigned int vbo, int instanceCount, int segments) {
+    glUseProgram(circleProgram);
+
+    glBindBuffer(GL_ARRAY_BUFFER, meshVbo);
+    glEnableVertexAttribArray(ATTR_CORNER);
+    glEnableVertexAttribArray(ATTR_OUTLINE);
+    const GLsizei meshStride = kMeshFloats * sizeof(float);
+    glVertexAttribPointer(ATTR_CORNER, 4, GL_FLOAT, GL_FALSE, meshStride, (const void*)0);
+    glVertexAttribPointer(ATTR_OUTLINE, 1, GL_FLOAT, GL_FALSE, meshStride, (const void*)(4 * sizeof(float)));
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    const GLsizei instStride = sizeof(CircleInstance);
+    glEnableVertexAttribArray(ATTR_INSTANCE);
+    glEnableVertexAttribArray(ATTR_FILL);
+    glEnableVertexAttribArray(ATTR_STROKE);
+    glVertexAttribPointer(ATTR_INSTANCE, 4, GL_FLOAT, GL_FALSE, instStride, (const void*)0);
+    glVertexAttribPointer(ATTR_FILL, 4, GL_UNSIGNED_BYTE, GL_TRUE, instStride,
+                          (const void*)offsetof(CircleInstance, fill));
+    glVertexAttribPointer(ATTR_STROKE, 4, GL_UNSIGNED_BYTE, GL_TRUE, instStride,
+                          (const void*)offsetof(CircleInstance, stroke));
+    glVertexAttribDivisor(ATTR_INSTANCE, 1);
+    glVertexAttribDivisor(ATTR_FILL, 1);
+    glVertexAttribDivisor(ATTR_STROKE, 1);
+
+    glDrawArraysInstanced(GL_TRIANGLES, meshFirst[segments], meshCount[segments], GLsizei(instanceCount));
+
+    glVertexAttribDivisor(ATTR_INSTANCE, 0);
+    glVertexAttribDivisor(ATTR_FILL, 0);
+    glVertexAttribDivisor(ATTR_STROKE, 0);
+    glDisableVertexAttribArray(ATTR_STROKE);
+    glDisableVertexAttribArray(ATTR_FILL);
+    glDisableVertexAttribArray(ATTR_INSTANCE);
+    glDisableVertexAttribArray(ATTR_OUTLINE);
+    glDisableVertexAttribArray(ATTR_CORNER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+
+    vertexCounter += long(meshCount[segments]) * long(instanceCount);
+    ++drawCallCounter;
+}
+
+void RenderBatch::beginCapture() {
+    flush();
+    clearCaptured();
+    capturing = true;
+}
+
+void RenderBatch::endCapture() {
+    flush();
+    capturing = false;
+    captured = true;
+}
+
+void RenderBatch::drawCaptured() {
+    flush();
+    for (const CapturedRun& r : capturedRuns) {
+        if (r.kind == Run::TRIANGLES) drawTriangleBuffer(r.vbo, r.count);
+        else drawCircleBuffer(r.vbo, r.count, r.segments);
+    }
+}
+
+void RenderBatch::clearCaptured() {
+    for (const CapturedRun& r : capturedRuns) {
+        GLuint vbo = r.vbo;
+        glDeleteBuffers(1, &vbo);
+    }
+    capturedRuns.clear();
+    captured = false;
+}
+
+bool RenderBatch::hasCaptured() const { return captured; }
+
+void RenderBatch::resetStats() {
+    vertexCounter = 0;
+    drawCallCounter = 0;
+}
+
+long RenderBatch::verticesSubmitted() const { return vertexCounter; }
+long RenderBatch::drawCalls() const { return drawCallCounter; }
@@ -1,153 +1,184 @@
 #include "../../include/game/Renderer.h"
+#include "../../include/game/NullRenderBackend.h"
 #include "../../include/math/Angle.h"
-#include <GL/glut.h>
-#include <cmath>
+#include "../../include/util/Profiler.h"
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <string>
 
-static void drawText(float x, float y, const char* s, void* font) {
-    glRasterPos2f(x, y);
-    for (const char* c = s; *c; ++c) glutBitmapCharacter(font, *c);
+/* ===================== Backend ===================== */
+
+// Per thread, like the scratch buffers below: each thread draws through its
+// own backend (raster workers, matches drawn in a pool).
+static thread_local RenderBackend* gBackend = nullptr;
+
+static RenderBackend& out() {
+    static thread_local NullRenderBackend fallback;
+    return gBackend ? *gBackend : fallback;
 }
 
-static void drawCircleFilledYDown(const Vec2& c, float r, int segments = 96) {
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(c.x, c.y);
-    for (int i = 0; i <= segments; ++i) {
-        float a = 2.0f * 3.1415926535f * float(i) / float(segments);
-        glVertex2f(c.x + std::cos(a) * r, c.y - std::sin(a) * r);
-    }
-    glEnd();
+static void rectPoints(const Vec2& center, const Vec2& dirUnit, float halfLen, float halfW, Vec2 p[4]) {
+    Vec2 d = dirUnit;
+    Vec2 n(-d.y, d.x);
+
+    p[0] = center - d * halfLen - n * halfW;
+    p[1] = center + d * halfLen - n * halfW;
+    p[2] = center + d * halfLen + n * halfW;
+    p[3] = center - d * halfLen + n * halfW;
 }
 
-static void drawCircleOutlineYDown(const Vec2& c, float r, int segments = 96) {
-    glBegin(GL_LINE_LOOP);
-    for (int i = 0; i < segments; ++i) {
-        float a = 2.0f * 3.1415926535f * float(i) / float(segments);
-        glVertex2f(c.x + std::cos(a) * r, c.y - std::sin(a) * r);
-    }
-    glEnd();
+static int footSwapPhase(const Player& p) {
+    // Do NOT depend on p.walking; your runs show it isn't reliable.
+    // walkPhase is the correct semantic clock for the step cycle.
+    // sin(walkPhase) >= 0, without the sin.
+    return (Angle::wrap2Pi(p.walkPhase) <= Angle::pi()) ? 0 : 1;
 }
 
-static void drawEllipseFilledYDown(const Vec2& c, float rx, float ry, float rotRad, int segments = 96) {
-    float cr = std::cos(rotRad);
-    float sr = std::sin(rotRad);
+/* ===================== Frame ===================== */
 
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(c.x, c.y);
-    for (int i = 0; i <= segments; ++i) {
-        float a = 2.0f * 3.1415926535f * float(i) / float(segments);
-        float ex = std::cos(a) * rx;
-        float ey = -std::sin(a) * ry;
+void Renderer::setBackend(RenderBackend* backend) {
+    gBackend = backend;
+}
 
-        float x = ex * cr - ey * sr;
-        float y = ex * sr + ey * cr;
-        glVertex2f(c.x + x, c.y + y);
-    }
-    glEnd();
+RenderBackend& Renderer::backend() {
+    return out();
+}
+
+Renderer::BackendScope::BackendScope(RenderBackend& backend) : previous(gBackend) {
+    gBackend = &backend;
 }
 
-static void drawEllipseOutlineYDown(const Vec2& c, float rx, float ry, float rotRad, int segments = 96) {
-    float cr = std::cos(rotRad);
-    float sr = std::sin(rotRad);
+Renderer::BackendScope::~BackendScope() {
+    gBackend = previous;
+}
 
-    glBegin(GL_LINE_LOOP);
-    for (int i = 0; i < segments; ++i) {
-        float a = 2.0f * 3.1415926535f * float(i) / float(segments);
-        float ex = std::cos(a) * rx;
-        float ey = -std::sin(a) * ry;
+void Renderer::setPixelsPerUnit(float pixelsPerUnit) {
+    out().setPixelsPerUnit(pixelsPerUnit);
+}
 
-        float x = ex * cr - ey * sr;
-        float y = ex * sr + ey * cr;
-        glVertex2f(c.x + x, c.y + y);
-    }
-    glEnd();
+void Renderer::setViewRect(const Rect& view) {
+    out().setViewRect(view);
 }
 
-static void rectPoints(const Vec2& center, const Vec2& dirUnit, float halfLen, float halfW,
-                       Vec2& p0, Vec2& p1, Vec2& p2, Vec2& p3) {
-    Vec2 d = dirUnit;
-    Vec2 n(-d.y, d.x);
+void Renderer::beginFrame() {
+    out().beginFrame();
+}
 
-    p0 = center - d * halfLen - n * halfW;
-    p1 = center + d * halfLen - n * halfW;
-    p2 = center + d * halfLen + n * halfW;
-    p3 = center - d * halfLen + n * halfW;
+void Renderer::endFrame() {
+    Profiler::Scope scope(ProfileZone::RENDER_SUBMIT);
+    out().endFrame();
 }
 
-static void drawRectFilled(const Vec2& center, const Vec2& dirUnit, float halfLen, float halfW) {
-    Vec2 p0, p1, p2, p3;
-    rectPoints(center, dirUnit, halfLen, halfW, p0, p1, p2, p3);
+long Renderer::verticesThisFrame() {
+    return out().frameStats().vertices;
+}
 
-    glBegin(GL_QUADS);
-    glVertex2f(p0.x, p0.y);
-    glVertex2f(p1.x, p1.y);
-    glVertex2f(p2.x, p2.y);
-    glVertex2f(p3.x, p3.y);
-    glEnd();
+long Renderer::drawCallsThisFrame() {
+    return out().frameStats().drawCalls;
 }
 
-static void drawRectOutline(const Vec2& center, const Vec2& dirUnit, float halfLen, float halfW) {
-    Vec2 p0, p1, p2, p3;
-    rectPoints(center, dirUnit, halfLen, halfW, p0, p1, p2, p3);
+void Renderer::invalidateStaticLayer() {
+    out().invalidateStaticLayer();
+}
 
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(p0.x, p0.y);
-    glVertex2f(p1.x, p1.y);
-    glVertex2f(p2.x, p2.y);
-    glVertex2f(p3.x, p3.y);
-    glEnd();
+/* ===================== Culling ===================== */
+
+// Whether any of the arena outline (width included) falls in the rect:
+// the rect must reach the circle's box without lying entirely inside it.
+static bool arenaOutlineVisible(const Rect& rect, const Arena& arena, float halfWidth) {
+    if (!rect.isBounded()) return true;
+    if (!rect.overlapsCircle(arena.center, arena.radius + halfWidth)) return false;
+    float dx = std::max(arena.center.x - rect.minX, rect.maxX - arena.center.x);
+    float dy = std::max(arena.center.y - rect.minY, rect.maxY - arena.center.y);
+    float inner = arena.radius - halfWidth;
+    return inner <= 0.0f || dx * dx + dy * dy >= inner * inner;
 }
 
-static int footSwapPhase(const Player& p) {
-    // Do NOT depend on p.walking; your runs show it isn't reliable.
-    // walkPhase is the correct semantic clock for the step cycle.
-    return (std::sin(p.walkPhase) >= 0.0f) ? 0 : 1;
+// Screen-anchored text goes in the view; the arena's box when unbounded.
+static Rect screenRect(const Arena& arena) {
+    const Rect& view = out().viewRect();
+    if (view.isBounded()) return view;
+    return Rect::around(arena.center, arena.radius, arena.radius);
 }
 
+void Renderer::drawStaticLayer(const Arena& arena, const std::vector<Obstacle>& obstacles,
+                               const ObstacleGrid& grid, unsigned version) {
+    RenderBackend& b = out();
+    if (!b.beginStaticLayer(version)) return;
+
+    const Rect& area = b.staticLayerRect();
+    if (arenaOutlineVisible(area, arena, 2.0f / b.pixelsPerUnit())) drawArena(arena);
+
+    if (!area.isBounded()) {
+        for (const auto& ob : obstacles) drawObstacle(ob);
+        b.endStaticLayer();
+        return;
+    }
+
+    // Only the obstacles in the area, sorted back into file order so
+    // overlapping ones keep their stacking when the area moves.
+    static thread_local std::vector<int> visible;
+    visible.clear();
+    if (grid.empty()) {
+        for (int i = 0; i < (int)obstacles.size(); ++i) {
+            if (area.overlapsCircle(obstacles[i].pos, obstacles[i].radius)) visible.push_back(i);
+        }
+    } else {
+        // The grid's own box bounds the query, so it never sees infinities.
+        float ox = grid.gridOriginX(), oy = grid.gridOriginY();
+        float ex = ox + float(grid.columns()) * grid.cellSize(), ey = oy + float(grid.rows()) * grid.cellSize();
+        grid.forEachInBox(std::max(area.minX, ox), std::max(area.minY, oy), std::min(area.maxX, ex),
+                          std::min(area.maxY, ey), [&](const ObstacleGrid::Entry& e) {
+            if (area.overlapsCircle(Vec2(e.x, e.y), e.r)) visible.push_back(e.index);
+        });
+        std::sort(visible.begin(), visible.end());
+    }
+    for (int i : visible) drawObstacle(obstacles[size_t(i)]);
+    b.endStaticLayer();
+}
+
+/* ===================== Scene ===================== */
+
 void Renderer::drawArena(const Arena& arena) {
-    glLineWidth(4.0f);
-    glColor3f(0.1f, 0.35f, 1.0f);
-    drawCircleOutlineYDown(arena.center, arena.radius);
-    glLineWidth(1.0f);
+    out().strokeCircle(arena.center, arena.radius, 4.0f, rgb(0.1f, 0.35f, 1.0f));
 }
 
 void Renderer::drawObstacle(const Obstacle& obstacle) {
-    glColor3f(0.02f, 0.02f, 0.02f);
-    drawCircleFilledYDown(obstacle.pos, obstacle.radius);
-
-    glLineWidth(3.0f);
-    glColor3f(1.0f, 1.0f, 1.0f);
-    drawCircleOutlineYDown(obstacle.pos, obstacle.radius);
-    glLineWidth(1.0f);
+    out().outlinedCircle(obstacle.pos, obstacle.radius, rgb(0.02f, 0.02f, 0.02f), rgb(1.0f, 1.0f, 1.0f), 3.0f);
 }
 
 void Renderer::drawPlayer(const Player& player) {
+    drawPlayer(player, player.approxPose());
+}
+
+void Renderer::drawPlayer(const Player& player, const PlayerPose& pose) {
+    RenderBackend& b = out();
     float R = player.headRadius;
+    // Feet and weapon reach about 2.6 R from the center.
+    if (!b.viewRect().overlapsCircle(player.pos, 3.0f * R)) return;
 
-    Vec2 f = player.forward();      // heading=0 -> north (0,-1)
-    Vec2 left(f.y, -f.x);           // correct for Y-down
-    Vec2 right(-f.y, f.x);
+    const Vec2& f = pose.forward;
+    const Vec2& left = pose.left;
+    const Vec2& right = pose.right;
 
-    float rFill, gFill, bFill;
-    if ((int)player.id == 1) { rFill = 0.0f; gFill = 0.75f; bFill = 0.25f; }
-    else { rFill = 0.85f; gFill = 0.20f; bFill = 0.20f; }
+    Rgba8 fill = ((int)player.id == 1) ? rgb(0.0f, 0.75f, 0.25f) : rgb(0.85f, 0.20f, 0.20f);
+    Rgba8 black = rgb(0.0f, 0.0f, 0.0f);
 
     // --- Arms: fixed ellipses left/right, colored like body ---
     float armRx = R * 0.95f;
     float armRy = R * 0.35f;
     Vec2 armL = player.pos + left  * (R * 1.05f);
     Vec2 armR = player.pos + right * (R * 1.05f);
-    float armsRot = std::atan2(left.y, left.x);
+    // The arm ellipses' major axis runs along `left`, a unit vector.
+    float armsCos = left.x;
+    float armsSin = left.y;
 
-    glColor3f(rFill, gFill, bFill);
-    drawEllipseFilledYDown(armL, armRx, armRy, armsRot);
-    drawEllipseFilledYDown(armR, armRx, armRy, armsRot);
+    b.fillEllipse(armL, armRx, armRy, armsCos, armsSin, fill);
+    b.fillEllipse(armR, armRx, armRy, armsCos, armsSin, fill);
 
-    glLineWidth(3.0f);
-    glColor3f(0.0f, 0.0f, 0.0f);
-    drawEllipseOutlineYDown(armL, armRx, armRy, armsRot);
-    drawEllipseOutlineYDown(armR, armRx, armRy, armsRot);
-    glLineWidth(1.0f);
+    b.strokeEllipse(armL, armRx, armRy, armsCos, armsSin, 3.0f, black);
+    b.strokeEllipse(armR, armRx, armRy, armsCos, armsSin, 3.0f, black);
 
     // --- Feet: two distinct feet (left-foot and right-foot), placed at extremes touching circle,
     //     and SWAP which one is forward/back while walking.
@@ -176,26 +207,19 @@ void Renderer::drawPlayer(const Player& player) {
     Vec2 backFoot  = (sw == 0) ? rightFootCenter : leftFootCenter;
     Vec2 frontFoot = (sw == 0) ? leftFootCenter  : rightFootCenter;
 
-    glLineWidth(3.0f);
-    glColor3f(0.0f, 0.0f, 0.0f);
-    drawRectFilled(backFoot, f, footHalfLen, footHalfW);
+    Vec2 quad[4];
+    rectPoints(backFoot, f, footHalfLen, footHalfW, quad);
+    b.fillQuad(quad, black);
 
     // --- Body ---
-    glColor3f(rFill, gFill, bFill);
-    drawCircleFilledYDown(player.pos, R);
+    b.fillCircle(player.pos, R, fill);
+    b.strokeCircle(player.pos, R, 3.0f, black);
 
-    glLineWidth(3.0f);
-    glColor3f(0.0f, 0.0f, 0.0f);
-    drawCircleOutlineYDown(player.pos, R);
-    glLineWidth(1.0f);
-
-    glLineWidth(3.0f);
-    glColor3f(0.0f, 0.0f, 0.0f);
-    drawRectFilled(frontFoot, f, footHalfLen, footHalfW);
-    glLineWidth(1.0f);
+    rectPoints(frontFoot, f, footHalfLen, footHalfW, quad);
+    b.fillQuad(quad, black);
 
     // --- Weapon: anchored at center of right arm ellipse; color matches body (P2 weapon red) ---
-    Vec2 weaponDir = player.armWorldDir();
+    Vec2 weaponDir = pose.armDir;
     Vec2 weaponBase = armR;
 
     float weaponLen = R * 1.45f;
@@ -204,28 +228,25 @@ void Renderer::drawPlayer(const Player& player) {
 
     Vec2 weaponCenter = weaponBase + weaponDir * weaponHalfLen;
 
-    glColor3f(rFill, gFill, bFill);
-    drawRectFilled(weaponCenter, weaponDir, weaponHalfLen, weaponHalfW);
-
-    glLineWidth(3.0f);
-    glColor3f(0.0f, 0.0f, 0.0f);
-    drawRectOutline(weaponCenter, weaponDir, weaponHalfLen, weaponHalfW);
-    glLineWidth(1.0f);
+    rectPoints(weaponCenter, weaponDir, weaponHalfLen, weaponHalfW, quad);
+    b.fillQuad(quad, fill);
+    b.strokeQuad(quad, 3.0f, black);
 }
 
 void Renderer::drawBullet(const Bullet& bullet) {
-    glColor3f(1.0f, 0.9f, 0.2f);
-    drawCircleFilledYDown(bullet.pos, bullet.radius, 24);
-    glColor3f(0.0f, 0.0f, 0.0f);
-    drawCircleOutlineYDown(bullet.pos, bullet.radius, 24);
+    if (!out().viewRect().overlapsCircle(bullet.pos, bullet.radius)) return;
+    out().outlinedCircle(bullet.pos, bullet.radius, rgb(1.0f, 0.9f, 0.2f), rgb(0.0f, 0.0f, 0.0f), 1.0f);
 }
 
 void Renderer::drawHud(const Arena& arena, int livesP1, int livesP2) {
-    float leftX = arena.center.x - arena.radius;
-    float rightX = arena.center.x + arena.radius;
-    float topY = arena.center.y - arena.radius;
-
-    float margin = arena.radius * 0.06f;
+    Rect screen = screenRect(arena);
+    float leftX = screen.minX;
+    float rightX = screen.maxX;
+    float topY = screen.minY;
+
+    // Sizes relative to half the shorter side: the arena radius when it fills the screen.
+    float half = 0.5f * std::min(screen.width(), screen.height());
+    float margin = half * 0.06f;
     float y = topY + margin;
 
     char buf1[32];
@@ -234,17 +255,73 @@ void Renderer::drawHud(const Arena& arena, int livesP1, int livesP2) {
     std::snprintf(buf1, sizeof(buf1), "P1: %d", livesP1);
     std::snprintf(buf2, sizeof(buf2), "P2: %d", livesP2);
 
-    glColor3f(1.0f, 1.0f, 1.0f);
-    drawText(leftX + margin, y, buf1, GLUT_BITMAP_8_BY_13);
-    drawText(rightX - margin - arena.radius * 0.28f, y, buf2, GLUT_BITMAP_8_BY_13);
+    Rgba8 white = rgb(1.0f, 1.0f, 1.0f);
+    out().drawText(leftX + margin, y, buf1, TextFont::SMALL, white);
+    out().drawText(rightX - margin - half * 0.28f, y, buf2, TextFont::SMALL, white);
 }
 
 void Renderer::drawGameOver(const Arena& arena, int winnerId) {
-    float cx = arena.center.x;
-    float cy = arena.center.y;
+    Rect screen = screenRect(arena);
+    float cx = 0.5f * (screen.minX + screen.maxX);
+    float cy = 0.5f * (screen.minY + screen.maxY);
+    float half = 0.5f * std::min(screen.width(), screen.height());
 
-    const char* msg = (winnerId == 1) ? "PLAYER 1 WINS" : "PLAYER 2 WINS";
+    char msg[32];
+    if (winnerId > 0) std::snprintf(msg, sizeof(msg), "PLAYER %d WINS", winnerId);
+    else std::snprintf(msg, sizeof(msg), "DRAW");
 
-    glColor3f(1.0f, 1.0f, 1.0f);
-    drawText(cx - arena.radius * 0.25f, cy, msg, GLUT_BITMAP_HELVETICA_18);
+    out().drawText(cx - half * 0.25f, cy, msg, TextFont::LARGE, rgb(1.0f, 1.0f, 1.0f));
+}
+
+/* ===================== Profiler overlay ===================== */
+
+static std::atomic<bool> gProfileOverlay(false);
+
+// Text is rebuilt from the profiler ring every few frames; summarizing it
+// every frame would show up in the numbers it displays.
+static const int kOverlayRefreshFrames = 30;
+
+void Renderer::setProfileOverlay(bool visible) {
+    gProfileOverlay = visible;
+}
+
+bool Renderer::isProfileOverlay() {
+    return gProfileOverlay;
+}
+
+void Renderer::drawProfileOverlay(const Arena& arena) {
+    static thread_local std::vector<std::string> lines;
+    static thread_local int framesUntilRefresh = 0;
+    if (!gProfileOverlay) return;
+
+    if (--framesUntilRefresh <= 0) {
+        framesUntilRefresh = kOverlayRefreshFrames;
+        std::vector<ProfileZoneStats> stats;
+        Profiler::summarize(stats);
+
+        lines.clear();
+        char buf[96];
+        std::snprintf(buf, sizeof(buf), "%-16s %7s %7s %7s %8s", "zone (us)", "mean", "p50", "p99", "/frame");
+        lines.push_back(buf);
+        for (int z = 0; z < int(ProfileZone::COUNT); ++z) {
+            const ProfileZoneStats& st = stats[size_t(z)];
+            if (st.calls == 0) continue;
+            std::snprintf(buf, sizeof(buf), "%-16s %7.1f %7.1f %7.1f %8.1f", Profiler::zoneName(ProfileZone(z)),
+                          st.meanUs, st.p50Us, st.p99Us, st.perFrameUs);
+            lines.push_back(buf);
+        }
+        if (!Profiler::isEnabled()) lines.push_back("profiler off");
+    }
+
+    RenderBackend& b = out();
+    Rect screen = screenRect(arena);
+    float lineHeight = 15.0f / b.pixelsPerUnit();
+    float margin = 0.5f * std::min(screen.width(), screen.height()) * 0.06f;
+    float x = screen.minX + margin;
+    float y = screen.minY + margin + 2.0f * lineHeight;
+    Rgba8 color = rgb(1.0f, 1.0f, 0.6f);
+    for (const std::string& line : lines) {
+        b.drawText(x, y, line.c_str(), TextFont::SMALL, color);
+        y += lineHeight;
+    }
 }
@@ -0,0 +1,630 @@
+#include "../../include/game/SoftRaster.h"
+#include "../../include/game/BitmapFont.h"
+#include "../../include/util/WorkStealingPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SOFT_RASTER_SSE2 1
+#endif
+
+// Shape parameters, all in pixels (see Shape::p):
+//   CIRCLE        cx, cy, r
+//   RING          cx, cy, r, half width
+//   ELLIPSE       cx, cy, cos, sin, 1/rx^2, 1/ry^2, rx, ry
+//   ELLIPSE_RING  same as ELLIPSE, then half width
+//   POLYGON       four edges as (nx, ny, d): n.p - d is the signed distance
+//                 to the edge line, positive outside
+//   TEXT          left, top, scale; characters in `text` at textOffset
+
+namespace {
+
+const int kTile = 64;
+
+/* ===================== Four-lane floats ===================== */
+
+#ifdef SOFT_RASTER_SSE2
+
+struct F4 {
+    __m128 v;
+};
+
+inline F4 splat(float a) { return { _mm_set1_ps(a) }; }
+inline F4 ramp(float a) { return { _mm_add_ps(_mm_set1_ps(a), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f)) }; }
+inline F4 operator+(F4 a, F4 b) { return { _mm_add_ps(a.v, b.v) }; }
+inline F4 operator-(F4 a, F4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline F4 operator*(F4 a, F4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline F4 operator/(F4 a, F4 b) { return { _mm_div_ps(a.v, b.v) }; }
+inline F4 min4(F4 a, F4 b) { return { _mm_min_ps(a.v, b.v) }; }
+inline F4 max4(F4 a, F4 b) { return { _mm_max_ps(a.v, b.v) }; }
+inline F4 sqrt4(F4 a) { return { _mm_sqrt_ps(a.v) }; }
+inline F4 abs4(F4 a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+inline void store4(float* out, F4 a) { _mm_storeu_ps(out, a.v); }
+
+#else
+
+struct F4 {
+    float v[4];
+};
+
+template <class Op>
+inline F4 lanes(F4 a, F4 b, Op op) {
+    F4 r;
+    for (int i = 0; i < 4; ++i) r.v[i] = op(a.v[i], b.v[i]);
+    return r;
+}
+
+inline F4 splat(float a) { return { { a, a, a, a } }; }
+inline F4 ramp(float a) { return { { a, a + 1.0f, a + 2.0f, a + 3.0f } }; }
+inline F4 operator+(F4 a, F4 b) { return lanes(a, b, [](float x, float y) { return x + y; }); }
+inline F4 operator-(F4 a, F4 b) { return lanes(a, b, [](float x, float y) { return x - y; }); }
+inline F4 operator*(F4 a, F4 b) { return lanes(a, b, [](float x, float y) { return x * y; }); }
+inline F4 operator/(F4 a, F4 b) { return lanes(a, b, [](float x, float y) { return x / y; }); }
+inline F4 min4(F4 a, F4 b) { return lanes(a, b, [](float x, float y) { return std::min(x, y); }); }
+inline F4 max4(F4 a, F4 b) { return lanes(a, b, [](float x, float y) { return std::max(x, y); }); }
+inline F4 sqrt4(F4 a) { return lanes(a, a, [](float x, float) { return std::sqrt(x); }); }
+inline F4 abs4(F4 a) { return lanes(a, a, [](float x, float) { return std::fabs(x); }); }
+inline void store4(float* out, F4 a) { std::memcpy(out, a.v, sizeof(a.v)); }
+
+#endif
+
+// Coverage of a pixel whose center is `d` pixels outside the edge.
+inline F4 coverage(F4 d) {
+    return min4(max4(splat(0.5f) - d, splat(0.0f)), splat(1.0f));
+}
+
+/* ===================== Pixel output ===================== */
+
+inline uint32_t packColor(Rgba8 c) {
+    uint32_t v;
+    std::memcpy(&v, &c, sizeof(v));
+    return v;
+}
+
+// dst = dst + (src - dst) * a, a in [0, 1]; alpha channel included.
+inline uint32_t blendPixel(uint32_t dst, uint32_t src, float a) {
+    int w = int(a * 256.0f + 0.5f);
+    uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        int d = int((dst >> shift) & 0xFFu);
+        int s = int((src >> shift) & 0xFFu);
+        out |= uint32_t(d + (((s - d) * w) >> 8)) << shift;
+    }
+    return out;
+}
+
+// Blends `src` into four consecutive pixels with per-pixel weights `a`.
+inline void blend4(uint32_t* dst, uint32_t src, F4 a) {
+#ifdef SOFT_RASTER_SSE2
+    // 7-bit weights keep (src - dst) * w inside a signed 16-bit lane.
+    __m128i w = _mm_cvtps_epi32(_mm_mul_ps(a.v, _mm_set1_ps(128.0f)));
+    w = _mm_packs_epi32(w, w);
+    w = _mm_unpacklo_epi16(w, w);                     // w0 w0 w1 w1 w2 w2 w3 w3
+    __m128i wLo = _mm_unpacklo_epi32(w, w);           // pixels 0 and 1, per channel
+    __m128i wHi = _mm_unpackhi_epi32(w, w);           // pixels 2 and 3
+
+    const __m128i zero = _mm_setzero_si128();
+    __m128i s = _mm_unpacklo_epi8(_mm_set1_epi32(int(src)), zero);
+    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+    __m128i dLo = _mm_unpacklo_epi8(d, zero);
+    __m128i dHi = _mm_unpackhi_epi8(d, zero);
+    dLo = _mm_add_epi16(dLo, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(s, dLo), wLo), 7));
+    dHi = _mm_add_epi16(dHi, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(s, dHi), wHi), 7));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(dLo, dHi));
+#else
+    for (int i = 0; i < 4; ++i) dst[i] = blendPixel(dst[i], src, a.v[i]);
+#endif
+}
+
+// Pixels [x0, x1) of a row whose coverage is 1.
+void solidRun(uint32_t* row, int x0, int x1, Rgba8 color) {
+    if (x0 >= x1) return;
+    const uint32_t src = packColor(color);
+    if (color.a == 255) {
+        std::fill(row + x0, row + x1, src);
+        return;
+    }
+    const float a = float(color.a) / 255.0f;
+    for (int x = x0; x < x1; ++x) row[x] = blendPixel(row[x], src, a);
+}
+
+// Pixels [x0, x1) of row y, weighted by cov(F4 pixelCentersX, float centerY).
+template <class Cov>
+void aaRun(uint32_t* row, int x0, int x1, float py, Rgba8 color, const Cov& cov) {
+    const uint32_t src = packColor(color);
+    const F4 alpha = splat(float(color.a) / 255.0f);
+    const bool opaque = color.a == 255;
+
+    int x = x0;
+    for (; x + 4 <= x1; x += 4) {
+        F4 a = cov(ramp(float(x) + 0.5f), py) * alpha;
+        alignas(16) float lane[4];
+        store4(lane, a);
+        bool none = lane[0] <= 0.0f && lane[1] <= 0.0f && lane[2] <= 0.0f && lane[3] <= 0.0f;
+        if (none) continue;
+        bool full = lane[0] >= 1.0f && lane[1] >= 1.0f && lane[2] >= 1.0f && lane[3] >= 1.0f;
+        if (full && opaque) {
+            row[x] = row[x + 1] = row[x + 2] = row[x + 3] = src;
+            continue;
+        }
+        blend4(row + x, src, a);
+    }
+    if (x < x1) {
+        alignas(16) float lane[4];
+        store4(lane, cov(ramp(float(x) + 0.5f), py) * alpha);
+        for (int i = 0; x + i < x1; ++i) {
+            if (lane[i] > 0.0f) row[x + i] = blendPixel(row[x + i], src, std::min(lane[i], 1.0f));
+        }
+    }
+}
+
+// Pixel columns whose centers lie in [lo, hi], as [first, end).
+inline void centerSpan(float lo, float hi, int& first, int& end) {
+    first = int(std::ceil(lo - 0.5f));
+    end = int(std::floor(hi - 0.5f)) + 1;
+}
+
+// Columns whose centers are within `radius` of cx on the row `dy` away;
+// empty when the row misses the circle.
+inline bool circleSpan(float cx, float dy, float radius, int& first, int& end) {
+    if (radius <= 0.0f || dy * dy >= radius * radius) return false;
+    float half = std::sqrt(radius * radius - dy * dy);
+    centerSpan(cx - half, cx + half, first, end);
+    return first < end;
+}
+
+} // namespace
+
+/* ===================== Setup ===================== */
+
+SoftRaster::SoftRaster()
+    : w(0), h(0), backgroundValid(false),
+      viewX(0.0f), viewY(0.0f), scale(1.0f),
+      base(Base::CLEAR), clearColor{ 0, 0, 0, 255 },
+      tilesX(0), tilesY(0),
+      threadCount(1),
+      lastMs(0.0) {}
+
+SoftRaster::~SoftRaster() = default;
+
+bool SoftRaster::resize(int width, int height) {
+    if (width < 1 || height < 1 || width > 16384 || height > 16384) return false;
+    w = width;
+    h = height;
+    frame.assign(size_t(w) * size_t(h), packColor(clearColor));
+    background.clear();
+    backgroundValid = false;
+    tilesX = (w + kTile - 1) / kTile;
+    tilesY = (h + kTile - 1) / kTile;
+    bins.assign(size_t(tilesX) * size_t(tilesY), std::vector<int>());
+    return true;
+}
+
+int SoftRaster::width() const { return w; }
+int SoftRaster::height() const { return h; }
+const uint32_t* SoftRaster::pixels() const { return frame.data(); }
+
+void SoftRaster::setView(float originX, float originY, float pixelsPerUnit) {
+    viewX = originX;
+    viewY = originY;
+    scale = (pixelsPerUnit > 0.0f) ? pixelsPerUnit : 1.0f;
+    backgroundValid = false;
+    RenderBackend::setPixelsPerUnit(scale);
+}
+
+// Keeps the view origin; fitView also recenters.
+void SoftRaster::setPixelsPerUnit(float pixelsPerUnit) {
+    setView(viewX, viewY, pixelsPerUnit);
+}
+
+float SoftRaster::fitView(const Vec2& center, float halfExtent) {
+    float s = float(std::min(w, h)) / (2.0f * std::max(halfExtent, 1e-6f));
+    setView(center.x - 0.5f * float(w) / s, center.y - 0.5f * float(h) / s, s);
+    return scale;
+}
+
+void SoftRaster::setThreads(int n) {
+    if (n <= 0) n = std::max(1, int(std::thread::hardware_concurrency()));
+    if (n == threadCount && (n == 1 || pool)) return;
+    threadCount = n;
+    pool.reset(n > 1 ? new WorkStealingPool(n) : nullptr);
+}
+
+int SoftRaster::threads() const { return threadCount; }
+
+/* ===================== Frame ===================== */
+
+void SoftRaster::setClearColor(Rgba8 clear) {
+    clearColor = clear;
+}
+
+void SoftRaster::beginFrame() {
+    shapes.clear();
+    text.clear();
+    base = Base::CLEAR;
+    stats = RenderStats();
+}
+
+void SoftRaster::endFrame() {
+    finish();
+}
+
+void SoftRaster::captureBackground() {
+    finish();
+    background = frame;
+    backgroundValid = true;
+}
+
+bool SoftRaster::hasBackground() const { return backgroundValid; }
+
+void SoftRaster::restoreBackground() {
+    shapes.clear();
+    text.clear();
+    base = backgroundValid ? Base::BACKGROUND : Base::CLEAR;
+}
+
+// The rasterizer's equivalent of a display list is a saved image of the frame
+// right after the static geometry.
+bool SoftRaster::beginStaticLayer(unsigned version) {
+    if (!staticLayerStale(version) && backgroundValid) {
+        restoreBackground();
+        return false;
+    }
+    return true;
+}
+
+void SoftRaster::endStaticLayer() {
+    captureBackground();
+    staticLayerRecorded();
+}
+
+bool SoftRaster::addShape(Shape& s, float minX, float minY, float maxX, float maxY) {
+    s.x0 = std::max(0, int(std::floor(minX)));
+    s.y0 = std::max(0, int(std::floor(minY)));
+    s.x1 = std::min(w, int(std::ceil(maxX)) + 1);
+    s.y1 = std::min(h, int(std::ceil(maxY)) + 1);
+    if (s.x0 >= s.x1 || s.y0 >= s.y1 || s.color.a == 0) return false;
+    shapes.push_back(s);
+    return true;
+}
+
+void SoftRaster::fillCircle(const Vec2& c, float r, Rgba8 color) {
+    ++stats.primitives;
+    Shape s{};
+    s.kind = Kind::CIRCLE;
+    s.color = color;
+    s.p[0] = (c.x - viewX) * scale;
+    s.p[1] = (c.y - viewY) * scale;
+    s.p[2] = r * scale;
+    float e = s.p[2] + 1.0f;
+    addShape(s, s.p[0] - e, s.p[1] - e, s.p[0] + e, s.p[1] + e);
+}
+
+void SoftRaster::strokeCircle(const Vec2& c, float r, float widthPx, Rgba8 color) {
+    ++stats.primitives;
+    Shape s{};
+    s.kind = Kind::RING;
+    s.color = color;
+    s.p[0] = (c.x - viewX) * scale;
+    s.p[1] = (c.y - viewY) * scale;
+    s.p[2] = r * scale;
+    s.p[3] = 0.5f * widthPx;
+    float e = s.p[2] + s.p[3] + 1.0f;
+    addShape(s, s.p[0] - e, s.p[1] - e, s.p[0] + e, s.p[1] + e);
+}
+
+void SoftRaster::fillEllipse(const Vec2& c, float rx, float ry, float cr, float sr, Rgba8 color) {
+    strokeEllipse(c, rx, ry, cr, sr, -1.0f, color);
+}
+
+// A negative width marks a fill.
+void SoftRaster::strokeEllipse(const Vec2& c, float rx, float ry, float cr, float sr, float widthPx, Rgba8 color) {
+    ++stats.primitives;
+    Shape s{};
+    s.kind = (widthPx < 0.0f) ? Kind::ELLIPSE : Kind::ELLIPSE_RING;
+    s.color = color;
+    float ax = std::max(rx * scale, 1e-3f);
+    float ay = std::max(ry * scale, 1e-3f);
+    s.p[0] = (c.x - viewX) * scale;
+    s.p[1] = (c.y - viewY) * scale;
+    s.p[2] = cr;
+    s.p[3] = sr;
+    s.p[4] = 1.0f / (ax * ax);
+    s.p[5] = 1.0f / (ay * ay);
+    s.p[6] = ax;
+    s.p[7] = ay;
+    s.p[8] = std::max(0.5f * widthPx, 0.0f);
+    float ex = std::sqrt(ax * ax * cr * cr + ay * ay * sr * sr) + s.p[8] + 1.0f;
+    float ey = std::sqrt(ax * ax * sr * sr + ay * ay * cr * cr) + s.p[8] + 1.0f;
+    addShape(s, s.p[0] - ex, s.p[1] - ey, s.p[0] + ex, s.p[1] + ey);
+}
+
+void SoftRaster::addPolygon(const Vec2* px, int n, Rgba8 color) {
+    Shape s{};
+    s.kind = Kind::POLYGON;
+    s.color = color;
+
+    float area = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        const Vec2& a = px[i];
+        const Vec2& b = px[(i + 1) % n];
+        area += a.x * b.y - b.x * a.y;
+    }
+    if (std::fabs(area) < 1e-6f) return;
+    // Outward normal of edge a->b: (dy, -dx) for a positive (Y-down) area.
+    float sign = (area > 0.0f) ? 1.0f : -1.0f;
+
+    float minX = px[0].x, maxX = px[0].x, minY = px[0].y, maxY = px[0].y;
+    for (int i = 0; i < 4; ++i) {
+        const Vec2& a = px[i % n];
+        const Vec2& b = px[(i + 1) % n];
+        float nx = (b.y - a.y) * sign;
+        float ny = -(b.x - a.x) * sign;
+        float len = std::sqrt(nx * nx + ny * ny);
+        if (len < 1e-6f) {
+            // Repeated vertex: a plane that never clips.
+            s.p[3 * i] = 0.0f;
+            s.p[3 * i + 1] = 0.0f;
+            s.p[3 * i + 2] = 1e30f;
+            continue;
+        }
+        nx /= len;
+        ny /= len;
+        s.p[3 * i] = nx;
+        s.p[3 * i + 1] = ny;
+        s.p[3 * i + 2] = nx * a.x + ny * a.y;
+        minX = std::min(minX, a.x); maxX = std::max(maxX, a.x);
+        minY = std::min(minY, a.y); maxY = std::max(maxY, a.y);
+    }
+    addShape(s, minX - 1.0f, minY - 1.0f, maxX + 1.0f, maxY + 1.0f);
+}
+
+void SoftRaster::fillQuad(const Vec2 p[4], Rgba8 color) {
+    ++stats.primitives;
+    Vec2 px[4];
+    for (int i = 0; i < 4; ++i) px[i] = Vec2((p[i].x - viewX) * scale, (p[i].y - viewY) * scale);
+    addPolygon(px, 4, color);
+}
+
+// One band per edge, extended by half the width so corners close (the same
+// geometry as the batched GL outline).
+void SoftRaster::strokeQuad(const Vec2 p[4], float widthPx, Rgba8 color) {
+    ++stats.primitives;
+    float hw = 0.5f * widthPx;
+    for (int i = 0; i < 4; ++i) {
+        Vec2 a((p[i].x - viewX) * scale, (p[i].y - viewY) * scale);
+        Vec2 b((p[(i + 1) % 4].x - viewX) * scale, (p[(i + 1) % 4].y - viewY) * scale);
+        Vec2 d = (b - a).normalized() * hw;
+        Vec2 n(-d.y, d.x);
+        Vec2 band[4] = { a - d - n, b + d - n, b + d + n, a - d + n };
+        addPolygon(band, 4, color);
+    }
+}
+
+void SoftRaster::drawText(float x, float y, const char* str, TextFont font, Rgba8 color) {
+    ++stats.primitives;
+    int len = int(std::strlen(str));
+    if (len == 0) return;
+    int glyphScale = BitmapFont::scaleFor(font);
+
+    Shape s{};
+    s.kind = Kind::TEXT;
+    s.color = color;
+    s.p[0] = std::floor((x - viewX) * scale + 0.5f);
+    s.p[1] = std::floor((y - viewY) * scale + 0.5f) - float(BitmapFont::kRows * glyphScale);
+    s.p[2] = float(glyphScale);
+    s.textOffset = int(text.size());
+    s.textLength = len;
+    float right = s.p[0] + float(len * BitmapFont::kAdvance * glyphScale);
+    float bottom = s.p[1] + float(BitmapFont::kRows * glyphScale);
+    if (addShape(s, s.p[0], s.p[1], right - 1.0f, bottom - 1.0f)) text.insert(text.end(), str, str + len);
+}
+
+/* ===================== Rasterization ===================== */
+
+void SoftRaster::rasterRow(const Shape& s, int y, int xa, int xb, uint32_t* row) const {
+    const float* p = s.p;
+    const float py = float(y) + 0.5f;
+
+    switch (s.kind) {
+        case Kind::CIRCLE: {
+            const float cx = p[0], dy = py - p[1], r = p[2];
+            int first, end;
+            if (!circleSpan(cx, dy, r + 0.5f, first, end)) return;
+            first = std::max(first, xa);
+            end = std::min(end, xb);
+
+            int solidFirst = end, solidEnd = end;
+            if (circleSpan(cx, dy, r - 0.5f, solidFirst, solidEnd)) {
+                solidFirst = std::min(std::max(solidFirst, first), end);
+                solidEnd = std::min(std::max(solidEnd, solidFirst), end);
+            } else {
+                solidFirst = solidEnd = end;
+            }
+            auto cov = [&](F4 x, float) {
+                F4 dx = x - splat(cx);
+                return coverage(sqrt4(dx * dx + splat(dy * dy)) - splat(r));
+            };
+            aaRun(row, first, solidFirst, py, s.color, cov);
+            solidRun(row, solidFirst, solidEnd, s.color);
+            aaRun(row, solidEnd, end, py, s.color, cov);
+            return;
+        }
+        case Kind::RING: {
+            const float cx = p[0], dy = py - p[1], r = p[2], hw = p[3];
+            int first, end;
+            if (!circleSpan(cx, dy, r + hw + 0.5f, first, end)) return;
+            first = std::max(first, xa);
+            end = std::min(end, xb);
+
+            // Columns inside the hole get no coverage at all.
+            int holeFirst = end, holeEnd = end;
+            if (circleSpan(cx, dy, r - hw - 0.5f, holeFirst, holeEnd)) {
+                holeFirst = std::min(std::max(holeFirst, first), end);
+                holeEnd = std::min(std::max(holeEnd, holeFirst), end);
+            } else {
+                holeFirst = holeEnd = end;
+            }
+            auto cov = [&](F4 x, float) {
+                F4 dx = x - splat(cx);
+                return coverage(abs4(sqrt4(dx * dx + splat(dy * dy)) - splat(r)) - splat(hw));
+            };
+            aaRun(row, first, holeFirst, py, s.color, cov);
+            aaRun(row, holeEnd, end, py, s.color, cov);
+            return;
+        }
+        case Kind::ELLIPSE:
+        case Kind::ELLIPSE_RING: {
+            const float cx = p[0], qy = py - p[1], cr = p[2], sr = p[3];
+            const float irx2 = p[4], iry2 = p[5], hw = p[8];
+            const bool ring = s.kind == Kind::ELLIPSE_RING;
+
+            // Row span of the ellipse grown by the ramp: the quadratic in qx
+            // of (lx / a)^2 + (ly / b)^2 <= 1.
+            float a = p[6] + hw + 1.0f, b = p[7] + hw + 1.0f;
+            float ia2 = 1.0f / (a * a), ib2 = 1.0f / (b * b);
+            float A = cr * cr * ia2 + sr * sr * ib2;
+            float B = 2.0f * qy * cr * sr * (ia2 - ib2);
+            float C = qy * qy * (sr * sr * ia2 + cr * cr * ib2) - 1.0f;
+            float disc = B * B - 4.0f * A * C;
+            if (disc < 0.0f) return;
+            float root = std::sqrt(disc);
+            int first, end;
+            centerSpan(cx + (-B - root) / (2.0f * A), cx + (-B + root) / (2.0f * A), first, end);
+            first = std::max(first, xa);
+            end = std::min(end, xb);
+
+            // Distance estimate F / |grad F| of F = (lx/rx)^2 + (ly/ry)^2 - 1.
+            auto cov = [&](F4 x, float) {
+                F4 qx = x - splat(cx);
+                F4 lx = qx * splat(cr) + splat(qy * sr);
+                F4 ly = splat(qy * cr) - qx * splat(sr);
+                F4 gx = lx * splat(irx2);
+                F4 gy = ly * splat(iry2);
+                F4 f = lx * gx + ly * gy - splat(1.0f);
+                F4 g = max4(splat(2.0f) * sqrt4(gx * gx + gy * gy), splat(1e-6f));
+                F4 d = f / g;
+                if (ring) d = abs4(d) - splat(hw);
+                return coverage(d);
+            };
+            aaRun(row, first, end, py, s.color, cov);
+            return;
+        }
+        case Kind::POLYGON: {
+            // Intersect the four half-planes along the row, once for any
+            // coverage (distance < 0.5) and once for full coverage (<= -0.5).
+            float lo = float(xa), hi = float(xb), solidLo = lo, solidHi = hi;
+            for (int i = 0; i < 4; ++i) {
+                float nx = p[3 * i], k = p[3 * i + 1] * py - p[3 * i + 2];
+                if (nx > 1e-6f) {
+                    hi = std::min(hi, (0.5f - k) / nx);
+                    solidHi = std::min(solidHi, (-0.5f - k) / nx);
+                } else if (nx < -1e-6f) {
+                    lo = std::max(lo, (0.5f - k) / nx);
+                    solidLo = std::max(solidLo, (-0.5f - k) / nx);
+                } else {
+                    if (k >= 0.5f) return;
+                    if (k > -0.5f) solidHi = solidLo - 1.0f;
+                }
+            }
+            int first, end;
+            centerSpan(lo, hi, first, end);
+            first = std::max(first, xa);
+            end = std::min(end, xb);
+            if (first >= end) return;
+
+            int solidFirst = end, solidEnd = end;
+            if (solidLo <= solidHi) {
+                centerSpan(solidLo, solidHi, solidFirst, solidEnd);
+                solidFirst = std::min(std::max(solidFirst, first), end);
+                solidEnd = std::min(std::max(solidEnd, solidFirst), end);
+            }
+            auto cov = [&](F4 x, float y) {
+                F4 d = x * splat(p[0]) + splat(p[1] * y - p[2]);
+                for (int i = 1; i < 4; ++i) d = max4(d, x * splat(p[3 * i]) + splat(p[3 * i + 1] * y - p[3 * i + 2]));
+                return coverage(d);
+            };
+            aaRun(row, first, solidFirst, py, s.color, cov);
+            solidRun(row, solidFirst, solidEnd, s.color);
+            aaRun(row, solidEnd, end, py, s.color, cov);
+            return;
+        }
+        case Kind::TEXT: {
+            const int left = int(p[0]);
+            const int glyphScale = int(p[2]);
+            const int glyphRow = (y - int(p[1])) / glyphScale;
+            const int cell = BitmapFont::kAdvance * glyphScale;
+            const char* str = text.data() + s.textOffset;
+            const int c0 = std::max(0, (xa - left) / cell);
+            const int c1 = std::min(s.textLength, (xb - left + cell - 1) / cell);
+            for (int i = c0; i < c1; ++i) {
+                const uint8_t* glyph = BitmapFont::glyph(str[i]);
+                for (int col = 0; col < BitmapFont::kColumns; ++col) {
+                    if (!(glyph[col] & (1u << glyphRow))) continue;
+                    int x0 = left + i * cell + col * glyphScale;
+                    solidRun(row, std::max(x0, xa), std::min(x0 + glyphScale, xb), s.color);
+                }
+            }
+            return;
+        }
+    }
+}
+
+void SoftRaster::renderTile(int tile) {
+    const int tx0 = (tile % tilesX) * kTile;
+    const int ty0 = (tile / tilesX) * kTile;
+    const int tx1 = std::min(tx0 + kTile, w);
+    const int ty1 = std::min(ty0 + kTile, h);
+
+    const uint32_t clear = packColor(clearColor);
+    for (int y = ty0; y < ty1; ++y) {
+        uint32_t* row = frame.data() + size_t(y) * size_t(w);
+        if (base == Base::BACKGROUND) {
+            const uint32_t* src = background.data() + size_t(y) * size_t(w);
+            std::copy(src + tx0, src + tx1, row + tx0);
+        } else if (base == Base::CLEAR) {
+            std::fill(row + tx0, row + tx1, clear);
+        }
+    }
+
+    for (int i : bins[size_t(tile)]) {
+        const Shape& s = shapes[size_t(i)];
+        const int xa = std::max(s.x0, tx0), xb = std::min(s.x1, tx1);
+        const int y0 = std::max(s.y0, ty0), y1 = std::min(s.y1, ty1);
+        for (int y = y0; y < y1; ++y) rasterRow(s, y, xa, xb, frame.data() + size_t(y) * size_t(w));
+    }
+}
+
+void SoftRaster::finish() {
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (std::vector<int>& bin : bins) bin.clear();
+    for (int i = 0; i < int(shapes.size()); ++i) {
+        const Shape& s = shapes[size_t(i)];
+        for (int ty = s.y0 / kTile; ty <= (s.y1 - 1) / kTile; ++ty) {
+            for (int tx = s.x0 / kTile; tx <= (s.x1 - 1) / kTile; ++tx) bins[size_t(ty * tilesX + tx)].push_back(i);
+        }
+    }
+
+    const int tiles = tilesX * tilesY;
+    if (pool) {
+        pool->parallelFor(tiles, [this](int t) { renderTile(t); });
+    } else {
+        for (int t = 0; t < tiles; ++t) renderTile(t);
+    }
+
+    stats.drawCalls += long(shapes.size());
+    lastMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    // The framebuffer now holds everything; later draws in this frame stack on top.
+    shapes.clear();
+    text.clear();
+    base = Base::KEEP;
+}
+
+double SoftRaster::millisecondsLastFrame() const { return lastMs; }
@@ -0,0 +1,296 @@
+#include "../../include/io/ArenaGenerator.h"
+#include "../../include/util/Hash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const float kPi = 3.14159265358979f;
+
+const float kHeadRadius = 20.0f;
+const float kMinRadius = 8.0f;
+const float kMaxRadius = 24.0f;
+const float kMinArenaRadius = 300.0f;
+const float kEdgeMargin = 5.0f;
+
+// Free space kept around each spawn point (beyond the obstacle's radius).
+const float kSpawnClear = 3.0f * kHeadRadius;
+
+// Disk area per obstacle for the scattered layouts: ~15% coverage.
+const float kAreaPerObstacle = 5800.0f;
+
+const float kRingSpacing = 160.0f;
+const float kRingJitter = 8.0f;
+
+const float kLaneWidth = 160.0f;
+const float kWallSpacing = 14.0f;
+const float kWallMinRadius = 10.0f;
+const float kWallMaxRadius = 16.0f;
+
+// Doorways: open spans kept in ring and corridor walls so players can cross.
+const float kDoorWidth = 100.0f;
+const float kDoorEvery = 640.0f;
+
+// xorshift64*: cheap and identical on every platform.
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : state(seed ? seed : 1ull) {}
+
+    uint32_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return uint32_t((state * 0x2545f4914f6cdd1dull) >> 32);
+    }
+
+    float uniform() { return float(next() >> 8) * (1.0f / 16777216.0f); }
+    float range(float lo, float hi) { return lo + (hi - lo) * uniform(); }
+
+    // Box-Muller; one value per call keeps the sequence simple.
+    float gaussian() {
+        float u = std::max(uniform(), 1e-7f);
+        return std::sqrt(-2.0f * std::log(u)) * std::cos(2.0f * kPi * uniform());
+    }
+
+private:
+    uint64_t state;
+};
+
+struct Layout {
+    Vec2 center;
+    float radius;
+    Vec2 spawn[2];
+};
+
+float scatteredArenaRadius(long long n) {
+    return std::max(kMinArenaRadius, std::sqrt(float(n) * kAreaPerObstacle / kPi));
+}
+
+Layout makeLayout(float radius, float spawnOffset) {
+    Layout l;
+    float pad = 10.0f;
+    l.center = Vec2(radius + pad, radius + pad);
+    l.radius = radius;
+    l.spawn[0] = Vec2(l.center.x - spawnOffset, l.center.y);
+    l.spawn[1] = Vec2(l.center.x + spawnOffset, l.center.y);
+    return l;
+}
+
+bool blocksSpawn(const Layout& l, const Vec2& p, float r) {
+    for (const Vec2& s : l.spawn) {
+        float reach = r + kSpawnClear;
+        if ((p - s).lengthSq() < reach * reach) return true;
+    }
+    return false;
+}
+
+// Obstacles for the part [before, after) of `total` length, so rounding never
+// changes the overall count.
+long long share(long long n, double before, double after, double total) {
+    return std::llround(double(n) * after / total) - std::llround(double(n) * before / total);
+}
+
+/* ===================== Layouts ===================== */
+
+Layout uniform(long long n, Rng& rng, std::vector<Obstacle>& out) {
+    float R = scatteredArenaRadius(n);
+    Layout l = makeLayout(R, 0.45f * R);
+    for (long long i = 0; i < n; ++i) {
+        for (;;) {
+            float r = rng.range(kMinRadius, kMaxRadius);
+            float d = (R - r - kEdgeMargin) * std::sqrt(rng.uniform());
+            float a = 2.0f * kPi * rng.uniform();
+            Vec2 p(l.center.x + d * std::cos(a), l.center.y + d * std::sin(a));
+            if (blocksSpawn(l, p, r)) continue;
+            out.emplace_back(p, r);
+            break;
+        }
+    }
+    return l;
+}
+
+// One clump per ~1000 obstacles; each spreads over a quarter of its fair
+// share of the disk, so obstacles are ~4x denser there than in UNIFORM.
+Layout clustered(long long n, Rng& rng, std::vector<Obstacle>& out) {
+    float R = scatteredArenaRadius(n);
+    Layout l = makeLayout(R, 0.45f * R);
+
+    long long k = std::max(4LL, n / 1000);
+    float sigma = 0.25f * R / std::sqrt(float(k));
+    std::vector<Vec2> centers;
+    centers.reserve(size_t(k));
+    for (long long i = 0; i < k; ++i) {
+        float d = std::max(R - 2.0f * sigma, 0.0f) * std::sqrt(rng.uniform());
+        float a = 2.0f * kPi * rng.uniform();
+        centers.emplace_back(l.center.x + d * std::cos(a), l.center.y + d * std::sin(a));
+    }
+
+    for (long long i = 0; i < n; ++i) {
+        const Vec2& c = centers[size_t(i % k)];
+        for (;;) {
+            float r = rng.range(kMinRadius, kMaxRadius);
+            Vec2 p(c.x + sigma * rng.gaussian(), c.y + sigma * rng.gaussian());
+            float reach = R - r - kEdgeMargin;
+            if ((p - l.center).lengthSq() > reach * reach || blocksSpawn(l, p, r)) continue;
+            out.emplace_back(p, r);
+            break;
+        }
+    }
+    return l;
+}
+
+// Rings every ~kRingSpacing, each holding obstacles in proportion to its
+// length. Doorways at angles 0 and pi line up into a corridor along the
+// horizontal axis, where the players start.
+Layout ring(long long n, Rng& rng, std::vector<Obstacle>& out) {
+    float R = scatteredArenaRadius(n);
+    Layout l = makeLayout(R, 0.45f * R);
+
+    float inner = R - kMaxRadius - kRingJitter - kEdgeMargin;
+    int rings = std::max(1, int(R / kRingSpacing) - 1);
+
+    std::vector<float> radii(rings), halfDoor(rings);
+    double total = 0.0;
+    for (int j = 0; j < rings; ++j) {
+        radii[j] = inner * float(j + 1) / float(rings + 1);
+        halfDoor[j] = std::min(0.5f * kDoorWidth / radii[j] + kSpawnClear / radii[j], 0.25f * kPi);
+        total += double(radii[j]) * double(2.0f * kPi - 4.0f * halfDoor[j]);
+    }
+
+    double done = 0.0;
+    for (int j = 0; j < rings; ++j) {
+        float rho = radii[j];
+        float h = halfDoor[j];
+        float usable = 2.0f * kPi - 4.0f * h;
+        double len = double(rho) * double(usable);
+        long long m = share(n, done, done + len, total);
+        done += len;
+
+        for (long long i = 0; i < m; ++i) {
+            float t = usable * (float(i) + rng.range(0.2f, 0.8f)) / float(m);
+            float a = (t < 0.5f * usable) ? h + t : kPi + h + (t - 0.5f * usable);
+            float d = rho + rng.range(-kRingJitter, kRingJitter);
+            out.emplace_back(Vec2(l.center.x + d * std::cos(a), l.center.y + d * std::sin(a)),
+                             rng.range(kMinRadius, kMaxRadius));
+        }
+    }
+    return l;
+}
+
+// Horizontal walls kLaneWidth apart with overlapping obstacles, broken by a
+// doorway every ~kDoorEvery. The players start in the central lane.
+Layout corridor(long long n, Rng& rng, std::vector<Obstacle>& out) {
+    float R = std::max(kMinArenaRadius, std::sqrt(float(n) * kWallSpacing * kLaneWidth / kPi));
+    Layout l = makeLayout(R, 0.45f * R);
+    float inner = R - kWallMaxRadius - kEdgeMargin;
+
+    struct Span { float y, x0, x1; };
+    std::vector<Span> spans;
+    double total = 0.0;
+    for (int k = 0; (float(k) + 0.5f) * kLaneWidth < inner; ++k) {
+        for (int side = -1; side <= 1; side += 2) {
+            float dy = float(side) * (float(k) + 0.5f) * kLaneWidth;
+            float hx = std::sqrt(inner * inner - dy * dy);
+            float x = -hx;
+            float door = -hx + rng.range(0.0f, kDoorEvery);
+            while (x < hx) {
+                float end = std::min(door, hx);
+                if (end > x) {
+                    spans.push_back({ l.center.y + dy, l.center.x + x, l.center.x + end });
+                    total += double(end - x);
+                }
+                x = door + kDoorWidth;
+                door += kDoorEvery;
+            }
+        }
+    }
+
+    double done = 0.0;
+    for (const Span& s : spans) {
+        double len = double(s.x1 - s.x0);
+        long long m = share(n, done, done + len, total);
+        done += len;
+        for (long long i = 0; i < m; ++i) {
+            float x = s.x0 + (s.x1 - s.x0) * (float(i) + rng.range(0.3f, 0.7f)) / float(m);
+            out.emplace_back(Vec2(x, s.y + rng.range(-2.0f, 2.0f)), rng.range(kWallMinRadius, kWallMaxRadius));
+        }
+    }
+    return l;
+}
+
+} // namespace
+
+/* ===================== Generation ===================== */
+
+ArenaGenParams::ArenaGenParams() : layout(ArenaLayout::UNIFORM), obstacles(1000), seed(1) {}
+
+void ArenaGenerator::generate(const ArenaGenParams& params, SvgSceneData& out) {
+    out = SvgSceneData();
+    long long n = std::max(0LL, params.obstacles);
+    out.obstacles.reserve(size_t(n));
+
+    // Each layout draws from its own stream, so they differ even with one seed.
+    uint64_t h = Hash::value(params.seed, Hash::kSeed);
+    h = Hash::value(int(params.layout), h);
+    Rng rng(h);
+
+    Layout l;
+    switch (params.layout) {
+    case ArenaLayout::CLUSTERED: l = clustered(n, rng, out.obstacles); break;
+    case ArenaLayout::RING:      l = ring(n, rng, out.obstacles); break;
+    case ArenaLayout::CORRIDOR:  l = corridor(n, rng, out.obstacles); break;
+    default:                     l = uniform(n, rng, out.obstacles); break;
+    }
+
+    out.arena.center = l.center;
+    out.arena.radius = l.radius;
+    out.hasArena = true;
+    out.player1Pos = l.spawn[0];
+    out.player2Pos = l.spawn[1];
+    out.player1HeadRadius = kHeadRadius;
+    out.player2HeadRadius = kHeadRadius;
+    out.hasPlayer1 = true;
+    out.hasPlayer2 = true;
+}
+
+bool ArenaGenerator::writeSvg(const std::string& path, const SvgSceneData& scene) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    const Arena& a = scene.arena;
+    float size = 2.0f * (a.center.x > a.center.y ? a.center.x : a.center.y);
+    std::fprintf(f, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    std::fprintf(f, "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\"%.0f\" height=\"%.0f\">\n", size, size);
+    std::fprintf(f, "  <circle cx=\"%.2f\" cy=\"%.2f\" r=\"%.2f\" fill=\"blue\" />\n", a.center.x, a.center.y, a.radius);
+    std::fprintf(f, "  <circle cx=\"%.2f\" cy=\"%.2f\" r=\"%.2f\" fill=\"green\" />\n",
+                 scene.player1Pos.x, scene.player1Pos.y, scene.player1HeadRadius);
+    std::fprintf(f, "  <circle cx=\"%.2f\" cy=\"%.2f\" r=\"%.2f\" fill=\"red\" />\n",
+                 scene.player2Pos.x, scene.player2Pos.y, scene.player2HeadRadius);
+    for (const Obstacle& o : scene.obstacles) {
+        std::fprintf(f, "  <circle cx=\"%.2f\" cy=\"%.2f\" r=\"%.2f\" fill=\"black\" />\n", o.pos.x, o.pos.y, o.radius);
+    }
+    std::fprintf(f, "</svg>\n");
+    return std::fclose(f) == 0;
+}
+
+/* ===================== Layout names ===================== */
+
+static const char* const kLayoutNames[ArenaGenerator::kLayoutCount] = { "uniform", "clustered", "ring", "corridor" };
+
+const char* ArenaGenerator::layoutName(ArenaLayout layout) {
+    int i = int(layout);
+    return (i >= 0 && i < kLayoutCount) ? kLayoutNames[i] : "?";
+}
+
+bool ArenaGenerator::parseLayout(const std::string& name, ArenaLayout& out) {
+    for (int i = 0; i < kLayoutCount; ++i) {
+        if (name == kLayoutNames[i]) {
+            out = ArenaLayout(i);
+            return true;
+        }
+    }
+    return false;
+}
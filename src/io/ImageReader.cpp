@@ -0,0 +1,390 @@
+#include "../../include/io/ImageReader.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+bool readFile(const std::string& path, std::vector<uint8_t>& bytes) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    bytes.clear();
+    uint8_t buf[65536];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) bytes.insert(bytes.end(), buf, buf + n);
+    bool ok = !std::ferror(f);
+    std::fclose(f);
+    return ok;
+}
+
+inline uint32_t packRgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    uint8_t px[4] = { r, g, b, a };
+    uint32_t v;
+    std::memcpy(&v, px, 4);
+    return v;
+}
+
+uint32_t readBigEndian(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+/* ===================== Inflate ===================== */
+
+// Canonical Huffman decoding as in RFC 1951: counts per code length plus the
+// symbols sorted by code.
+struct Huffman {
+    uint16_t count[16];
+    uint16_t symbol[288];
+
+    bool build(const uint8_t* lengths, int n) {
+        std::memset(count, 0, sizeof(count));
+        for (int i = 0; i < n; ++i) ++count[lengths[i]];
+        count[0] = 0;
+        int left = 1;
+        for (int len = 1; len < 16; ++len) {
+            left = left * 2 - count[len];
+            if (left < 0) return false;   // over-subscribed
+        }
+        uint16_t offs[16];
+        offs[1] = 0;
+        for (int len = 1; len < 15; ++len) offs[len + 1] = uint16_t(offs[len] + count[len]);
+        for (int i = 0; i < n; ++i) {
+            if (lengths[i]) symbol[offs[lengths[i]]++] = uint16_t(i);
+        }
+        return true;
+    }
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* p, size_t n) : p(p), n(n), pos(0), acc(0), bits(0) {}
+
+    // `count` bits, least significant first; false past the end.
+    bool get(int count, uint32_t& v) {
+        while (bits < count) {
+            if (pos >= n) return false;
+            acc |= uint32_t(p[pos++]) << bits;
+            bits += 8;
+        }
+        v = acc & ((count == 32) ? 0xFFFFFFFFu : ((1u << count) - 1u));
+        acc = (count == 32) ? 0 : (acc >> count);
+        bits -= count;
+        return true;
+    }
+
+    bool decode(const Huffman& h, int& sym) {
+        int code = 0, first = 0, index = 0;
+        for (int len = 1; len < 16; ++len) {
+            uint32_t b;
+            if (!get(1, b)) return false;
+            code |= int(b);
+            int count = h.count[len];
+            if (code - first < count) {
+                sym = h.symbol[index + (code - first)];
+                return true;
+            }
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        return false;
+    }
+
+    void alignToByte() {
+        acc = 0;
+        bits = 0;
+    }
+
+    const uint8_t* p;
+    size_t n;
+    size_t pos;
+
+private:
+    uint32_t acc;
+    int bits;
+};
+
+const uint16_t kLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                   35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const uint8_t kLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const uint16_t kDistBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+                                 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+const uint8_t kDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+bool inflateCodes(BitReader& in, const Huffman& lit, const Huffman& dist, std::vector<uint8_t>& out) {
+    for (;;) {
+        int sym;
+        if (!in.decode(lit, sym)) return false;
+        if (sym < 256) {
+            out.push_back(uint8_t(sym));
+            continue;
+        }
+        if (sym == 256) return true;
+        sym -= 257;
+        if (sym >= 29) return false;
+        uint32_t extra;
+        if (!in.get(kLengthExtra[sym], extra)) return false;
+        size_t len = kLengthBase[sym] + extra;
+        int d;
+        if (!in.decode(dist, d) || d >= 30) return false;
+        if (!in.get(kDistExtra[d], extra)) return false;
+        size_t back = kDistBase[d] + extra;
+        if (back > out.size()) return false;
+        size_t from = out.size() - back;
+        for (size_t i = 0; i < len; ++i) out.push_back(out[from + i]);
+    }
+}
+
+bool inflateDynamic(BitReader& in, std::vector<uint8_t>& out) {
+    uint32_t nlen, ndist, ncode;
+    if (!in.get(5, nlen) || !in.get(5, ndist) || !in.get(4, ncode)) return false;
+    nlen += 257;
+    ndist += 1;
+    ncode += 4;
+    if (nlen > 286 || ndist > 30) return false;
+
+    static const uint8_t kOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+    uint8_t lengths[320] = {};
+    for (uint32_t i = 0; i < ncode; ++i) {
+        uint32_t v;
+        if (!in.get(3, v)) return false;
+        lengths[kOrder[i]] = uint8_t(v);
+    }
+    Huffman codeLengths;
+    if (!codeLengths.build(lengths, 19)) return false;
+
+    std::memset(lengths, 0, sizeof(lengths));
+    uint32_t index = 0;
+    while (index < nlen + ndist) {
+        int sym;
+        if (!in.decode(codeLengths, sym)) return false;
+        if (sym < 16) {
+            lengths[index++] = uint8_t(sym);
+            continue;
+        }
+        uint8_t value = 0;
+        uint32_t repeat;
+        if (sym == 16) {
+            if (index == 0 || !in.get(2, repeat)) return false;
+            value = lengths[index - 1];
+            repeat += 3;
+        } else if (sym == 17) {
+            if (!in.get(3, repeat)) return false;
+            repeat += 3;
+        } else {
+            if (!in.get(7, repeat)) return false;
+            repeat += 11;
+        }
+        if (index + repeat > nlen + ndist) return false;
+        while (repeat--) lengths[index++] = value;
+    }
+
+    Huffman lit, dist;
+    if (!lit.build(lengths, int(nlen)) || !dist.build(lengths + nlen, int(ndist))) return false;
+    return inflateCodes(in, lit, dist, out);
+}
+
+bool inflateFixed(BitReader& in, std::vector<uint8_t>& out) {
+    static Huffman lit, dist;
+    static bool ready = false;
+    if (!ready) {
+        uint8_t lengths[288];
+        for (int i = 0; i < 144; ++i) lengths[i] = 8;
+        for (int i = 144; i < 256; ++i) lengths[i] = 9;
+        for (int i = 256; i < 280; ++i) lengths[i] = 7;
+        for (int i = 280; i < 288; ++i) lengths[i] = 8;
+        lit.build(lengths, 288);
+        for (int i = 0; i < 30; ++i) lengths[i] = 5;
+        dist.build(lengths, 30);
+        ready = true;
+    }
+    return inflateCodes(in, lit, dist, out);
+}
+
+// zlib stream: 2-byte header, deflate blocks, Adler-32 (not verified; the PNG
+// chunk CRCs already were).
+bool zlibInflate(const uint8_t* p, size_t n, std::vector<uint8_t>& out) {
+    if (n < 2 || (p[0] & 0x0F) != 8 || ((uint32_t(p[0]) << 8) | p[1]) % 31 != 0 || (p[1] & 0x20)) return false;
+    BitReader in(p + 2, n - 2);
+    for (;;) {
+        uint32_t last, type;
+        if (!in.get(1, last) || !in.get(2, type)) return false;
+        if (type == 0) {
+            in.alignToByte();
+            if (in.pos + 4 > in.n) return false;
+            uint32_t len = uint32_t(in.p[in.pos]) | (uint32_t(in.p[in.pos + 1]) << 8);
+            uint32_t nlen = uint32_t(in.p[in.pos + 2]) | (uint32_t(in.p[in.pos + 3]) << 8);
+            in.pos += 4;
+            if ((len ^ 0xFFFFu) != nlen || in.pos + len > in.n) return false;
+            out.insert(out.end(), in.p + in.pos, in.p + in.pos + len);
+            in.pos += len;
+        } else if (type == 1) {
+            if (!inflateFixed(in, out)) return false;
+        } else if (type == 2) {
+            if (!inflateDynamic(in, out)) return false;
+        } else {
+            return false;
+        }
+        if (last) return true;
+    }
+}
+
+/* ===================== PNG ===================== */
+
+inline uint8_t paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) return uint8_t(a);
+    return uint8_t(pb <= pc ? b : c);
+}
+
+// Undoes the per-row filters in place; `bpp` bytes per pixel.
+bool unfilter(std::vector<uint8_t>& data, int height, size_t stride, int bpp) {
+    if (data.size() < size_t(height) * (stride + 1)) return false;
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = data.data() + size_t(y) * (stride + 1);
+        uint8_t filter = row[0];
+        uint8_t* cur = row + 1;
+        const uint8_t* prev = (y > 0) ? cur - (stride + 1) : nullptr;
+        for (size_t i = 0; i < stride; ++i) {
+            int a = (i >= size_t(bpp)) ? cur[i - bpp] : 0;
+            int b = prev ? prev[i] : 0;
+            int c = (prev && i >= size_t(bpp)) ? prev[i - bpp] : 0;
+            switch (filter) {
+            case 0: break;
+            case 1: cur[i] = uint8_t(cur[i] + a); break;
+            case 2: cur[i] = uint8_t(cur[i] + b); break;
+            case 3: cur[i] = uint8_t(cur[i] + ((a + b) >> 1)); break;
+            case 4: cur[i] = uint8_t(cur[i] + paeth(a, b, c)); break;
+            default: return false;
+            }
+        }
+    }
+    return true;
+}
+
+uint32_t crc32(const uint8_t* p, size_t n) {
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        ready = true;
+    }
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; ++i) crc = table[(crc ^ p[i]) & 0xFFu] ^ (crc >> 8);
+    return ~crc;
+}
+
+} // namespace
+
+bool ImageReader::readPpm(const std::string& path, std::vector<uint32_t>& rgba, int& width, int& height) {
+    std::vector<uint8_t> bytes;
+    if (!readFile(path, bytes)) return false;
+    bytes.push_back(0);
+
+    // "P6", width, height, maxval separated by whitespace (and # comments),
+    // then exactly one whitespace byte before the samples.
+    const char* p = reinterpret_cast<const char*>(bytes.data());
+    const char* end = p + bytes.size() - 1;
+    if (end - p < 2 || p[0] != 'P' || p[1] != '6') return false;
+    p += 2;
+    long fields[3];
+    for (long& field : fields) {
+        while (p < end && (std::strchr(" \t\r\n", *p) || *p == '#')) {
+            if (*p == '#') {
+                while (p < end && *p != '\n') ++p;
+            } else {
+                ++p;
+            }
+        }
+        char* after;
+        field = std::strtol(p, &after, 10);
+        if (after == p) return false;
+        p = after;
+    }
+    if (fields[0] <= 0 || fields[1] <= 0 || fields[0] > 16384 || fields[1] > 16384 || fields[2] != 255) return false;
+    ++p;
+    size_t count = size_t(fields[0]) * size_t(fields[1]);
+    if (size_t(end - p) < count * 3) return false;
+
+    width = int(fields[0]);
+    height = int(fields[1]);
+    rgba.resize(count);
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(p);
+    for (size_t i = 0; i < count; ++i, src += 3) rgba[i] = packRgba(src[0], src[1], src[2], 255);
+    return true;
+}
+
+bool ImageReader::readPng(const std::string& path, std::vector<uint32_t>& rgba, int& width, int& height) {
+    std::vector<uint8_t> bytes;
+    if (!readFile(path, bytes)) return false;
+    static const uint8_t kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (bytes.size() < 8 || std::memcmp(bytes.data(), kSignature, 8) != 0) return false;
+
+    uint32_t w = 0, h = 0;
+    int channels = 0;
+    bool haveHeader = false;
+    std::vector<uint8_t> compressed;
+    size_t pos = 8;
+    for (;;) {
+        if (pos + 12 > bytes.size()) return false;
+        uint32_t len = readBigEndian(&bytes[pos]);
+        if (len > bytes.size() - pos - 12) return false;
+        const uint8_t* type = &bytes[pos + 4];
+        const uint8_t* body = type + 4;
+        if (crc32(type, len + 4) != readBigEndian(body + len)) return false;
+
+        if (std::memcmp(type, "IHDR", 4) == 0) {
+            if (len != 13) return false;
+            w = readBigEndian(body);
+            h = readBigEndian(body + 4);
+            uint8_t depth = body[8], color = body[9], interlace = body[12];
+            channels = (color == 0) ? 1 : (color == 2) ? 3 : (color == 4) ? 2 : (color == 6) ? 4 : 0;
+            if (depth != 8 || channels == 0 || body[10] != 0 || body[11] != 0 || interlace != 0) return false;
+            if (w == 0 || h == 0 || w > 16384 || h > 16384) return false;
+            haveHeader = true;
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            compressed.insert(compressed.end(), body, body + len);
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            break;
+        } else if (!(type[0] & 0x20)) {
+            return false;   // unknown critical chunk (e.g. PLTE: palettes are not supported)
+        }
+        pos += 12 + len;
+    }
+    if (!haveHeader) return false;
+
+    std::vector<uint8_t> data;
+    size_t stride = size_t(w) * size_t(channels);
+    data.reserve(size_t(h) * (stride + 1));
+    if (!zlibInflate(compressed.data(), compressed.size(), data)) return false;
+    if (!unfilter(data, int(h), stride, channels)) return false;
+
+    width = int(w);
+    height = int(h);
+    rgba.resize(size_t(w) * size_t(h));
+    for (uint32_t y = 0; y < h; ++y) {
+        const uint8_t* s = data.data() + size_t(y) * (stride + 1) + 1;
+        uint32_t* d = rgba.data() + size_t(y) * w;
+        for (uint32_t x = 0; x < w; ++x, s += channels) {
+            switch (channels) {
+            case 1: d[x] = packRgba(s[0], s[0], s[0], 255); break;
+            case 2: d[x] = packRgba(s[0], s[0], s[0], s[1]); break;
+            case 3: d[x] = packRgba(s[0], s[1], s[2], 255); break;
+            default: d[x] = packRgba(s[0], s[1], s[2], s[3]); break;
+            }
+        }
+    }
+    return true;
+}
+
+bool ImageReader::read(const std::string& path, std::vector<uint32_t>& rgba, int& width, int& height) {
+    size_t n = path.size();
+    if (n >= 4 && path.compare(n - 4, 4, ".png") == 0) return readPng(path, rgba, width, height);
+    return readPpm(path, rgba, width, height);
+}
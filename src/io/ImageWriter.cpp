@@ -0,0 +1,190 @@
+#include "../../include/io/ImageWriter.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// RGB rows, each prefixed with the PNG filter byte when `filterBytes` is set.
+std::vector<uint8_t> rgbRows(const uint32_t* rgba, int width, int height, bool filterBytes) {
+    std::vector<uint8_t> out;
+    out.reserve(size_t(height) * (size_t(width) * 3 + 1));
+    for (int y = 0; y < height; ++y) {
+        if (filterBytes) out.push_back(0);
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(rgba + size_t(y) * size_t(width));
+        for (int x = 0; x < width; ++x, p += 4) out.insert(out.end(), p, p + 3);
+    }
+    return out;
+}
+
+bool writeFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+/* ===================== Deflate (fixed Huffman) ===================== */
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out(out), acc(0), bits(0) {}
+
+    // `count` bits of `value`, least significant first.
+    void put(uint32_t value, int count) {
+        acc |= uint64_t(value) << bits;
+        bits += count;
+        while (bits >= 8) {
+            out.push_back(uint8_t(acc));
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+
+    // Huffman codes go out most significant bit first.
+    void putCode(uint32_t code, int count) {
+        uint32_t rev = 0;
+        for (int i = 0; i < count; ++i) rev |= ((code >> i) & 1u) << (count - 1 - i);
+        put(rev, count);
+    }
+
+    void flush() {
+        if (bits > 0) out.push_back(uint8_t(acc));
+        acc = 0;
+        bits = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out;
+    uint64_t acc;
+    int bits;
+};
+
+void putLiteral(BitWriter& bw, int sym) {
+    if (sym < 144) bw.putCode(0x30 + sym, 8);
+    else if (sym < 256) bw.putCode(0x190 + (sym - 144), 9);
+    else if (sym < 280) bw.putCode(sym - 256, 7);
+    else bw.putCode(0xC0 + (sym - 280), 8);
+}
+
+const int kLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                              35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const int kLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                               3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+// Match of `len` (3..258) bytes at distance 3, one RGB pixel back.
+void putPixelRepeat(BitWriter& bw, int len) {
+    int code = 28;
+    while (kLengthBase[code] > len) --code;
+    putLiteral(bw, 257 + code);
+    if (kLengthExtra[code]) bw.put(uint32_t(len - kLengthBase[code]), kLengthExtra[code]);
+    bw.putCode(2, 5);   // distance code 2 = distance 3, no extra bits
+}
+
+// zlib stream of `data`, whose rows are `stride` bytes with a leading filter byte.
+std::vector<uint8_t> zlibCompress(const std::vector<uint8_t>& data, size_t stride) {
+    std::vector<uint8_t> out = { 0x78, 0x01 };
+    BitWriter bw(out);
+    bw.put(1, 1);   // final block
+    bw.put(1, 2);   // fixed Huffman
+
+    for (size_t row = 0; row < data.size(); row += stride) {
+        putLiteral(bw, data[row]);
+        // Matches stay inside the row so they never reach back over a filter byte.
+        size_t i = row + 1, end = row + stride;
+        while (i < end) {
+            size_t len = 0;
+            if (i >= row + 4) {
+                while (i + len < end && len < 258 && data[i + len] == data[i + len - 3]) ++len;
+            }
+            if (len >= 3) {
+                putPixelRepeat(bw, int(len));
+                i += len;
+            } else {
+                putLiteral(bw, data[i]);
+                ++i;
+            }
+        }
+    }
+    putLiteral(bw, 256);
+    bw.flush();
+
+    uint32_t a = 1, b = 0;
+    for (uint8_t v : data) {
+        a = (a + v) % 65521u;
+        b = (b + a) % 65521u;
+    }
+    uint32_t adler = (b << 16) | a;
+    for (int s = 24; s >= 0; s -= 8) out.push_back(uint8_t(adler >> s));
+    return out;
+}
+
+/* ===================== PNG chunks ===================== */
+
+uint32_t crc32(const uint8_t* p, size_t n, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        ready = true;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < n; ++i) crc = table[(crc ^ p[i]) & 0xFFu] ^ (crc >> 8);
+    return ~crc;
+}
+
+void putBigEndian(std::vector<uint8_t>& out, uint32_t v) {
+    for (int s = 24; s >= 0; s -= 8) out.push_back(uint8_t(v >> s));
+}
+
+void putChunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& body) {
+    putBigEndian(out, uint32_t(body.size()));
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), body.begin(), body.end());
+    putBigEndian(out, crc32(out.data() + start, out.size() - start));
+}
+
+} // namespace
+
+bool ImageWriter::writePpm(const std::string& path, const uint32_t* rgba, int width, int height) {
+    if (!rgba || width <= 0 || height <= 0) return false;
+    char header[64];
+    int n = std::snprintf(header, sizeof(header), "P6\n%d %d\n255\n", width, height);
+    std::vector<uint8_t> bytes(header, header + n);
+    std::vector<uint8_t> rows = rgbRows(rgba, width, height, false);
+    bytes.insert(bytes.end(), rows.begin(), rows.end());
+    return writeFile(path, bytes);
+}
+
+bool ImageWriter::writePng(const std::string& path, const uint32_t* rgba, int width, int height) {
+    if (!rgba || width <= 0 || height <= 0) return false;
+    static const uint8_t kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    std::vector<uint8_t> bytes(kSignature, kSignature + 8);
+
+    std::vector<uint8_t> ihdr;
+    putBigEndian(ihdr, uint32_t(width));
+    putBigEndian(ihdr, uint32_t(height));
+    ihdr.push_back(8);   // bit depth
+    ihdr.push_back(2);   // truecolor
+    ihdr.push_back(0);   // deflate
+    ihdr.push_back(0);   // adaptive filtering (every row uses "none")
+    ihdr.push_back(0);   // not interlaced
+    putChunk(bytes, "IHDR", ihdr);
+
+    std::vector<uint8_t> rows = rgbRows(rgba, width, height, true);
+    putChunk(bytes, "IDAT", zlibCompress(rows, size_t(width) * 3 + 1));
+    putChunk(bytes, "IEND", std::vector<uint8_t>());
+    return writeFile(path, bytes);
+}
+
+bool ImageWriter::write(const std::string& path, const uint32_t* rgba, int width, int height) {
+    size_t n = path.size();
+    if (n >= 4 && path.compare(n - 4, 4, ".png") == 0) return writePng(path, rgba, width, height);
+    return writePpm(path, rgba, width, height);
+}
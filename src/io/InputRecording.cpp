@@ -0,0 +1,242 @@
+#include "../../include/io/InputRecording.h"
+#include "../../include/io/MappedFile.h"
+
+#include <cstdio>
+#include <cstring>
+
+/* ===================== Encoding helpers ===================== */
+
+namespace {
+
+const char kMagic[8] = {'T', 'C', 'G', 'R', 'E', 'C', '\0', '\0'};
+const uint32_t kFormatVersion = 1;
+const size_t kHeaderSize = 48;
+
+enum : uint8_t {
+    REC_KEYS = 1,
+    REC_MOUSE_X = 2,
+    REC_BUTTON = 4,
+    REC_VIEWPORT = 8,
+    REC_RESET = 16
+};
+
+const int kKeyCount = 256;
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(uint8_t(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(uint8_t(v));
+}
+
+bool getVarint(const std::vector<uint8_t>& in, size_t& pos, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) return false;
+        uint8_t b = in[pos++];
+        v |= uint64_t(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+uint64_t zigzag(int64_t v) { return (uint64_t(v) << 1) ^ uint64_t(v >> 63); }
+int64_t unzigzag(uint64_t v) { return int64_t(v >> 1) ^ -int64_t(v & 1); }
+
+void putU32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = uint8_t(v >> (8 * i));
+}
+
+void putU64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = uint8_t(v >> (8 * i));
+}
+
+uint32_t getU32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= uint32_t(p[i]) << (8 * i);
+    return v;
+}
+
+uint64_t getU64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= uint64_t(p[i]) << (8 * i);
+    return v;
+}
+
+bool& keySlot(InputState& s, int index) {
+    return (index < kKeyCount) ? s.keys[index] : s.specialKeys[index - kKeyCount];
+}
+
+} // namespace
+
+InputRecordingInfo::InputRecordingInfo()
+    : simHz(60), tickCount(0), mapHash(0), finalHash(0) {}
+
+/* ===================== Recorder ===================== */
+
+InputRecorder::InputRecorder()
+    : lastViewportWidth(0), lastRecordTick(0) {}
+
+void InputRecorder::begin(uint32_t simHz, uint64_t mapHash) {
+    info = InputRecordingInfo();
+    info.simHz = simHz;
+    info.mapHash = mapHash;
+    data.clear();
+    last.clear();
+    lastViewportWidth = 0;
+    lastRecordTick = 0;
+}
+
+void InputRecorder::record(const InputState& in, int viewportWidth, bool resetBefore) {
+    const uint64_t t = info.tickCount++;
+
+    int toggled[2 * kKeyCount];
+    int toggledCount = 0;
+    for (int k = 0; k < kKeyCount; ++k) {
+        if (in.keys[k] != last.keys[k]) toggled[toggledCount++] = k;
+    }
+    for (int k = 0; k < kKeyCount; ++k) {
+        if (in.specialKeys[k] != last.specialKeys[k]) toggled[toggledCount++] = kKeyCount + k;
+    }
+
+    uint8_t flags = 0;
+    if (toggledCount > 0) flags |= REC_KEYS;
+    if (in.mouseX != last.mouseX) flags |= REC_MOUSE_X;
+    if (in.mouseLeftPressed != last.mouseLeftPressed) flags |= REC_BUTTON;
+    if (viewportWidth != lastViewportWidth) flags |= REC_VIEWPORT;
+    if (resetBefore) flags |= REC_RESET;
+    if (flags == 0) return;
+
+    putVarint(data, t - lastRecordTick);
+    data.push_back(flags);
+    if (flags & REC_KEYS) {
+        putVarint(data, uint64_t(toggledCount));
+        for (int i = 0; i < toggledCount; ++i) putVarint(data, uint64_t(toggled[i]));
+    }
+    if (flags & REC_MOUSE_X) putVarint(data, zigzag(int64_t(in.mouseX) - int64_t(last.mouseX)));
+    if (flags & REC_VIEWPORT) putVarint(data, uint64_t(viewportWidth < 0 ? 0 : viewportWidth));
+
+    last = in;
+    lastViewportWidth = viewportWidth;
+    lastRecordTick = t;
+}
+
+uint64_t InputRecorder::ticks() const { return info.tickCount; }
+
+const std::vector<uint8_t>& InputRecorder::body() const { return data; }
+
+bool InputRecorder::save(const std::string& path, uint64_t finalHash) const {
+    uint8_t header[kHeaderSize] = {};
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    putU32(header + 8, kFormatVersion);
+    putU32(header + 12, info.simHz);
+    putU64(header + 16, info.tickCount);
+    putU64(header + 24, info.mapHash);
+    putU64(header + 32, finalHash);
+    putU64(header + 40, uint64_t(data.size()));
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(header, 1, kHeaderSize, f) == kHeaderSize;
+    if (ok && !data.empty()) ok = std::fwrite(data.data(), 1, data.size(), f) == data.size();
+    ok = (std::fclose(f) == 0) && ok;
+    return ok;
+}
+
+/* ===================== Replay ===================== */
+
+InputReplay::InputReplay()
+    : cursor(0), tick(0), nextChangeTick(0), hasPending(false), viewportWidth(0) {}
+
+bool InputReplay::fail(const char* msg) {
+    err = msg;
+    data.clear();
+    header = InputRecordingInfo();
+    return false;
+}
+
+bool InputReplay::load(const std::string& path) {
+    err.clear();
+
+    MappedFile file;
+    if (!file.open(path)) return fail("cannot open recording");
+    if (file.size() < kHeaderSize) return fail("file too small");
+
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(file.data());
+    if (std::memcmp(p, kMagic, sizeof(kMagic)) != 0) return fail("not an input recording");
+    if (getU32(p + 8) != kFormatVersion) return fail("unsupported recording version");
+
+    header.simHz = getU32(p + 12);
+    header.tickCount = getU64(p + 16);
+    header.mapHash = getU64(p + 24);
+    header.finalHash = getU64(p + 32);
+    uint64_t bodySize = getU64(p + 40);
+    if (header.simHz == 0) return fail("bad tick rate");
+    if (bodySize != file.size() - kHeaderSize) return fail("truncated recording");
+
+    data.assign(p + kHeaderSize, p + file.size());
+    restart();
+    return true;
+}
+
+const std::string& InputReplay::error() const { return err; }
+
+const InputRecordingInfo& InputReplay::info() const { return header; }
+
+void InputReplay::restart() {
+    cursor = 0;
+    tick = 0;
+    current.clear();
+    viewportWidth = 0;
+
+    uint64_t gap = 0;
+    hasPending = getVarint(data, cursor, gap);
+    nextChangeTick = gap;
+}
+
+bool InputReplay::next(InputState& in, int& viewport, bool& resetBefore) {
+    if (tick >= header.tickCount) return false;
+
+    resetBefore = false;
+    if (hasPending && tick == nextChangeTick) {
+        // A malformed record ends the replay's changes; the held state
+        // simply continues to the end.
+        bool ok = cursor < data.size();
+        uint8_t flags = ok ? data[cursor++] : 0;
+
+        if (ok && (flags & REC_KEYS)) {
+            uint64_t count = 0;
+            ok = getVarint(data, cursor, count) && count <= 2 * kKeyCount;
+            for (uint64_t i = 0; ok && i < count; ++i) {
+                uint64_t k = 0;
+                ok = getVarint(data, cursor, k) && k < 2 * kKeyCount;
+                if (ok) {
+                    bool& slot = keySlot(current, int(k));
+                    slot = !slot;
+                }
+            }
+        }
+        if (ok && (flags & REC_MOUSE_X)) {
+            uint64_t dx = 0;
+            ok = getVarint(data, cursor, dx);
+            if (ok) current.mouseX += int(unzigzag(dx));
+        }
+        if (ok && (flags & REC_BUTTON)) current.mouseLeftPressed = !current.mouseLeftPressed;
+        if (ok && (flags & REC_VIEWPORT)) {
+            uint64_t w = 0;
+            ok = getVarint(data, cursor, w);
+            if (ok) viewportWidth = int(w);
+        }
+        if (ok) resetBefore = (flags & REC_RESET) != 0;
+
+        uint64_t gap = 0;
+        hasPending = ok && getVarint(data, cursor, gap) && gap > 0;
+        nextChangeTick += gap;
+    }
+
+    in = current;
+    viewport = viewportWidth;
+    ++tick;
+    return true;
+}
@@ -0,0 +1,95 @@
+#include "../../include/io/MappedFile.h"
+
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+MappedFile::MappedFile()
+    : ptr(nullptr), len(0), mapped(false), opened(false) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& o) noexcept
+    : ptr(nullptr), len(0), mapped(false), opened(false) {
+    *this = std::move(o);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& o) noexcept {
+    if (this == &o) return *this;
+    close();
+    mapped = o.mapped;
+    opened = o.opened;
+    len = o.len;
+    fallback = std::move(o.fallback);
+    ptr = mapped ? o.ptr : fallback.data();
+    o.ptr = nullptr;
+    o.len = 0;
+    o.mapped = false;
+    o.opened = false;
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        len = size_t(st.st_size);
+        if (len == 0) {
+            ::close(fd);
+            ptr = fallback.data();
+            opened = true;
+            return true;
+        }
+        void* p = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            ::close(fd);
+            ptr = static_cast<const char*>(p);
+            mapped = true;
+            opened = true;
+            return true;
+        }
+    }
+
+    // Not mappable: read it all.
+    fallback.clear();
+    char buf[65536];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0) fallback.append(buf, size_t(n));
+    ::close(fd);
+    if (n < 0) {
+        fallback.clear();
+        len = 0;
+        return false;
+    }
+
+    ptr = fallback.data();
+    len = fallback.size();
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped && ptr) ::munmap(const_cast<char*>(ptr), len);
+    ptr = nullptr;
+    len = 0;
+    mapped = false;
+    opened = false;
+    fallback.clear();
+}
+
+bool MappedFile::isOpen() const { return opened; }
+const char* MappedFile::data() const { return ptr; }
+size_t MappedFile::size() const { return len; }
+
+std::string_view MappedFile::view() const {
+    return std::string_view(ptr ? ptr : "", len);
+}
@@ -0,0 +1,354 @@
+#include "../../include/io/SceneCache.h"
+#include "../../include/io/MappedFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <unistd.h>
+
+/* ===================== File layout ===================== */
+
+namespace {
+
+const char kMagic[8] = {'T', 'C', 'G', 'S', 'C', 'N', '\0', '\0'};
+const uint32_t kFormatVersion = 2;
+const uint32_t kEndianTag = 0x01020304u;
+const uint64_t kSectionAlign = 16;
+
+enum : uint32_t {
+    FLAG_ARENA = 1u << 0,
+    FLAG_PLAYER1 = 1u << 1,
+    FLAG_PLAYER2 = 1u << 2
+};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t endianTag;
+    uint32_t entrySize;
+
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+
+    uint32_t flags;
+    uint32_t obstacleCount;
+    float arena[3];
+    float player1[3];
+    float player2[3];
+
+    int32_t cols;
+    int32_t rows;
+    int32_t entryCount;
+    float gridOrigin[2];
+    float cellSize;
+    uint32_t builderVersion;
+
+    uint64_t obstaclesOffset;
+    uint64_t cellStartOffset;
+    uint64_t entriesOffset;
+    uint64_t fileSize;
+    uint64_t payloadChecksum;
+};
+
+// Obstacles are stored as packed (x, y, r) triples.
+struct ObstacleRecord {
+    float x, y, r;
+};
+
+static_assert(sizeof(ObstacleRecord) == 12, "unexpected padding");
+static_assert(sizeof(ObstacleGrid::Entry) == 16, "unexpected padding");
+
+uint64_t alignUp(uint64_t v) {
+    return (v + kSectionAlign - 1) & ~(kSectionAlign - 1);
+}
+
+std::string gDirectoryOverride;
+
+const char kExtension[] = ".scene";
+
+std::string fileName(uint64_t hash) {
+    char buf[48];
+    std::snprintf(buf, sizeof(buf), "%016llx-b%u%s", (unsigned long long)hash, unsigned(SceneCache::kBuilderVersion),
+                  kExtension);
+    return buf;
+}
+
+} // namespace
+
+/* ===================== Hashing ===================== */
+
+// FNV-style mixing over 8-byte words with a murmur finalizer: fast enough that
+// hashing the SVG costs a small fraction of parsing it.
+uint64_t SceneCache::contentHash(const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const uint64_t kPrime = 0x100000001b3ull;
+    uint64_t h = 0xcbf29ce484222325ull ^ (uint64_t(size) * 0x9e3779b97f4a7c15ull);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        h = (h ^ w) * kPrime;
+        h ^= h >> 29;
+    }
+    for (; i < size; ++i) {
+        h = (h ^ p[i]) * kPrime;
+    }
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+bool SceneCache::hashFile(const std::string& path, uint64_t& hash) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    hash = contentHash(file.data(), file.size());
+    return true;
+}
+
+/* ===================== Location ===================== */
+
+void SceneCache::setDirectory(const std::string& dir) {
+    gDirectoryOverride = dir;
+}
+
+std::string SceneCache::directory() {
+    if (!gDirectoryOverride.empty()) return gDirectoryOverride;
+
+    if (const char* d = std::getenv("TRABALHOCG_CACHE_DIR")) {
+        if (*d) return d;
+    }
+    if (const char* x = std::getenv("XDG_CACHE_HOME")) {
+        if (*x) return std::string(x) + "/trabalhocg";
+    }
+    if (const char* home = std::getenv("HOME")) {
+        if (*home) return std::string(home) + "/.cache/trabalhocg";
+    }
+    return std::string();
+}
+
+/* ===================== Read / write ===================== */
+
+bool SceneCache::read(const std::string& cachePath, uint64_t sourceHash, uint64_t sourceSize,
+                      SvgSceneData& scene, ObstacleGrid& grid) {
+    MappedFile file;
+    if (!file.open(cachePath)) return false;
+    if (file.size() < sizeof(FileHeader)) return false;
+
+    FileHeader h;
+    std::memcpy(&h, file.data(), sizeof(h));
+
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) return false;
+    if (h.version != kFormatVersion || h.headerSize != sizeof(FileHeader)) return false;
+    if (h.endianTag != kEndianTag || h.entrySize != sizeof(ObstacleGrid::Entry)) return false;
+    if (h.builderVersion != kBuilderVersion) return false;
+    if (h.sourceHash != sourceHash || h.sourceSize != sourceSize) return false;
+    if (h.fileSize != file.size()) return false;
+
+    // Section bounds, computed the same way write() lays them out.
+    const bool hasGrid = h.cols > 0;
+    if (h.cols < 0 || h.rows < 0 || h.entryCount < 0 || (hasGrid && h.rows == 0)) return false;
+    const uint64_t cellCount = uint64_t(h.cols) * uint64_t(h.rows);
+    const uint64_t obstaclesEnd = h.obstaclesOffset + uint64_t(h.obstacleCount) * sizeof(ObstacleRecord);
+    const uint64_t cellStartEnd = h.cellStartOffset + (hasGrid ? (cellCount + 1) * sizeof(int32_t) : 0);
+    const uint64_t entriesEnd = h.entriesOffset + uint64_t(h.entryCount) * sizeof(ObstacleGrid::Entry);
+    if (h.obstaclesOffset != alignUp(sizeof(FileHeader)) ||
+        h.cellStartOffset != alignUp(obstaclesEnd) ||
+        h.entriesOffset != alignUp(cellStartEnd) ||
+        entriesEnd > h.fileSize) {
+        return false;
+    }
+
+    const char* payload = file.data() + h.obstaclesOffset;
+    if (contentHash(payload, size_t(h.fileSize - h.obstaclesOffset)) != h.payloadChecksum) return false;
+
+    SvgSceneData out;
+    out.hasArena = (h.flags & FLAG_ARENA) != 0;
+    out.hasPlayer1 = (h.flags & FLAG_PLAYER1) != 0;
+    out.hasPlayer2 = (h.flags & FLAG_PLAYER2) != 0;
+    out.arena.center = Vec2(h.arena[0], h.arena[1]);
+    out.arena.radius = h.arena[2];
+    out.player1Pos = Vec2(h.player1[0], h.player1[1]);
+    out.player1HeadRadius = h.player1[2];
+    out.player2Pos = Vec2(h.player2[0], h.player2[1]);
+    out.player2HeadRadius = h.player2[2];
+
+    out.obstacles.resize(h.obstacleCount);
+    for (uint32_t i = 0; i < h.obstacleCount; ++i) {
+        ObstacleRecord rec;
+        std::memcpy(&rec, file.data() + h.obstaclesOffset + i * sizeof(ObstacleRecord), sizeof(rec));
+        out.obstacles[i] = Obstacle(Vec2(rec.x, rec.y), rec.r);
+    }
+
+    if (hasGrid) {
+        // The mapping is page-aligned and the sections 16-byte aligned, but
+        // copy through vectors anyway so the fallback read path is safe too.
+        std::vector<int32_t> starts(cellCount + 1);
+        std::vector<ObstacleGrid::Entry> entries(size_t(h.entryCount));
+        std::memcpy(starts.data(), file.data() + h.cellStartOffset, starts.size() * sizeof(int32_t));
+        if (!entries.empty()) {
+            std::memcpy(entries.data(), file.data() + h.entriesOffset,
+                        entries.size() * sizeof(ObstacleGrid::Entry));
+        }
+        if (!grid.assign(h.gridOrigin[0], h.gridOrigin[1], h.cellSize, h.cols, h.rows,
+                         starts.data(), entries.data(), h.entryCount, int(h.obstacleCount))) {
+            return false;
+        }
+    } else {
+        if (h.obstacleCount != 0) return false;
+        grid.clear();
+    }
+
+    scene = std::move(out);
+    return true;
+}
+
+bool SceneCache::write(const std::string& cachePath, uint64_t sourceHash, uint64_t sourceSize,
+                       const SvgSceneData& scene, const ObstacleGrid& grid) {
+    const std::vector<int>& starts = grid.cellStartArray();
+    std::vector<ObstacleGrid::Entry> entries(size_t(grid.entryCount()));
+    for (size_t k = 0; k < entries.size(); ++k) entries[k] = grid.entry(int(k));
+    const bool hasGrid = !starts.empty();
+
+    FileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kFormatVersion;
+    h.headerSize = sizeof(FileHeader);
+    h.endianTag = kEndianTag;
+    h.entrySize = sizeof(ObstacleGrid::Entry);
+    h.sourceHash = sourceHash;
+    h.sourceSize = sourceSize;
+
+    h.flags = (scene.hasArena ? FLAG_ARENA : 0u) |
+              (scene.hasPlayer1 ? FLAG_PLAYER1 : 0u) |
+              (scene.hasPlayer2 ? FLAG_PLAYER2 : 0u);
+    h.obstacleCount = uint32_t(scene.obstacles.size());
+    h.arena[0] = scene.arena.center.x;
+    h.arena[1] = scene.arena.center.y;
+    h.arena[2] = scene.arena.radius;
+    h.player1[0] = scene.player1Pos.x;
+    h.player1[1] = scene.player1Pos.y;
+    h.player1[2] = scene.player1HeadRadius;
+    h.player2[0] = scene.player2Pos.x;
+    h.player2[1] = scene.player2Pos.y;
+    h.player2[2] = scene.player2HeadRadius;
+
+    h.cols = hasGrid ? grid.columns() : 0;
+    h.rows = hasGrid ? grid.rows() : 0;
+    h.entryCount = int32_t(entries.size());
+    h.gridOrigin[0] = grid.gridOriginX();
+    h.gridOrigin[1] = grid.gridOriginY();
+    h.cellSize = grid.cellSize();
+    h.builderVersion = kBuilderVersion;
+
+    h.obstaclesOffset = alignUp(sizeof(FileHeader));
+    h.cellStartOffset = alignUp(h.obstaclesOffset + uint64_t(h.obstacleCount) * sizeof(ObstacleRecord));
+    h.entriesOffset = alignUp(h.cellStartOffset + uint64_t(starts.size()) * sizeof(int32_t));
+    h.fileSize = h.entriesOffset + uint64_t(entries.size()) * sizeof(ObstacleGrid::Entry);
+
+    // Assemble the whole file in memory; it is checksummed and written in one go.
+    std::vector<char> bytes(size_t(h.fileSize), 0);
+    for (size_t i = 0; i < scene.obstacles.size(); ++i) {
+        const Obstacle& ob = scene.obstacles[i];
+        ObstacleRecord rec = {ob.pos.x, ob.pos.y, ob.radius};
+        std::memcpy(&bytes[h.obstaclesOffset + i * sizeof(rec)], &rec, sizeof(rec));
+    }
+    if (!starts.empty()) {
+        std::memcpy(&bytes[h.cellStartOffset], starts.data(), starts.size() * sizeof(int32_t));
+    }
+    if (!entries.empty()) {
+        std::memcpy(&bytes[h.entriesOffset], entries.data(), entries.size() * sizeof(ObstacleGrid::Entry));
+    }
+    h.payloadChecksum = contentHash(bytes.data() + h.obstaclesOffset, size_t(h.fileSize - h.obstaclesOffset));
+    std::memcpy(bytes.data(), &h, sizeof(h));
+
+    // Write to a private temp file and rename, so concurrent launches never
+    // observe a half-written cache. The counter keeps the name unique between
+    // threads of one process writing the same entry.
+    static std::atomic<unsigned> tmpCounter(0);
+    std::string tmpPath = cachePath + ".tmp" + std::to_string((long long)getpid()) + "." +
+                          std::to_string(tmpCounter.fetch_add(1, std::memory_order_relaxed));
+    std::FILE* f = std::fopen(tmpPath.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    ok = (std::fclose(f) == 0) && ok;
+    if (ok) ok = std::rename(tmpPath.c_str(), cachePath.c_str()) == 0;
+    if (!ok) std::remove(tmpPath.c_str());
+    return ok;
+}
+
+void SceneCache::trim(const std::string& dir, uint64_t maxBytes, const std::string& keep) {
+    struct Item {
+        std::filesystem::file_time_type time;
+        uint64_t size;
+        std::filesystem::path path;
+    };
+    std::vector<Item> items;
+    uint64_t total = 0;
+
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        const std::filesystem::path& p = it->path();
+        if (p.extension() != kExtension || !it->is_regular_file(ec)) continue;
+        Item item{it->last_write_time(ec), uint64_t(it->file_size(ec)), p};
+        if (ec) { ec.clear(); continue; }
+        total += item.size;
+        if (p != std::filesystem::path(keep)) items.push_back(item);
+    }
+    if (total <= maxBytes) return;
+
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.time < b.time; });
+    for (const Item& item : items) {
+        if (total <= maxBytes) break;
+        // Another process may have removed it already; only count what we delete.
+        if (std::filesystem::remove(item.path, ec)) total -= item.size;
+    }
+}
+
+/* ===================== Entry point ===================== */
+
+SceneCache::Result SceneCache::load(const std::string& svgPath, SvgSceneData& scene, ObstacleGrid& grid) {
+    const char* disabled = std::getenv("TRABALHOCG_NO_SCENE_CACHE");
+    std::string dir = (disabled && *disabled) ? std::string() : directory();
+
+    std::string cachePath;
+    uint64_t hash = 0;
+    uint64_t size = 0;
+
+    if (!dir.empty()) {
+        MappedFile src;
+        if (src.open(svgPath)) {
+            hash = contentHash(src.data(), src.size());
+            size = src.size();
+            cachePath = dir + "/" + fileName(hash);
+            if (read(cachePath, hash, size, scene, grid)) {
+                // Recently used files are the last ones trim() deletes.
+                std::error_code ec;
+                std::filesystem::last_write_time(cachePath, std::filesystem::file_time_type::clock::now(), ec);
+                return Result::HIT;
+            }
+        }
+    }
+
+    if (!SvgLoader::load(svgPath, scene)) return Result::FAILED;
+    grid.build(scene.obstacles);
+
+    if (cachePath.empty()) return Result::UNCACHED;
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec) return Result::UNCACHED;
+    if (!write(cachePath, hash, size, scene, grid)) return Result::UNCACHED;
+    trim(dir, kMaxDirectoryBytes, cachePath);
+    return Result::BUILT;
+}
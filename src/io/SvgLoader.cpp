@@ -1,16 +1,18 @@
 #include "../../include/io/SvgLoader.h"
-#include "../../third_party/tinywml2/tinyxml2.h"
+#include "../../include/io/MappedFile.h"
+#include "../../include/io/XmlSaxParser.h"
 
+#include <charconv>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
 #include <cstdio>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
-using tinyxml2::XMLDocument;
-using tinyxml2::XMLElement;
-
 /* ===================== SvgSceneData ===================== */
 
 SvgSceneData::SvgSceneData()
@@ -32,17 +34,6 @@ static void dbgFail(const char* path, const char* msg) {
                  msg ? msg : "(null)");
 }
 
-static bool parseFloatLocal(const char* s, float& out) {
-    if (!s) return false;
-    char* end = nullptr;
-    out = std::strtof(s, &end);
-    return end != s;
-}
-
-static bool strEq(const char* a, const char* b) {
-    return a && b && std::strcmp(a, b) == 0;
-}
-
 static int hexVal(char c) {
     if (c >= '0' && c <= '9') return c - '0';
     c = (char)std::tolower((unsigned char)c);
@@ -50,9 +41,8 @@ static int hexVal(char c) {
     return -1;
 }
 
-static bool parseHexColor(const char* s, int& r, int& g, int& b) {
-    if (!s || s[0] != '#') return false;
-    if (std::strlen(s) != 7) return false;
+static bool parseHexColor(std::string_view s, int& r, int& g, int& b) {
+    if (s.size() != 7 || s[0] != '#') return false;
     int r1 = hexVal(s[1]), r2 = hexVal(s[2]);
     int g1 = hexVal(s[3]), g2 = hexVal(s[4]);
     int b1 = hexVal(s[5]), b2 = hexVal(s[6]);
@@ -63,54 +53,61 @@ static bool parseHexColor(const char* s, int& r, int& g, int& b) {
     return true;
 }
 
-static const char* extractFillFromStyle(const char* style, char* buf, size_t bufCap) {
-    if (!style || !buf || bufCap == 0) return nullptr;
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static std::string_view trim(std::string_view v) {
+    while (!v.empty() && isSpace(v.front())) v.remove_prefix(1);
+    while (!v.empty() && isSpace(v.back())) v.remove_suffix(1);
+    return v;
+}
 
-    const char* p = std::strstr(style, "fill");
-    while (p) {
-        const char* q = p + 4;
-        while (*q && std::isspace((unsigned char)*q)) ++q;
-        if (*q != ':') { p = std::strstr(p + 1, "fill"); continue; }
+// Value of property `name` inside a style attribute ("a:b;c:d"), or empty.
+static std::string_view extractStyleProperty(std::string_view style, std::string_view name) {
+    size_t p = style.find(name);
+    while (p != std::string_view::npos) {
+        size_t q = p + name.size();
+        bool atStart = (p == 0 || style[p - 1] == ';' || isSpace(style[p - 1]));
+        while (q < style.size() && isSpace(style[q])) ++q;
+        if (!atStart || q >= style.size() || style[q] != ':') { p = style.find(name, p + 1); continue; }
         ++q;
-        while (*q && std::isspace((unsigned char)*q)) ++q;
+        while (q < style.size() && isSpace(style[q])) ++q;
 
-        size_t i = 0;
-        while (*q && *q != ';' && !std::isspace((unsigned char)*q) && i + 1 < bufCap) {
-            buf[i++] = *q++;
-        }
-        buf[i] = '\0';
-        return (i > 0) ? buf : nullptr;
+        size_t e = q;
+        while (e < style.size() && style[e] != ';' && !isSpace(style[e])) ++e;
+        return style.substr(q, e - q);
     }
-    return nullptr;
+    return std::string_view();
 }
 
-static bool isBlueFillAny(const char* fill) {
-    if (!fill) return false;
-    if (strEq(fill, "blue")) return true;
+static bool isBlueFillAny(std::string_view fill) {
+    if (fill.empty()) return false;
+    if (fill == "blue") return true;
     int r, g, b;
     if (parseHexColor(fill, r, g, b)) return (r == 0 && g == 0 && b == 255);
     return false;
 }
 
-static bool isGreenFillAny(const char* fill) {
-    if (!fill) return false;
-    if (strEq(fill, "green")) return true;
+static bool isGreenFillAny(std::string_view fill) {
+    if (fill.empty()) return false;
+    if (fill == "green") return true;
     int r, g, b;
     if (parseHexColor(fill, r, g, b)) return (r == 0 && g == 255 && b == 0);
     return false;
 }
 
-static bool isRedFillAny(const char* fill) {
-    if (!fill) return false;
-    if (strEq(fill, "red")) return true;
+static bool isRedFillAny(std::string_view fill) {
+    if (fill.empty()) return false;
+    if (fill == "red") return true;
     int r, g, b;
     if (parseHexColor(fill, r, g, b)) return (r == 255 && g == 0 && b == 0);
     return false;
 }
 
-static bool isBlackFillAny(const char* fill) {
-    if (!fill) return false;
-    if (strEq(fill, "black")) return true;
+static bool isBlackFillAny(std::string_view fill) {
+    if (fill.empty()) return false;
+    if (fill == "black") return true;
     int r, g, b;
     if (parseHexColor(fill, r, g, b)) return (r == 0 && g == 0 && b == 0);
     return false;
@@ -140,154 +137,230 @@ static void autoSpawnPlayers(SvgSceneData& out) {
     out.hasPlayer2 = true;
 }
 
-/* ===================== Fallback circle scanner ===================== */
-
-static bool readFileAll(const std::string& path, std::string& outText) {
-    std::FILE* f = std::fopen(path.c_str(), "rb");
-    if (!f) return false;
-    std::fseek(f, 0, SEEK_END);
-    long n = std::ftell(f);
-    if (n < 0) { std::fclose(f); return false; }
-    std::fseek(f, 0, SEEK_SET);
-    outText.resize((size_t)n);
-    if (n > 0) {
-        size_t rd = std::fread(&outText[0], 1, (size_t)n, f);
-        if (rd != (size_t)n) { std::fclose(f); return false; }
-    }
-    std::fclose(f);
-    return true;
+/* ===================== Attribute values ===================== */
+
+// Locale-independent float parse of a whole attribute value; trailing units
+// such as "px" are ignored, like strtof did.
+static bool parseFloatView(std::string_view v, float& out) {
+    v = trim(v);
+    if (!v.empty() && v.front() == '+') v.remove_prefix(1);
+    if (v.empty()) return false;
+    std::from_chars_result res = std::from_chars(v.data(), v.data() + v.size(), out);
+    return res.ec == std::errc() && res.ptr != v.data();
 }
 
-static bool extractAttrValue(const std::string& tag, const char* key, std::string& outVal) {
-    // looks for key="..."; key must be exact (e.g., cx, cy, r, fill, style)
-    std::string pat = std::string(key) + "=\"";
-    size_t p = tag.find(pat);
-    if (p == std::string::npos) return false;
-    p += pat.size();
-    size_t q = tag.find('"', p);
-    if (q == std::string::npos) return false;
-    outVal = tag.substr(p, q - p);
-    return true;
+static void classifyFill(std::string_view fill, CircleRaw& c) {
+    c.hasFill = !fill.empty();
+    c.isBlue  = isBlueFillAny(fill);
+    c.isGreen = isGreenFillAny(fill);
+    c.isRed   = isRedFillAny(fill);
+    c.isBlack = isBlackFillAny(fill);
 }
 
-static bool parseCircleTag(const std::string& tag, CircleRaw& outC) {
-    std::string cxS, cyS, rS;
-    if (!extractAttrValue(tag, "cx", cxS)) return false;
-    if (!extractAttrValue(tag, "cy", cyS)) return false;
-    if (!extractAttrValue(tag, "r", rS)) return false;
-
-    float cx = 0.0f, cy = 0.0f, rr = 0.0f;
-    if (!parseFloatLocal(cxS.c_str(), cx)) return false;
-    if (!parseFloatLocal(cyS.c_str(), cy)) return false;
-    if (!parseFloatLocal(rS.c_str(), rr)) return false;
-
-    std::string fillS;
-    bool hasFill = extractAttrValue(tag, "fill", fillS);
-
-    // style="...fill:...;"
-    if (!hasFill) {
-        std::string styleS;
-        if (extractAttrValue(tag, "style", styleS)) {
-            char tmp[64];
-            const char* f = extractFillFromStyle(styleS.c_str(), tmp, sizeof(tmp));
-            if (f) {
-                fillS = f;
-                hasFill = true;
+/* ===================== Transforms ===================== */
+
+// 2x3 affine matrix in SVG order: x' = a*x + c*y + e, y' = b*x + d*y + f.
+struct Affine {
+    float a, b, c, d, e, f;
+
+    static Affine identity() { return { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f }; }
+
+    // this * o: applies o first, then this.
+    Affine operator*(const Affine& o) const {
+        return { a * o.a + c * o.b,
+                 b * o.a + d * o.b,
+                 a * o.c + c * o.d,
+                 b * o.c + d * o.d,
+                 a * o.e + c * o.f + e,
+                 b * o.e + d * o.f + f };
+    }
+
+    Vec2 apply(float x, float y) const {
+        return Vec2(a * x + c * y + e, b * x + d * y + f);
+    }
+
+    // Uniform scale that preserves area; exact for similarity transforms and
+    // a reasonable circle radius under non-uniform scale or skew.
+    float radiusScale() const {
+        return std::sqrt(std::fabs(a * d - b * c));
+    }
+};
+
+// Parses a transform list such as "translate(10 20) rotate(45, 5, 5)".
+// Unknown functions make the whole attribute invalid.
+static bool parseTransform(std::string_view v, Affine& out) {
+    Affine m = Affine::identity();
+    size_t i = 0;
+    const size_t n = v.size();
+
+    while (true) {
+        while (i < n && (isSpace(v[i]) || v[i] == ',')) ++i;
+        if (i >= n) break;
+
+        size_t nameBegin = i;
+        while (i < n && std::isalpha((unsigned char)v[i])) ++i;
+        std::string_view fn = v.substr(nameBegin, i - nameBegin);
+        while (i < n && isSpace(v[i])) ++i;
+        if (fn.empty() || i >= n || v[i] != '(') return false;
+        ++i;
+
+        float args[6];
+        int argc = 0;
+        while (true) {
+            while (i < n && (isSpace(v[i]) || v[i] == ',')) ++i;
+            if (i >= n) return false;
+            if (v[i] == ')') { ++i; break; }
+            if (argc == 6) return false;
+            if (v[i] == '+') ++i;
+            std::from_chars_result res = std::from_chars(v.data() + i, v.data() + n, args[argc]);
+            if (res.ec != std::errc() || res.ptr == v.data() + i) return false;
+            i = size_t(res.ptr - v.data());
+            ++argc;
+        }
+
+        const float degToRad = 3.14159265358979f / 180.0f;
+        Affine t = Affine::identity();
+        if (fn == "matrix" && argc == 6) {
+            t = { args[0], args[1], args[2], args[3], args[4], args[5] };
+        } else if (fn == "translate" && (argc == 1 || argc == 2)) {
+            t.e = args[0];
+            t.f = (argc == 2) ? args[1] : 0.0f;
+        } else if (fn == "scale" && (argc == 1 || argc == 2)) {
+            t.a = args[0];
+            t.d = (argc == 2) ? args[1] : args[0];
+        } else if (fn == "rotate" && (argc == 1 || argc == 3)) {
+            float cr = std::cos(args[0] * degToRad);
+            float sr = std::sin(args[0] * degToRad);
+            t = { cr, sr, -sr, cr, 0.0f, 0.0f };
+            if (argc == 3) {
+                Affine to = { 1.0f, 0.0f, 0.0f, 1.0f, args[1], args[2] };
+                Affine back = { 1.0f, 0.0f, 0.0f, 1.0f, -args[1], -args[2] };
+                t = to * t * back;
             }
+        } else if (fn == "skewX" && argc == 1) {
+            t.c = std::tan(args[0] * degToRad);
+        } else if (fn == "skewY" && argc == 1) {
+            t.b = std::tan(args[0] * degToRad);
+        } else {
+            return false;
         }
+        m = m * t;
     }
 
-    const char* fill = hasFill ? fillS.c_str() : nullptr;
-
-    outC.cx = cx;
-    outC.cy = cy;
-    outC.r  = rr;
-    outC.hasFill = hasFill;
-    outC.isBlue  = isBlueFillAny(fill);
-    outC.isGreen = isGreenFillAny(fill);
-    outC.isRed   = isRedFillAny(fill);
-    outC.isBlack = isBlackFillAny(fill);
+    out = m;
     return true;
 }
 
-static bool scanCirclesFromText(const std::string& text, std::vector<CircleRaw>& circles) {
-    size_t pos = 0;
-    while (true) {
-        size_t p = text.find("<circle", pos);
-        if (p == std::string::npos) break;
-        size_t q = text.find('>', p);
-        if (q == std::string::npos) break;
+/* ===================== Streaming scene builder ===================== */
+
+// Receives SAX events and keeps one small frame per open element: the
+// accumulated transform, the inherited fill and whether the subtree renders.
+// Circles are emitted as soon as their start tag is seen.
+class SceneBuilder : public XmlSaxHandler {
+public:
+    explicit SceneBuilder(std::vector<CircleRaw>& out)
+        : circles(out) {
+        Frame root = { Affine::identity(), std::string_view(), false };
+        stack.push_back(root);
+    }
+
+    void startElement(std::string_view name, const XmlAttribute* attrs, int attrCount, bool selfClosing) override {
+        const Frame& parent = stack.back();
+
+        std::string_view fillAttr, styleAttr, transformAttr, displayAttr;
+        std::string_view cxS, cyS, rS;
+        for (int i = 0; i < attrCount; ++i) {
+            std::string_view k = attrs[i].name;
+            if (k == "fill") fillAttr = attrs[i].value;
+            else if (k == "style") styleAttr = attrs[i].value;
+            else if (k == "transform") transformAttr = attrs[i].value;
+            else if (k == "display") displayAttr = attrs[i].value;
+            else if (k == "cx") cxS = attrs[i].value;
+            else if (k == "cy") cyS = attrs[i].value;
+            else if (k == "r") rS = attrs[i].value;
+        }
+
+        Frame f = parent;
 
-        std::string tag = text.substr(p, q - p + 1);
+        // CSS rules: a style property beats the presentation attribute.
+        std::string_view fill = trim(fillAttr);
+        std::string_view display = trim(displayAttr);
+        if (!styleAttr.empty()) {
+            std::string_view sf = trim(extractStyleProperty(styleAttr, "fill"));
+            std::string_view sd = trim(extractStyleProperty(styleAttr, "display"));
+            if (!sf.empty()) fill = sf;
+            if (!sd.empty()) display = sd;
+        }
+        if (!fill.empty() && fill != "inherit") f.fill = (fill == "none") ? std::string_view() : fill;
+
+        if (display == "none" || isNonRenderingContainer(name)) f.hidden = true;
 
-        CircleRaw c;
-        if (parseCircleTag(tag, c)) {
-            circles.push_back(c);
+        if (!transformAttr.empty()) {
+            Affine t;
+            if (parseTransform(transformAttr, t)) f.m = parent.m * t;
         }
 
-        pos = q + 1;
+        if (name == "circle" && !f.hidden) emitCircle(f, cxS, cyS, rS);
+
+        if (!selfClosing) stack.push_back(f);
     }
-    return !circles.empty();
-}
+
+    void endElement(std::string_view) override {
+        if (stack.size() > 1) stack.pop_back();
+    }
+
+private:
+    struct Frame {
+        Affine m;
+        std::string_view fill;
+        bool hidden;
+    };
+
+    static bool isNonRenderingContainer(std::string_view name) {
+        return name == "defs" || name == "symbol" || name == "clipPath" ||
+               name == "mask" || name == "pattern" || name == "marker";
+    }
+
+    void emitCircle(const Frame& f, std::string_view cxS, std::string_view cyS, std::string_view rS) {
+        // Missing cx/cy default to 0 as in SVG; r is required.
+        float cx = 0.0f, cy = 0.0f, rr = 0.0f;
+        if (!cxS.empty() && !parseFloatView(cxS, cx)) return;
+        if (!cyS.empty() && !parseFloatView(cyS, cy)) return;
+        if (!parseFloatView(rS, rr)) return;
+
+        Vec2 c = f.m.apply(cx, cy);
+        CircleRaw out;
+        out.cx = c.x;
+        out.cy = c.y;
+        out.r = rr * f.m.radiusScale();
+        classifyFill(f.fill, out);
+        circles.push_back(out);
+    }
+
+private:
+    std::vector<CircleRaw>& circles;
+    std::vector<Frame> stack;
+};
 
 /* ===================== Public API ===================== */
 
 bool SvgLoader::load(const std::string& path, SvgSceneData& out) {
     out = SvgSceneData();
 
-    XMLDocument doc;
-    const int rc = doc.LoadFile(path.c_str());
-    if (rc != tinyxml2::XML_SUCCESS) {
-        char buf[128];
-        std::snprintf(buf, sizeof(buf), "LoadFile failed rc=%d", rc);
-        dbgFail(path.c_str(), buf);
+    MappedFile file;
+    if (!file.open(path)) {
+        dbgFail(path.c_str(), "cannot open file");
         return false;
     }
 
-    const XMLElement* svg = doc.FirstChildElement("svg");
-
     std::vector<CircleRaw> circles;
     circles.reserve(64);
 
-    if (svg) {
-        // Normal path: traverse children (works for your original arena.svg)
-        for (const XMLElement* e = svg->FirstChildElement(); e; e = e->NextSiblingElement()) {
-            if (std::strcmp(e->Name(), "circle") == 0) {
-                float cx = 0.0f, cy = 0.0f, rr = 0.0f;
-                if (parseFloatLocal(e->Attribute("cx"), cx) &&
-                    parseFloatLocal(e->Attribute("cy"), cy) &&
-                    parseFloatLocal(e->Attribute("r"), rr)) {
-
-                    char tmp[64];
-                    const char* fill = e->Attribute("fill");
-                    if (!fill) {
-                        const char* style = e->Attribute("style");
-                        if (style) fill = extractFillFromStyle(style, tmp, sizeof(tmp));
-                    }
-
-                    CircleRaw c;
-                    c.cx = cx; c.cy = cy; c.r = rr;
-                    c.hasFill = (fill != nullptr);
-                    c.isBlue  = isBlueFillAny(fill);
-                    c.isGreen = isGreenFillAny(fill);
-                    c.isRed   = isRedFillAny(fill);
-                    c.isBlack = isBlackFillAny(fill);
-
-                    circles.push_back(c);
-                }
-            }
-        }
-    } else {
-        // Fallback path for your test_svgs: tinywml2 doc.FirstChildElement() is broken
-        std::string text;
-        if (!readFileAll(path, text)) {
-            dbgFail(path.c_str(), "fallback readFileAll failed");
-            return false;
-        }
-        if (!scanCirclesFromText(text, circles)) {
-            dbgFail(path.c_str(), "fallback scanCirclesFromText found no circles");
-            return false;
-        }
+    SceneBuilder builder(circles);
+    XmlSaxParser parser;
+    if (!parser.parse(file.view(), builder)) {
+        dbgFail(path.c_str(), parser.error().c_str());
+        return false;
     }
 
     if (circles.empty()) {
@@ -0,0 +1,152 @@
+#include "../../include/io/XmlSaxParser.h"
+
+#include <cstdio>
+#include <cstring>
+
+XmlSaxHandler::~XmlSaxHandler() {}
+
+static bool isXmlSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool isNameEnd(char c) {
+    return isXmlSpace(c) || c == '/' || c == '>' || c == '=';
+}
+
+XmlSaxParser::XmlSaxParser() {}
+
+const std::string& XmlSaxParser::error() const {
+    return err;
+}
+
+bool XmlSaxParser::fail(std::string_view text, size_t pos, const char* msg) {
+    // Line numbers are only computed on the error path.
+    int line = 1;
+    for (size_t i = 0; i < pos && i < text.size(); ++i) {
+        if (text[i] == '\n') ++line;
+    }
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "line %d: %s", line, msg);
+    err = buf;
+    return false;
+}
+
+bool XmlSaxParser::parse(std::string_view text, XmlSaxHandler& handler) {
+    err.clear();
+    openElements.clear();
+
+    const size_t n = text.size();
+    size_t i = 0;
+    bool sawRoot = false;
+
+    while (i < n) {
+        // Character data: jump straight to the next markup.
+        const void* lt = std::memchr(text.data() + i, '<', n - i);
+        if (!lt) break;
+        i = size_t(static_cast<const char*>(lt) - text.data());
+
+        std::string_view rest = text.substr(i);
+
+        if (rest.compare(0, 4, "<!--") == 0) {
+            size_t e = text.find("-->", i + 4);
+            if (e == std::string_view::npos) return fail(text, i, "unterminated comment");
+            i = e + 3;
+            continue;
+        }
+        if (rest.compare(0, 9, "<![CDATA[") == 0) {
+            size_t e = text.find("]]>", i + 9);
+            if (e == std::string_view::npos) return fail(text, i, "unterminated CDATA section");
+            i = e + 3;
+            continue;
+        }
+        if (rest.compare(0, 2, "<?") == 0) {
+            size_t e = text.find("?>", i + 2);
+            if (e == std::string_view::npos) return fail(text, i, "unterminated processing instruction");
+            i = e + 2;
+            continue;
+        }
+        if (rest.compare(0, 2, "<!") == 0) {
+            // DOCTYPE and friends; may carry an internal subset in [...].
+            int bracket = 0;
+            size_t j = i + 2;
+            for (; j < n; ++j) {
+                if (text[j] == '[') ++bracket;
+                else if (text[j] == ']') --bracket;
+                else if (text[j] == '>' && bracket <= 0) break;
+            }
+            if (j >= n) return fail(text, i, "unterminated declaration");
+            i = j + 1;
+            continue;
+        }
+
+        if (rest.compare(0, 2, "</") == 0) {
+            size_t j = i + 2;
+            size_t nameBegin = j;
+            while (j < n && !isNameEnd(text[j])) ++j;
+            std::string_view name = text.substr(nameBegin, j - nameBegin);
+            while (j < n && isXmlSpace(text[j])) ++j;
+            if (j >= n || text[j] != '>') return fail(text, i, "malformed end tag");
+
+            if (openElements.empty() || openElements.back() != name) {
+                return fail(text, i, "end tag does not match the open element");
+            }
+            openElements.pop_back();
+            handler.endElement(name);
+            i = j + 1;
+            continue;
+        }
+
+        // Start tag.
+        size_t j = i + 1;
+        size_t nameBegin = j;
+        while (j < n && !isNameEnd(text[j])) ++j;
+        std::string_view name = text.substr(nameBegin, j - nameBegin);
+        if (name.empty()) return fail(text, i, "missing element name");
+        if (sawRoot && openElements.empty()) return fail(text, i, "content after the root element");
+
+        attrs.clear();
+        bool selfClosing = false;
+        bool closed = false;
+
+        while (j < n) {
+            while (j < n && isXmlSpace(text[j])) ++j;
+            if (j >= n) break;
+
+            if (text[j] == '>') { closed = true; ++j; break; }
+            if (text[j] == '/') {
+                if (j + 1 < n && text[j + 1] == '>') { selfClosing = true; closed = true; j += 2; break; }
+                return fail(text, j, "stray '/' in tag");
+            }
+
+            size_t attrBegin = j;
+            while (j < n && !isNameEnd(text[j])) ++j;
+            std::string_view attrName = text.substr(attrBegin, j - attrBegin);
+            if (attrName.empty()) return fail(text, j, "malformed attribute");
+
+            while (j < n && isXmlSpace(text[j])) ++j;
+            if (j >= n || text[j] != '=') return fail(text, j, "attribute without value");
+            ++j;
+            while (j < n && isXmlSpace(text[j])) ++j;
+            if (j >= n || (text[j] != '"' && text[j] != '\'')) return fail(text, j, "unquoted attribute value");
+
+            char quote = text[j++];
+            size_t valueBegin = j;
+            const void* q = std::memchr(text.data() + j, quote, n - j);
+            if (!q) return fail(text, valueBegin, "unterminated attribute value");
+            j = size_t(static_cast<const char*>(q) - text.data());
+
+            attrs.push_back({ attrName, text.substr(valueBegin, j - valueBegin) });
+            ++j;
+        }
+        if (!closed) return fail(text, i, "unterminated start tag");
+
+        sawRoot = true;
+        handler.startElement(name, attrs.data(), int(attrs.size()), selfClosing);
+        if (!selfClosing) openElements.push_back(name);
+        i = j;
+    }
+
+    if (!openElements.empty()) return fail(text, n, "unexpected end of document (unclosed elements)");
+    if (!sawRoot) return fail(text, n, "no root element");
+    return true;
+}
@@ -1,43 +1,150 @@
 #include <GL/glut.h>
 #include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
+#include "../include/game/Camera.h"
 #include "../include/game/Game.h"
+#include "../include/game/FixedStepClock.h"
+#include "../include/game/GlRenderBackend.h"
+#include "../include/game/Renderer.h"
+#include "../include/io/InputRecording.h"
+#include "../include/io/SceneCache.h"
+#include "../include/net/NetClient.h"
+#include "../include/util/Profiler.h"
+
+// Simulation rate is fixed; rendering runs as fast as GLUT idles and
+// interpolates between the last two simulation steps.
+static const float kSimHz = 60.0f;
+static const int kMaxCatchUpSteps = 5;
 
 static Game game;
+static FixedStepClock simClock(1.0f / kSimHz, kMaxCatchUpSteps);
+static GlRenderBackend glBackend;
 
 static int windowWidth = 500;
 static int windowHeight = 500;
 
+// Whole arena by default; Page Up/Down or the wheel zoom, F5 follows player 1.
+static Camera camera;
+static const float kZoomStep = 1.25f;
+
 static std::chrono::steady_clock::time_point lastTime;
 
-static void applyCamera() {
-    const Arena& a = game.getArena();
+// --record: per-tick input of this session, saved when the program exits.
+static InputRecorder recorder;
+static std::string recordPath;
+static unsigned recordedResets = 0;
+static uint64_t lastStepHash = 0;
+
+// --connect: thin client of a trabalhocg_server. The local game only holds the
+// map and collects input; what is drawn comes from the server's snapshots.
+static NetClient netClient;
+static bool networked = false;
+static NetView netView;
 
-    float left = a.center.x - a.radius;
-    float right = a.center.x + a.radius;
-    float top = a.center.y - a.radius;
-    float bottom = a.center.y + a.radius;
+// --profile / F3: phase timers and overlay; F4 or exit writes
+// <prefix>.csv and <prefix>.trace.json.
+static std::string profilePrefix = "profile";
+
+// Window title shows frame rate and vertices per frame, refreshed once a second.
+static std::chrono::steady_clock::time_point statsTime;
+static int statsFrames = 0;
+
+// Player 1 where it is drawn this frame: interpolated locally, or as last
+// sampled from the server.
+static Vec2 followTarget() {
+    if (networked) {
+        return netView.players.empty() ? game.getArena().center : netView.players[0].pos;
+    }
+    const PlayerStore& players = game.getPlayers();
+    if (players.size() == 0) return game.getArena().center;
+    float t = simClock.alpha();
+    return Vec2(players.prevX()[0] + (players.posX()[0] - players.prevX()[0]) * t,
+                players.prevY()[0] + (players.posY()[0] - players.prevY()[0]) * t);
+}
+
+// Runs every frame, since a following camera moves with the player.
+static void applyCamera() {
+    camera.setViewport(windowWidth, windowHeight);
+    camera.update(game.getArena(), followTarget());
+    const Rect& v = camera.view();
 
     glViewport(0, 0, windowWidth, windowHeight);
+    Renderer::setPixelsPerUnit(camera.pixelsPerUnit());
+    Renderer::setViewRect(camera.cullRect());
 
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
 
     // SVG-like coordinates: y grows downward
-    gluOrtho2D(left, right, bottom, top);
+    gluOrtho2D(v.minX, v.maxX, v.maxY, v.minY);
 
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
 }
 
+static void updateWindowStats() {
+    ++statsFrames;
+    auto now = std::chrono::steady_clock::now();
+    float elapsed = std::chrono::duration<float>(now - statsTime).count();
+    if (elapsed < 1.0f) return;
+
+    char title[128];
+    std::snprintf(title, sizeof(title), "Trabalho CG 2D - %.0f fps, %ld verts, %ld draws/frame",
+                  float(statsFrames) / elapsed, Renderer::verticesThisFrame(),
+                  Renderer::drawCallsThisFrame());
+    glutSetWindowTitle(title);
+
+    statsFrames = 0;
+    statsTime = now;
+}
+
+static void renderNetView() {
+    const Arena& arena = game.getArena();
+    Renderer::drawStaticLayer(arena, game.getObstacles(), game.getObstacleGrid(), game.getStaticLayerVersion());
+    if (!netClient.sample(Net::nowMicros(), netView)) return;
+
+    for (const Player& p : netView.players) {
+        if (p.lives > 0) Renderer::drawPlayer(p);
+    }
+    for (const Bullet& b : netView.bullets) Renderer::drawBullet(b);
+
+    int livesP1 = netView.players.size() > 0 ? netView.players[0].lives : 0;
+    int livesP2 = netView.players.size() > 1 ? netView.players[1].lives : 0;
+    Renderer::drawHud(arena, livesP1, livesP2);
+    if (!netView.running) Renderer::drawGameOver(arena, netView.winnerId);
+    Renderer::drawProfileOverlay(arena);
+}
+
 static void displayCallback() {
     glClear(GL_COLOR_BUFFER_BIT);
-    glLoadIdentity();
+    applyCamera();
 
-    game.render();
+    Renderer::beginFrame();
+    if (networked) renderNetView();
+    else game.render(glBackend, simClock.alpha());
+    Renderer::endFrame();
 
     glutSwapBuffers();
+    Profiler::frameMark();
+    updateWindowStats();
+}
+
+static void idleNetworked(int steps) {
+    uint64_t now = Net::nowMicros();
+    netClient.poll(now);
+    if (netClient.status() == NetClient::Status::FAILED) {
+        std::fprintf(stderr, "Error: %s\n", netClient.error().c_str());
+        std::exit(1);
+    }
+    // Whatever the local keys are, they steer the player the server assigned.
+    for (int i = 0; i < steps; ++i) {
+        netClient.sendCommand(player1Command(game.getInput(), game.getViewportWidth()), now);
+    }
+    glutPostRedisplay();
 }
 
 static void idleCallback() {
@@ -45,7 +152,22 @@ static void idleCallback() {
     float dt = std::chrono::duration<float>(now - lastTime).count();
     lastTime = now;
 
-    game.update(dt);
+    int steps = simClock.advance(dt);
+    if (networked) {
+        idleNetworked(steps);
+        return;
+    }
+    for (int i = 0; i < steps; ++i) {
+        if (!recordPath.empty()) {
+            // A reset from the 'r' key happens between steps and clears the
+            // input, so it is recorded as its own flag.
+            bool reset = game.getResetCount() != recordedResets;
+            recordedResets = game.getResetCount();
+            recorder.record(game.getInput(), game.getViewportWidth(), reset);
+        }
+        game.update(simClock.step());
+        if (!recordPath.empty()) lastStepHash = game.stateHash();
+    }
 
     glutPostRedisplay();
 }
@@ -53,6 +175,7 @@ static void idleCallback() {
 static void reshapeCallback(int w, int h) {
     windowWidth = w;
     windowHeight = h;
+    game.setViewportSize(w, h);
     applyCamera();
 }
 
@@ -64,7 +187,41 @@ static void keyUpCallback(unsigned char key, int, int) {
     game.onKeyUp(key);
 }
 
+static void dumpProfile() {
+    if (Profiler::totalEvents() == 0) return;
+    std::string csv = profilePrefix + ".csv";
+    std::string trace = profilePrefix + ".trace.json";
+    if (Profiler::writeCsv(csv) && Profiler::writeChromeTrace(trace)) {
+        std::printf("Profile written to '%s' and '%s'\n", csv.c_str(), trace.c_str());
+    } else {
+        std::fprintf(stderr, "Error: failed to write profile '%s'\n", profilePrefix.c_str());
+    }
+}
+
 static void specialKeyDownCallback(int key, int, int) {
+    if (key == GLUT_KEY_F3) {
+        bool on = !Profiler::isEnabled();
+        Profiler::setEnabled(on);
+        Renderer::setProfileOverlay(on);
+        return;
+    }
+    if (key == GLUT_KEY_F4) {
+        dumpProfile();
+        return;
+    }
+    if (key == GLUT_KEY_F5) {
+        camera.setFollow(!camera.isFollowing());
+        return;
+    }
+    if (key == GLUT_KEY_PAGE_UP || key == GLUT_KEY_PAGE_DOWN) {
+        camera.zoomBy(key == GLUT_KEY_PAGE_UP ? kZoomStep : 1.0f / kZoomStep);
+        return;
+    }
+    if (key == GLUT_KEY_HOME) {
+        camera.setZoom(1.0f);
+        camera.setFollow(false);
+        return;
+    }
     game.onSpecialKeyDown(key);
 }
 
@@ -72,9 +229,12 @@ static void specialKeyUpCallback(int key, int, int) {
     game.onSpecialKeyUp(key);
 }
 
+// freeglut reports the wheel as buttons 3 (up) and 4 (down).
 static void mouseButtonCallback(int button, int state, int /*x*/, int /*y*/) {
     if (button == GLUT_LEFT_BUTTON) {
         game.onMouseClick(state == GLUT_DOWN);
+    } else if ((button == 3 || button == 4) && state == GLUT_DOWN) {
+        camera.zoomBy(button == 3 ? kZoomStep : 1.0f / kZoomStep);
     }
 }
 
@@ -82,17 +242,94 @@ static void mouseMoveCallback(int x, int y) {
     game.onMouseMove(x, y);
 }
 
+static void saveRecording() {
+    if (recorder.ticks() == 0) return;
+    if (recorder.save(recordPath, lastStepHash)) {
+        std::printf("Recorded %llu ticks (%zu bytes of input) to '%s'\n",
+                    (unsigned long long)recorder.ticks(), recorder.body().size(), recordPath.c_str());
+    } else {
+        std::fprintf(stderr, "Error: failed to write recording '%s'\n", recordPath.c_str());
+    }
+}
+
+static void disconnectNetClient() {
+    const NetClientReport& r = netClient.report();
+    netClient.disconnect(Net::nowMicros());
+    if (r.latencyMs.empty()) return;
+
+    double sum = 0.0;
+    for (float ms : r.latencyMs) sum += ms;
+    std::printf("Received %llu snapshots (%.1f kB); mean input latency %.1f ms\n",
+                (unsigned long long)r.snapshots, double(r.bytesReceived) / 1024.0,
+                sum / double(r.latencyMs.size()));
+}
+
 int main(int argc, char** argv) {
-    if (argc < 2) {
-        std::fprintf(stderr, "Usage: %s <path-to-svg>\n", argv[0]);
+    const char* svgPath = nullptr;
+    const char* connectTo = nullptr;
+    float lossPct = 0.0f;
+    int latencyMs = 0;
+    int jitterMs = 0;
+    Renderer::setBackend(&glBackend);
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--immediate") == 0) glBackend.setBatching(false);
+        else if (std::strcmp(argv[i], "--record") == 0 && hasValue) recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--connect") == 0 && hasValue) connectTo = argv[++i];
+        else if (std::strcmp(argv[i], "--loss") == 0 && hasValue) lossPct = float(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--latency") == 0 && hasValue) latencyMs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--jitter") == 0 && hasValue) jitterMs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--profile") == 0) Profiler::setEnabled(true);
+        else if (std::strcmp(argv[i], "--profile-out") == 0 && hasValue) profilePrefix = argv[++i];
+        else svgPath = argv[i];
+    }
+
+    if (!svgPath) {
+        std::fprintf(stderr,
+                     "Usage: %s [--immediate] [--record out.rec] [--profile] [--profile-out prefix] <path-to-svg>\n"
+                     "       %s --connect host[:port] [--loss PCT] [--latency MS] [--jitter MS] <path-to-svg>\n",
+                     argv[0], argv[0]);
         return 1;
     }
 
-    if (!game.loadFromSvg(argv[1])) {
-        std::fprintf(stderr, "Error: failed to load SVG scene from '%s'\n", argv[1]);
+    if (!game.loadFromSvg(svgPath)) {
+        std::fprintf(stderr, "Error: failed to load SVG scene from '%s'\n", svgPath);
         return 1;
     }
 
+    Renderer::setProfileOverlay(Profiler::isEnabled());
+    std::atexit(dumpProfile);
+
+    if (connectTo) {
+        NetAddress server;
+        if (!NetAddress::parse(connectTo, Net::kDefaultPort, server)) {
+            std::fprintf(stderr, "Error: cannot resolve '%s'\n", connectTo);
+            return 1;
+        }
+        uint64_t mapHash = 0;
+        SceneCache::hashFile(svgPath, mapHash);
+
+        std::string error;
+        netClient.link().configure(lossPct / 100.0f, latencyMs, jitterMs);
+        if (!netClient.connect(server, mapHash, error)) {
+            std::fprintf(stderr, "Error: %s\n", error.c_str());
+            return 1;
+        }
+        networked = true;
+        recordPath.clear();
+        std::atexit(disconnectNetClient);
+    }
+
+    if (!recordPath.empty()) {
+        uint64_t mapHash = 0;
+        SceneCache::hashFile(svgPath, mapHash);
+        recorder.begin(uint32_t(kSimHz), mapHash);
+        recordedResets = game.getResetCount();
+        lastStepHash = game.stateHash();
+        // GLUT leaves its main loop through exit() when the window closes.
+        std::atexit(saveRecording);
+    }
+
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
     glutInitWindowSize(windowWidth, windowHeight);
@@ -117,6 +354,8 @@ int main(int argc, char** argv) {
     glutPassiveMotionFunc(mouseMoveCallback);
 
     lastTime = std::chrono::steady_clock::now();
+    statsTime = lastTime;
+    game.setViewportSize(windowWidth, windowHeight);
     applyCamera();
 
     glutMainLoop();
@@ -26,4 +26,36 @@ bool circleHitsObstacle(const Vec2& p, float r, const Obstacle& ob) {
     return circleCircle(p, r, ob.pos, ob.radius);
 }
 
+bool sweepCircleCircle(const Vec2& p0, const Vec2& p1, float r, const Vec2& c, float cr, float& t) {
+    // Solve |m + d t| = R for the first root, with m = p0 - c and d = p1 - p0.
+    Vec2 m = p0 - c;
+    Vec2 d = p1 - p0;
+    float R = r + cr;
+
+    float k = m.lengthSq() - R * R;
+    if (k <= 0.0f) {
+        t = 0.0f;
+        return true;
+    }
+
+    float b = Vec2::dot(m, d);
+    if (b >= 0.0f) return false;  // moving away (or not at all)
+
+    float a = d.lengthSq();
+    float disc = b * b - a * k;
+    if (disc < 0.0f) return false;
+
+    float root = (-b - std::sqrt(disc)) / a;
+    if (root > 1.0f) return false;
+
+    t = root;
+    return true;
+}
+
+bool sweepCircles(const Vec2& a0, const Vec2& a1, float ar,
+                  const Vec2& b0, const Vec2& b1, float br, float& t) {
+    // Work in b's frame: b stays at b0 and a moves by the relative displacement.
+    return sweepCircleCircle(a0, a1 - (b1 - b0), ar, b0, br, t);
+}
+
 }
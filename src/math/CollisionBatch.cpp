@@ -0,0 +1,257 @@
+#include "../../include/math/Collision.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define COLLISION_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+// Wide versions of Collision::sweepCircleCircle. The lanes run exactly the
+// scalar arithmetic (no FMA: the AVX2 kernel is compiled for "avx2" only,
+// and the Makefile builds everything with -ffp-contract=off so the scalar
+// path is not contracted either, even with -march=native), so hit times match
+// to the bit and the simulation stays deterministic whichever kernel runs.
+
+namespace Collision {
+
+namespace {
+
+typedef int (*SweepFirstFn)(const Vec2& p0, const Vec2& p1, float r, const CircleSpan& c, float& t);
+
+// Scalar tail shared by every kernel: circles [begin, count).
+int sweepFirstScalarFrom(const Vec2& p0, const Vec2& p1, float r, const CircleSpan& c,
+                         int begin, int best, float& bestT) {
+    for (int i = begin; i < c.count; ++i) {
+        float t;
+        if (sweepCircleCircle(p0, p1, r, Vec2(c.x[i], c.y[i]), c.r[i], t) && (best < 0 || t < bestT)) {
+            best = i;
+            bestT = t;
+        }
+    }
+    return best;
+}
+
+int sweepFirstScalar(const Vec2& p0, const Vec2& p1, float r, const CircleSpan& c, float& t) {
+    float bestT = 0.0f;
+    int best = sweepFirstScalarFrom(p0, p1, r, c, 0, -1, bestT);
+    if (best >= 0) t = bestT;
+    return best;
+}
+
+#ifdef COLLISION_BATCH_X86
+
+/* ===================== 4 lanes (SSE2) ===================== */
+
+// Four 2D points in SoA registers.
+struct Vec2x4 {
+    __m128 x;
+    __m128 y;
+};
+
+inline Vec2x4 sub4(const Vec2x4& a, const Vec2x4& b) {
+    return { _mm_sub_ps(a.x, b.x), _mm_sub_ps(a.y, b.y) };
+}
+
+inline __m128 dot4(const Vec2x4& a, const Vec2x4& b) {
+    return _mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y));
+}
+
+// Four-wide blocks over circles [begin, count), then the scalar tail.
+int sweepFirstSseFrom(const Vec2& p0, const Vec2& p1, float r, const CircleSpan& c,
+                      int begin, int best, float& bestT) {
+    const Vec2 dScalar = p1 - p0;
+    const float aScalar = dScalar.lengthSq();
+
+    const Vec2x4 start = { _mm_set1_ps(p0.x), _mm_set1_ps(p0.y) };
+    const Vec2x4 d = { _mm_set1_ps(dScalar.x), _mm_set1_ps(dScalar.y) };
+    const __m128 a = _mm_set1_ps(aScalar);
+    const __m128 rr = _mm_set1_ps(r);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    int i = begin;
+    for (; i + 4 <= c.count; i += 4) {
+        const Vec2x4 center = { _mm_loadu_ps(c.x + i), _mm_loadu_ps(c.y + i) };
+        const Vec2x4 m = sub4(start, center);
+        const __m128 R = _mm_add_ps(rr, _mm_loadu_ps(c.r + i));
+
+        const __m128 k = _mm_sub_ps(dot4(m, m), _mm_mul_ps(R, R));
+        const __m128 b = dot4(m, d);
+        const __m128 disc = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(a, k));
+        const __m128 root = _mm_div_ps(_mm_sub_ps(_mm_xor_ps(b, signBit), _mm_sqrt_ps(disc)), a);
+
+        const __m128 overlap = _mm_cmple_ps(k, zero);
+        const __m128 ahead = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(b, zero), _mm_cmpge_ps(disc, zero)),
+                                        _mm_cmple_ps(root, one));
+        const __m128 hit = _mm_or_ps(overlap, ahead);
+        if (_mm_movemask_ps(hit) == 0) continue;
+
+        // Overlapping lanes hit at 0; misses are pushed to infinity.
+        __m128 tv = _mm_or_ps(_mm_and_ps(overlap, zero), _mm_andnot_ps(overlap, root));
+        tv = _mm_or_ps(_mm_and_ps(hit, tv), _mm_andnot_ps(hit, inf));
+
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, tv);
+        int mask = _mm_movemask_ps(hit);
+        for (int l = 0; l < 4; ++l) {
+            if ((mask & (1 << l)) && (best < 0 || lanes[l] < bestT)) {
+                best = i + l;
+                bestT = lanes[l];
+            }
+        }
+    }
+
+    return sweepFirstScalarFrom(p0, p1, r, c, i, best, bestT);
+}
+
+int sweepFirstSse(const Vec2& p0, const Vec2& p1, float r, const CircleSpan& c, float& t) {
+    float bestT = 0.0f;
+    int best = sweepFirstSseFrom(p0, p1, r, c, 0, -1, bestT);
+    if (best >= 0) t = bestT;
+    return best;
+}
+
+/* ===================== 8 lanes (AVX2) ===================== */
+
+struct Vec2x8 {
+    __m256 x;
+    __m256 y;
+};
+
+__attribute__((target("avx2"))) inline Vec2x8 sub8(const Vec2x8& a, const Vec2x8& b) {
+    return { _mm256_sub_ps(a.x, b.x), _mm256_sub_ps(a.y, b.y) };
+}
+
+__attribute__((target("avx2"))) inline __m256 dot8(const Vec2x8& a, const Vec2x8& b) {
+    return _mm256_add_ps(_mm256_mul_ps(a.x, b.x), _mm256_mul_ps(a.y, b.y));
+}
+
+__attribute__((target("avx2")))
+int sweepFirstAvx2(const Vec2& p0, const Vec2& p1, float r, const CircleSpan& c, float& t) {
+    const Vec2 dScalar = p1 - p0;
+    const float aScalar = dScalar.lengthSq();
+
+    const Vec2x8 start = { _mm256_set1_ps(p0.x), _mm256_set1_ps(p0.y) };
+    const Vec2x8 d = { _mm256_set1_ps(dScalar.x), _mm256_set1_ps(dScalar.y) };
+    const __m256 a = _mm256_set1_ps(aScalar);
+    const __m256 rr = _mm256_set1_ps(r);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    int best = -1;
+    float bestT = 0.0f;
+    int i = 0;
+    for (; i + 8 <= c.count; i += 8) {
+        const Vec2x8 center = { _mm256_loadu_ps(c.x + i), _mm256_loadu_ps(c.y + i) };
+        const Vec2x8 m = sub8(start, center);
+        const __m256 R = _mm256_add_ps(rr, _mm256_loadu_ps(c.r + i));
+
+        const __m256 k = _mm256_sub_ps(dot8(m, m), _mm256_mul_ps(R, R));
+        const __m256 b = dot8(m, d);
+        const __m256 disc = _mm256_sub_ps(_mm256_mul_ps(b, b), _mm256_mul_ps(a, k));
+        const __m256 root = _mm256_div_ps(_mm256_sub_ps(_mm256_xor_ps(b, signBit), _mm256_sqrt_ps(disc)), a);
+
+        const __m256 overlap = _mm256_cmp_ps(k, zero, _CMP_LE_OQ);
+        const __m256 ahead = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(b, zero, _CMP_LT_OQ),
+                                                         _mm256_cmp_ps(disc, zero, _CMP_GE_OQ)),
+                                           _mm256_cmp_ps(root, one, _CMP_LE_OQ));
+        const __m256 hit = _mm256_or_ps(overlap, ahead);
+        const int mask = _mm256_movemask_ps(hit);
+        if (mask == 0) continue;
+
+        __m256 tv = _mm256_blendv_ps(root, zero, overlap);
+        tv = _mm256_blendv_ps(inf, tv, hit);
+
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, tv);
+        for (int l = 0; l < 8; ++l) {
+            if ((mask & (1 << l)) && (best < 0 || lanes[l] < bestT)) {
+                best = i + l;
+                bestT = lanes[l];
+            }
+        }
+    }
+
+    // Short spans and the remainder go through the four-wide path.
+    best = sweepFirstSseFrom(p0, p1, r, c, i, best, bestT);
+    if (best >= 0) t = bestT;
+    return best;
+}
+
+#endif // COLLISION_BATCH_X86
+
+/* ===================== Dispatch ===================== */
+
+struct Dispatch {
+    BatchLevel level;
+    SweepFirstFn sweepFirst;
+
+    Dispatch() : level(BatchLevel::SCALAR), sweepFirst(sweepFirstScalar) {
+        BatchLevel want = BatchLevel::AVX2;
+        if (const char* env = std::getenv("TRABALHOCG_SIMD")) {
+            if (std::strcmp(env, "scalar") == 0) want = BatchLevel::SCALAR;
+            else if (std::strcmp(env, "sse") == 0) want = BatchLevel::SSE;
+        }
+        while (!select(want) && want != BatchLevel::SCALAR) want = BatchLevel(int(want) - 1);
+    }
+
+    bool select(BatchLevel l) {
+        if (!batchLevelSupported(l)) return false;
+        level = l;
+        switch (l) {
+#ifdef COLLISION_BATCH_X86
+            case BatchLevel::SSE: sweepFirst = sweepFirstSse; break;
+            case BatchLevel::AVX2: sweepFirst = sweepFirstAvx2; break;
+#endif
+            default: sweepFirst = sweepFirstScalar; break;
+        }
+        return true;
+    }
+};
+
+Dispatch& dispatch() {
+    static Dispatch d;
+    return d;
+}
+
+} // namespace
+
+int sweepCircleFirst(const Vec2& p0, const Vec2& p1, float r, const CircleSpan& circles, float& t) {
+    return dispatch().sweepFirst(p0, p1, r, circles, t);
+}
+
+bool batchLevelSupported(BatchLevel level) {
+    switch (level) {
+        case BatchLevel::SCALAR: return true;
+#ifdef COLLISION_BATCH_X86
+        case BatchLevel::SSE: return __builtin_cpu_supports("sse2");
+        case BatchLevel::AVX2: return __builtin_cpu_supports("avx2");
+#endif
+        default: return false;
+    }
+}
+
+BatchLevel batchLevel() {
+    return dispatch().level;
+}
+
+bool setBatchLevel(BatchLevel level) {
+    return dispatch().select(level);
+}
+
+const char* batchLevelName(BatchLevel level) {
+    switch (level) {
+        case BatchLevel::SSE: return "sse";
+        case BatchLevel::AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+} // namespace Collision
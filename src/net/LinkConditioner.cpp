@@ -0,0 +1,68 @@
+#include "../../include/net/LinkConditioner.h"
+
+#include <algorithm>
+
+LinkConditioner::LinkConditioner(UdpSocket& socket, uint32_t seed)
+    : sock(socket),
+      rngState(seed ? seed : 1u),
+      loss(0.0f),
+      latencyUs(0),
+      jitterUs(0),
+      sentBytes(0),
+      sentPackets(0),
+      droppedPackets(0) {}
+
+void LinkConditioner::configure(float lossFraction, int latencyMs, int jitterMs) {
+    loss = std::max(0.0f, std::min(1.0f, lossFraction));
+    latencyUs = std::max(0, latencyMs) * 1000;
+    jitterUs = std::max(0, jitterMs) * 1000;
+}
+
+bool LinkConditioner::isIdeal() const {
+    return loss <= 0.0f && latencyUs == 0 && jitterUs == 0;
+}
+
+uint32_t LinkConditioner::nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+void LinkConditioner::send(const NetAddress& to, const uint8_t* data, size_t size, uint64_t nowUs) {
+    sentBytes += size;
+    ++sentPackets;
+
+    if (loss > 0.0f && float(nextRandom() >> 8) * (1.0f / 16777216.0f) < loss) {
+        ++droppedPackets;
+        return;
+    }
+
+    if (latencyUs == 0 && jitterUs == 0) {
+        sock.send(to, data, size);
+        return;
+    }
+
+    Pending p;
+    p.dueUs = nowUs + uint64_t(latencyUs);
+    if (jitterUs > 0) p.dueUs += nextRandom() % uint32_t(jitterUs + 1);
+    p.to = to;
+    p.data.assign(data, data + size);
+
+    auto at = std::upper_bound(queue.begin(), queue.end(), p.dueUs,
+                               [](uint64_t due, const Pending& q) { return due < q.dueUs; });
+    queue.insert(at, std::move(p));
+}
+
+void LinkConditioner::flush(uint64_t nowUs) {
+    size_t done = 0;
+    while (done < queue.size() && queue[done].dueUs <= nowUs) {
+        sock.send(queue[done].to, queue[done].data.data(), queue[done].data.size());
+        ++done;
+    }
+    queue.erase(queue.begin(), queue.begin() + done);
+}
+
+uint64_t LinkConditioner::bytesSent() const { return sentBytes; }
+uint64_t LinkConditioner::packetsSent() const { return sentPackets; }
+uint64_t LinkConditioner::packetsDropped() const { return droppedPackets; }
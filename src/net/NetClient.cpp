@@ -0,0 +1,285 @@
+#include "../../include/net/NetClient.h"
+#include "../../include/math/Angle.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const uint64_t kHelloRetryUs = 250000;
+const uint64_t kConnectTimeoutUs = 5000000;
+// Commands (and their send times) remembered for redundancy and latency.
+const size_t kCommandHistory = 256;
+
+float lerp(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+} // namespace
+
+NetView::NetView() : running(true), winnerId(0) {}
+
+NetClientReport::NetClientReport() : bytesReceived(0), snapshots(0), undecodable(0) {}
+
+NetClient::NetClient()
+    : conditioner(socket, 0xc1e47u),
+      expectedMapHash(0),
+      state(Status::IDLE),
+      helloSentUs(0),
+      connectStartUs(0),
+      ownEntity(-1),
+      simHz(60.0f),
+      snapshotInterval(1),
+      frames(Net::kFrameHistory),
+      newestTick(0),
+      oldestTick(0),
+      tickOffset(0.0),
+      haveOffset(false),
+      inputSeq(0),
+      lastAckedInput(0),
+      sentCommands(kCommandHistory),
+      sentTimes(kCommandHistory, 0),
+      recvBuf(Net::kMaxDatagram) {}
+
+bool NetClient::connect(const NetAddress& to, uint64_t mapHash, std::string& error) {
+    if (!socket.open(0, error)) return false;
+    server = to;
+    expectedMapHash = mapHash;
+    state = Status::CONNECTING;
+    helloSentUs = 0;
+    connectStartUs = Net::nowMicros();
+    poll(connectStartUs);
+    return true;
+}
+
+void NetClient::disconnect(uint64_t nowUs) {
+    if (state == Status::CONNECTED) {
+        uint8_t bye = Net::MSG_BYE;
+        // Straight out, so it is not lost in the conditioner queue.
+        socket.send(server, &bye, 1);
+    }
+    conditioner.flush(nowUs);
+    socket.close();
+    state = Status::IDLE;
+}
+
+NetClient::Status NetClient::status() const { return state; }
+const std::string& NetClient::error() const { return lastError; }
+int NetClient::entity() const { return ownEntity; }
+float NetClient::simulationRate() const { return simHz; }
+const Arena& NetClient::arena() const { return serverArena; }
+LinkConditioner& NetClient::link() { return conditioner; }
+const NetClientReport& NetClient::report() const { return stats; }
+
+/* ===================== Receiving ===================== */
+
+void NetClient::poll(uint64_t nowUs) {
+    if (state == Status::CONNECTING) {
+        if (nowUs - connectStartUs > kConnectTimeoutUs) {
+            state = Status::FAILED;
+            lastError = "no answer from " + server.toString();
+            return;
+        }
+        if (helloSentUs == 0 || nowUs - helloSentUs >= kHelloRetryUs) {
+            packet.clear();
+            Net::ByteWriter w(packet);
+            w.u8(Net::MSG_HELLO);
+            w.u32(Net::kProtocolVersion);
+            conditioner.send(server, packet.data(), packet.size(), nowUs);
+            helloSentUs = nowUs;
+        }
+    }
+
+    NetAddress from;
+    int n;
+    while ((n = socket.receive(from, recvBuf.data(), recvBuf.size())) > 0) {
+        if (from != server) continue;
+        stats.bytesReceived += uint64_t(n);
+
+        Net::ByteReader r(recvBuf.data(), size_t(n));
+        uint8_t type = r.u8();
+        if (type == Net::MSG_WELCOME && state == Status::CONNECTING) {
+            handleWelcome(r);
+        } else if (type == Net::MSG_SNAPSHOT && state == Status::CONNECTED) {
+            handleSnapshot(r, nowUs);
+        } else if (type == Net::MSG_BYE) {
+            state = Status::FAILED;
+            lastError = "server closed the connection";
+        }
+    }
+
+    conditioner.flush(nowUs);
+}
+
+void NetClient::handleWelcome(Net::ByteReader& r) {
+    uint32_t version = r.u32();
+    uint32_t e = r.u32();
+    float hz = r.f32();
+    uint32_t interval = r.u32();
+    uint64_t hash = r.u64();
+    float cx = r.f32();
+    float cy = r.f32();
+    float radius = r.f32();
+    if (!r.ok()) return;
+
+    if (version != Net::kProtocolVersion) {
+        state = Status::FAILED;
+        lastError = "protocol version mismatch";
+        return;
+    }
+    if (expectedMapHash != 0 && hash != expectedMapHash) {
+        state = Status::FAILED;
+        lastError = "server runs a different map";
+        return;
+    }
+
+    ownEntity = int(e);
+    simHz = std::max(1.0f, hz);
+    snapshotInterval = std::max(1, int(interval));
+    serverArena.center = Vec2(cx, cy);
+    serverArena.radius = radius;
+    quantizer = Net::Quantizer(serverArena);
+    state = Status::CONNECTED;
+}
+
+Net::WorldFrame* NetClient::slot(uint32_t tick) {
+    return &frames[(tick / uint32_t(snapshotInterval)) % Net::kFrameHistory];
+}
+
+const Net::WorldFrame* NetClient::frame(uint32_t tick) const {
+    if (tick == 0) return nullptr;
+    const Net::WorldFrame& f = frames[(tick / uint32_t(snapshotInterval)) % Net::kFrameHistory];
+    return (f.tick == tick) ? &f : nullptr;
+}
+
+void NetClient::handleSnapshot(Net::ByteReader& r, uint64_t nowUs) {
+    uint32_t tick = r.u32();
+    uint32_t baseTick = r.u32();
+    uint32_t appliedSeq = r.u32();
+    uint8_t matchState = r.u8();
+    uint16_t winner = r.u16();
+    if (!r.ok() || tick == 0 || frame(tick)) return;
+    // Too old to keep: it would overwrite a newer slot.
+    if (newestTick >= uint32_t(Net::kFrameHistory * snapshotInterval) &&
+        tick <= newestTick - uint32_t(Net::kFrameHistory * snapshotInterval)) {
+        return;
+    }
+
+    const Net::WorldFrame* base = nullptr;
+    if (baseTick != 0) {
+        base = frame(baseTick);
+        if (!base) {
+            ++stats.undecodable;
+            return;
+        }
+    }
+
+    // Decode aside first: the baseline may live in the slot being replaced.
+    Net::WorldFrame decoded;
+    if (!Net::decodeFrame(r, base, decoded)) return;
+    decoded.tick = tick;
+    decoded.state = matchState;
+    decoded.winner = winner;
+    *slot(tick) = std::move(decoded);
+    ++stats.snapshots;
+
+    if (tick > newestTick) newestTick = tick;
+    uint32_t window = uint32_t(Net::kFrameHistory * snapshotInterval);
+    oldestTick = (newestTick > window) ? newestTick - window + uint32_t(snapshotInterval) : 1;
+
+    double sampleOffset = double(nowUs) * 1e-6 * double(simHz) - double(tick);
+    if (!haveOffset || sampleOffset < tickOffset) {
+        tickOffset = sampleOffset;
+        haveOffset = true;
+    } else {
+        // Let the estimate drift up slowly in case the path got longer.
+        tickOffset += (sampleOffset - tickOffset) * 0.01;
+    }
+
+    if (appliedSeq > lastAckedInput && appliedSeq <= inputSeq && inputSeq - appliedSeq < kCommandHistory) {
+        uint64_t sentAt = sentTimes[appliedSeq % kCommandHistory];
+        if (sentAt != 0 && nowUs >= sentAt) stats.latencyMs.push_back(float(nowUs - sentAt) * 1e-3f);
+        lastAckedInput = appliedSeq;
+    }
+}
+
+/* ===================== Sending ===================== */
+
+void NetClient::sendCommand(const PlayerCommand& cmd, uint64_t nowUs) {
+    if (state != Status::CONNECTED) return;
+
+    ++inputSeq;
+    sentCommands[inputSeq % kCommandHistory] = cmd;
+    sentTimes[inputSeq % kCommandHistory] = nowUs;
+
+    packet.clear();
+    Net::ByteWriter w(packet);
+    w.u8(Net::MSG_INPUT);
+    w.u32(inputSeq);
+    w.u32(newestTick);
+    int count = int(std::min<uint32_t>(inputSeq, Net::kInputRedundancy));
+    w.u8(uint8_t(count));
+    for (int i = 0; i < count; ++i) Net::writeCommand(w, sentCommands[(inputSeq - uint32_t(i)) % kCommandHistory]);
+
+    conditioner.send(server, packet.data(), packet.size(), nowUs);
+    conditioner.flush(nowUs);
+}
+
+/* ===================== Interpolation ===================== */
+
+double NetClient::serverTicks(uint64_t nowUs) const {
+    return double(nowUs) * 1e-6 * double(simHz) - tickOffset;
+}
+
+bool NetClient::sample(uint64_t nowUs, NetView& out) const {
+    if (newestTick == 0) return false;
+
+    // Two snapshot intervals behind leaves one spare when a packet is lost.
+    double renderTick = serverTicks(nowUs) - 2.0 * double(snapshotInterval);
+    renderTick = std::min(renderTick, double(newestTick));
+
+    // Bracketing frames a <= renderTick <= b, skipping lost ones.
+    const Net::WorldFrame* a = nullptr;
+    const Net::WorldFrame* b = nullptr;
+    for (uint32_t t = oldestTick - oldestTick % uint32_t(snapshotInterval); t <= newestTick; t += uint32_t(snapshotInterval)) {
+        const Net::WorldFrame* f = frame(t);
+        if (!f) continue;
+        if (double(t) <= renderTick) a = f;
+        else if (!b) b = f;
+    }
+    if (!a) {
+        a = b;
+        renderTick = double(a->tick);
+    }
+    if (!b) b = a;
+
+    float t = (b->tick > a->tick) ? float((renderTick - double(a->tick)) / double(b->tick - a->tick)) : 0.0f;
+    t = Angle::clamp(t, 0.0f, 1.0f);
+
+    out.running = (a->state == 0);
+    out.winnerId = a->winner;
+
+    out.players.clear();
+    for (int e = 0; e < a->playerCount(); ++e) {
+        Player p = quantizer.player(*a, e);
+        if (e < b->playerCount()) {
+            Player q = quantizer.player(*b, e);
+            p.pos = Vec2(lerp(p.pos.x, q.pos.x, t), lerp(p.pos.y, q.pos.y, t));
+            p.headingRad += Angle::wrapPi(q.headingRad - p.headingRad) * t;
+            p.armRelRad = lerp(p.armRelRad, q.armRelRad, t);
+            p.walkPhase += Angle::wrapPi(q.walkPhase - p.walkPhase) * t;
+        }
+        out.players.push_back(p);
+    }
+
+    // Bullets fly straight, so they are advanced along their velocity from
+    // the older frame rather than matched up between frames.
+    float since = float(renderTick - double(a->tick)) / simHz;
+    out.bullets.clear();
+    for (int i = 0; i < a->bulletCount(); ++i) {
+        Bullet bl = quantizer.bullet(*a, i);
+        bl.pos += bl.vel * since;
+        out.bullets.push_back(bl);
+    }
+    return true;
+}
@@ -0,0 +1,313 @@
+#include "../../include/net/NetProtocol.h"
+#include "../../include/game/Game.h"
+#include "../../include/math/Angle.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace Net {
+
+uint64_t nowMicros() {
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/* ===================== Byte streams ===================== */
+
+ByteWriter::ByteWriter(std::vector<uint8_t>& out) : buf(out) {}
+
+void ByteWriter::u8(uint8_t v) { buf.push_back(v); }
+
+void ByteWriter::u16(uint16_t v) {
+    buf.push_back(uint8_t(v));
+    buf.push_back(uint8_t(v >> 8));
+}
+
+void ByteWriter::u32(uint32_t v) {
+    for (int i = 0; i < 4; ++i) buf.push_back(uint8_t(v >> (8 * i)));
+}
+
+void ByteWriter::u64(uint64_t v) {
+    for (int i = 0; i < 8; ++i) buf.push_back(uint8_t(v >> (8 * i)));
+}
+
+void ByteWriter::f32(float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    u32(bits);
+}
+
+void ByteWriter::varint(uint64_t v) {
+    while (v >= 0x80) {
+        buf.push_back(uint8_t(v) | 0x80);
+        v >>= 7;
+    }
+    buf.push_back(uint8_t(v));
+}
+
+void ByteWriter::svarint(int64_t v) {
+    varint((uint64_t(v) << 1) ^ uint64_t(v >> 63));
+}
+
+ByteReader::ByteReader(const uint8_t* data, size_t n) : p(data), size(n), pos(0), good(true) {}
+
+uint8_t ByteReader::u8() {
+    if (pos >= size) { good = false; return 0; }
+    return p[pos++];
+}
+
+uint16_t ByteReader::u16() {
+    uint16_t v = u8();
+    return uint16_t(v | (uint16_t(u8()) << 8));
+}
+
+uint32_t ByteReader::u32() {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= uint32_t(u8()) << (8 * i);
+    return v;
+}
+
+uint64_t ByteReader::u64() {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= uint64_t(u8()) << (8 * i);
+    return v;
+}
+
+float ByteReader::f32() {
+    uint32_t bits = u32();
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+uint64_t ByteReader::varint() {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t b = u8();
+        if (!good) return 0;
+        v |= uint64_t(b & 0x7f) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    good = false;
+    return 0;
+}
+
+int64_t ByteReader::svarint() {
+    uint64_t v = varint();
+    return int64_t(v >> 1) ^ -int64_t(v & 1);
+}
+
+bool ByteReader::ok() const { return good; }
+bool ByteReader::atEnd() const { return pos >= size; }
+
+/* ===================== Commands ===================== */
+
+namespace {
+
+enum : uint8_t {
+    CMD_FORWARD = 1,
+    CMD_BACKWARD = 2,
+    CMD_LEFT = 4,
+    CMD_RIGHT = 8,
+    CMD_FIRE = 16,
+    CMD_AIM = 32
+};
+
+int16_t clampToI16(float v) {
+    return int16_t(std::max(-32767.0f, std::min(32767.0f, std::round(v))));
+}
+
+} // namespace
+
+void writeCommand(ByteWriter& w, const PlayerCommand& c) {
+    uint8_t flags = 0;
+    if (c.forward)   flags |= CMD_FORWARD;
+    if (c.backward)  flags |= CMD_BACKWARD;
+    if (c.turnLeft)  flags |= CMD_LEFT;
+    if (c.turnRight) flags |= CMD_RIGHT;
+    if (c.fire)      flags |= CMD_FIRE;
+    if (c.aim)       flags |= CMD_AIM;
+    w.u8(flags);
+    w.u16(uint16_t(std::round(Angle::clamp(c.aimFraction, 0.0f, 1.0f) * 65535.0f)));
+    w.u16(uint16_t(clampToI16(c.armRate * 1000.0f)));
+}
+
+PlayerCommand readCommand(ByteReader& r) {
+    PlayerCommand c;
+    uint8_t flags = r.u8();
+    c.forward   = (flags & CMD_FORWARD) != 0;
+    c.backward  = (flags & CMD_BACKWARD) != 0;
+    c.turnLeft  = (flags & CMD_LEFT) != 0;
+    c.turnRight = (flags & CMD_RIGHT) != 0;
+    c.fire      = (flags & CMD_FIRE) != 0;
+    c.aim       = (flags & CMD_AIM) != 0;
+    c.aimFraction = float(r.u16()) / 65535.0f;
+    c.armRate = float(int16_t(r.u16())) / 1000.0f;
+    return c;
+}
+
+/* ===================== World frames ===================== */
+
+WorldFrame::WorldFrame() : tick(0), state(0), winner(0) {}
+
+int WorldFrame::playerCount() const { return int(players.size() / kPlayerFields); }
+int WorldFrame::bulletCount() const { return int(bullets.size() / kBulletFields); }
+
+namespace {
+
+const float kCoordSteps = 32000.0f;
+const float kTwoPi = 6.28318530717958647692f;
+
+uint16_t quantizeAngle(float a) {
+    float t = a / kTwoPi;
+    t -= std::floor(t);
+    return uint16_t(uint32_t(t * 65536.0f) & 0xffffu);
+}
+
+float angleFrom(uint16_t q) {
+    return float(q) * (kTwoPi / 65536.0f);
+}
+
+uint16_t quantizeUnsigned(float v, float stepsPerUnit) {
+    return uint16_t(std::max(0.0f, std::min(65535.0f, std::round(v * stepsPerUnit))));
+}
+
+} // namespace
+
+Quantizer::Quantizer() : scale(1.0f) {}
+
+Quantizer::Quantizer(const Arena& a) : arena(a), scale(kCoordSteps / std::max(a.radius, 1e-3f)) {}
+
+uint16_t Quantizer::quantizeCoord(float v, float center) const {
+    return uint16_t(clampToI16((v - center) * scale));
+}
+
+Vec2 Quantizer::position(uint16_t qx, uint16_t qy) const {
+    return Vec2(arena.center.x + float(int16_t(qx)) / scale,
+                arena.center.y + float(int16_t(qy)) / scale);
+}
+
+void Quantizer::capture(const Game& game, uint32_t tick, WorldFrame& out) const {
+    out.tick = tick;
+    out.state = game.isRunning() ? 0 : 1;
+    out.winner = uint16_t(game.getWinnerId());
+
+    const PlayerStore& ps = game.getPlayers();
+    out.players.resize(size_t(ps.size()) * kPlayerFields);
+    for (int e = 0; e < ps.size(); ++e) {
+        Player p = ps.get(e);
+        uint16_t* f = &out.players[size_t(e) * kPlayerFields];
+        f[PF_X] = quantizeCoord(p.pos.x, arena.center.x);
+        f[PF_Y] = quantizeCoord(p.pos.y, arena.center.y);
+        f[PF_HEADING] = quantizeAngle(p.headingRad);
+        f[PF_ARM] = uint16_t(clampToI16(p.armRelRad * 10000.0f));
+        f[PF_PHASE] = quantizeAngle(p.walkPhase);
+        f[PF_RADIUS] = quantizeUnsigned(p.headRadius, 16.0f);
+        f[PF_LIVES] = uint16_t(std::max(0, std::min(65535, p.lives)));
+        f[PF_WALKING] = p.walking ? 1 : 0;
+    }
+
+    const BulletPool& bp = game.getBullets();
+    const float* bx = bp.posX();
+    const float* by = bp.posY();
+    const float* vx = bp.velX();
+    const float* vy = bp.velY();
+    const float* br = bp.radius();
+    const int* owner = bp.owner();
+    out.bullets.resize(size_t(bp.size()) * kBulletFields);
+    for (int i = 0; i < bp.size(); ++i) {
+        uint16_t* f = &out.bullets[size_t(i) * kBulletFields];
+        f[BF_X] = quantizeCoord(bx[i], arena.center.x);
+        f[BF_Y] = quantizeCoord(by[i], arena.center.y);
+        f[BF_VX] = uint16_t(clampToI16(vx[i] * 8.0f));
+        f[BF_VY] = uint16_t(clampToI16(vy[i] * 8.0f));
+        f[BF_RADIUS] = quantizeUnsigned(br[i], 16.0f);
+        f[BF_OWNER] = uint16_t(std::max(0, std::min(65535, owner[i])));
+    }
+}
+
+Player Quantizer::player(const WorldFrame& frame, int e) const {
+    const uint16_t* f = &frame.players[size_t(e) * kPlayerFields];
+    Player p;
+    p.setDefaults(PlayerId(e + 1));
+    p.pos = position(f[PF_X], f[PF_Y]);
+    p.headingRad = angleFrom(f[PF_HEADING]);
+    p.armRelRad = float(int16_t(f[PF_ARM])) / 10000.0f;
+    p.walkPhase = angleFrom(f[PF_PHASE]);
+    p.headRadius = float(f[PF_RADIUS]) / 16.0f;
+    p.lives = int(f[PF_LIVES]);
+    p.walking = f[PF_WALKING] != 0;
+    return p;
+}
+
+Bullet Quantizer::bullet(const WorldFrame& frame, int i) const {
+    const uint16_t* f = &frame.bullets[size_t(i) * kBulletFields];
+    Bullet b;
+    b.spawn(position(f[BF_X], f[BF_Y]),
+            Vec2(float(int16_t(f[BF_VX])) / 8.0f, float(int16_t(f[BF_VY])) / 8.0f),
+            float(f[BF_RADIUS]) / 16.0f, int(f[BF_OWNER]));
+    return b;
+}
+
+/* ===================== Delta coding ===================== */
+
+namespace {
+
+void encodeEntities(const std::vector<uint16_t>& cur, const std::vector<uint16_t>* base,
+                    int fields, ByteWriter& w) {
+    const size_t count = cur.size() / size_t(fields);
+    const size_t baseCount = base ? base->size() / size_t(fields) : 0;
+    w.varint(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint16_t* c = &cur[i * size_t(fields)];
+        const uint16_t* b = (i < baseCount) ? &(*base)[i * size_t(fields)] : nullptr;
+
+        uint8_t mask = 0;
+        for (int k = 0; k < fields; ++k) {
+            if (c[k] != (b ? b[k] : 0)) mask |= uint8_t(1u << k);
+        }
+        w.u8(mask);
+        for (int k = 0; k < fields; ++k) {
+            if (mask & (1u << k)) w.svarint(int16_t(uint16_t(c[k] - (b ? b[k] : 0))));
+        }
+    }
+}
+
+bool decodeEntities(ByteReader& r, const std::vector<uint16_t>* base, int fields,
+                    size_t maxCount, std::vector<uint16_t>& out) {
+    const uint64_t count = r.varint();
+    if (!r.ok() || count > maxCount) return false;
+    const size_t baseCount = base ? base->size() / size_t(fields) : 0;
+
+    out.resize(size_t(count) * size_t(fields));
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t* o = &out[i * size_t(fields)];
+        const uint16_t* b = (i < baseCount) ? &(*base)[i * size_t(fields)] : nullptr;
+
+        uint8_t mask = r.u8();
+        for (int k = 0; k < fields; ++k) {
+            uint16_t v = b ? b[k] : 0;
+            if (mask & (1u << k)) v = uint16_t(v + uint16_t(int16_t(r.svarint())));
+            o[k] = v;
+        }
+    }
+    return r.ok();
+}
+
+} // namespace
+
+void encodeFrame(const WorldFrame& cur, const WorldFrame* base, ByteWriter& w) {
+    encodeEntities(cur.players, base ? &base->players : nullptr, kPlayerFields, w);
+    encodeEntities(cur.bullets, base ? &base->bullets : nullptr, kBulletFields, w);
+}
+
+bool decodeFrame(ByteReader& r, const WorldFrame* base, WorldFrame& out) {
+    // Every entity costs at least its mask byte, which bounds a hostile count.
+    return decodeEntities(r, base ? &base->players : nullptr, kPlayerFields, kMaxDatagram, out.players) &&
+           decodeEntities(r, base ? &base->bullets : nullptr, kBulletFields, kMaxDatagram, out.bullets);
+}
+
+} // namespace Net
@@ -0,0 +1,239 @@
+#include "../../include/net/NetServer.h"
+#include "../../include/game/Game.h"
+
+#include <algorithm>
+
+namespace {
+
+// Clients silent for this long are dropped and their player stops.
+const uint64_t kClientTimeoutUs = 5000000;
+// Pause on the game-over screen before the match restarts.
+const float kRestartDelaySeconds = 3.0f;
+const size_t kMaxClients = 64;
+
+} // namespace
+
+NetClientStats::NetClientStats()
+    : bytesSent(0), snapshots(0), fullSnapshots(0), inputPackets(0) {}
+
+NetServer::NetServer(Game& g, uint64_t hash)
+    : game(g),
+      mapHash(hash),
+      conditioner(socket, 0x5e7e7u),
+      simHz(60.0f),
+      snapshotInterval(2),
+      currentTick(0),
+      gameOverTicks(0),
+      quantizer(g.getArena()),
+      history(Net::kFrameHistory),
+      recvBuf(Net::kMaxDatagram) {
+    game.setInputDrivesPlayers(false);
+}
+
+bool NetServer::start(uint16_t port, std::string& error) {
+    return socket.open(port, error);
+}
+
+uint16_t NetServer::port() const { return socket.localPort(); }
+
+void NetServer::setSimulationRate(float hz) { simHz = std::max(1.0f, hz); }
+
+void NetServer::setSnapshotInterval(int ticks) { snapshotInterval = std::max(1, ticks); }
+
+LinkConditioner& NetServer::link() { return conditioner; }
+
+uint32_t NetServer::tick() const { return currentTick; }
+
+std::vector<NetServer::ClientInfo> NetServer::clients() const {
+    std::vector<ClientInfo> out;
+    for (const Client& c : connected) {
+        ClientInfo info;
+        info.address = c.address;
+        info.entity = c.entity;
+        info.stats = c.stats;
+        out.push_back(info);
+    }
+    return out;
+}
+
+/* ===================== Step ===================== */
+
+void NetServer::step(uint64_t nowUs) {
+    receive(nowUs);
+    dropIdleClients(nowUs);
+
+    for (Client& c : connected) {
+        PlayerCommand cmd = c.command;
+        // A press that arrived and was released between two steps still fires.
+        if (c.firePending) cmd.fire = true;
+        c.firePending = false;
+        game.setPlayerCommand(c.entity, cmd);
+        c.appliedInputSeq = c.lastInputSeq;
+    }
+
+    game.update(1.0f / simHz);
+    ++currentTick;
+
+    if (!game.isRunning()) {
+        if (++gameOverTicks >= int(kRestartDelaySeconds * simHz)) {
+            game.reset();
+            gameOverTicks = 0;
+        }
+    }
+
+    if (currentTick % uint32_t(snapshotInterval) == 0) {
+        Net::WorldFrame& f = history[(currentTick / uint32_t(snapshotInterval)) % Net::kFrameHistory];
+        quantizer.capture(game, currentTick, f);
+        for (Client& c : connected) sendSnapshot(c, nowUs);
+    }
+
+    conditioner.flush(nowUs);
+}
+
+const Net::WorldFrame* NetServer::historyFrame(uint32_t t) const {
+    if (t == 0 || t % uint32_t(snapshotInterval) != 0) return nullptr;
+    const Net::WorldFrame& f = history[(t / uint32_t(snapshotInterval)) % Net::kFrameHistory];
+    return (f.tick == t) ? &f : nullptr;
+}
+
+void NetServer::sendSnapshot(Client& c, uint64_t nowUs) {
+    const Net::WorldFrame* cur = historyFrame(currentTick);
+    const Net::WorldFrame* base = historyFrame(c.ackedTick);
+
+    packet.clear();
+    Net::ByteWriter w(packet);
+    w.u8(Net::MSG_SNAPSHOT);
+    w.u32(currentTick);
+    w.u32(base ? base->tick : 0);
+    w.u32(c.appliedInputSeq);
+    w.u8(cur->state);
+    w.u16(cur->winner);
+    Net::encodeFrame(*cur, base, w);
+
+    conditioner.send(c.address, packet.data(), packet.size(), nowUs);
+    c.stats.bytesSent += packet.size();
+    ++c.stats.snapshots;
+    if (!base) ++c.stats.fullSnapshots;
+}
+
+/* ===================== Receiving ===================== */
+
+NetServer::Client* NetServer::findClient(const NetAddress& a) {
+    for (Client& c : connected) {
+        if (c.address == a) return &c;
+    }
+    return nullptr;
+}
+
+int NetServer::freeEntity() const {
+    for (int e = 0; e < game.playerCount(); ++e) {
+        bool taken = false;
+        for (const Client& c : connected) taken |= (c.entity == e);
+        if (!taken) return e;
+    }
+    return -1;
+}
+
+void NetServer::receive(uint64_t nowUs) {
+    NetAddress from;
+    int n;
+    while ((n = socket.receive(from, recvBuf.data(), recvBuf.size())) > 0) {
+        Net::ByteReader r(recvBuf.data(), size_t(n));
+        uint8_t type = r.u8();
+
+        if (type == Net::MSG_HELLO) {
+            handleHello(from, r, nowUs);
+            continue;
+        }
+
+        Client* c = findClient(from);
+        if (!c) continue;
+        c->lastHeardUs = nowUs;
+
+        if (type == Net::MSG_INPUT) {
+            handleInput(*c, r, nowUs);
+        } else if (type == Net::MSG_BYE) {
+            game.setPlayerCommand(c->entity, PlayerCommand());
+            connected.erase(connected.begin() + (c - connected.data()));
+        }
+    }
+}
+
+void NetServer::handleHello(const NetAddress& from, Net::ByteReader& r, uint64_t nowUs) {
+    uint32_t version = r.u32();
+    if (!r.ok() || version != Net::kProtocolVersion) return;
+
+    // A repeated HELLO means our WELCOME was lost.
+    if (Client* known = findClient(from)) {
+        known->lastHeardUs = nowUs;
+        sendWelcome(*known, nowUs);
+        return;
+    }
+    if (connected.size() >= kMaxClients) return;
+
+    Client c;
+    c.address = from;
+    c.entity = freeEntity();
+    if (c.entity < 0) {
+        const PlayerStore& ps = game.getPlayers();
+        float headR = ps.size() > 0 ? ps.get(0).headRadius : 20.0f;
+        c.entity = game.addPlayer(game.getArena().center, headR);
+    }
+    c.lastHeardUs = nowUs;
+    c.lastInputSeq = 0;
+    c.appliedInputSeq = 0;
+    c.firePending = false;
+    c.ackedTick = 0;
+    connected.push_back(c);
+
+    sendWelcome(connected.back(), nowUs);
+}
+
+void NetServer::handleInput(Client& c, Net::ByteReader& r, uint64_t) {
+    uint32_t seq = r.u32();
+    uint32_t ack = r.u32();
+    int count = std::min<int>(r.u8(), Net::kInputRedundancy);
+
+    PlayerCommand cmds[Net::kInputRedundancy];
+    for (int i = 0; i < count; ++i) cmds[i] = Net::readCommand(r);
+    if (!r.ok()) return;
+
+    ++c.stats.inputPackets;
+    if (ack > c.ackedTick && ack <= currentTick) c.ackedTick = ack;
+    if (count == 0 || seq <= c.lastInputSeq) return;
+
+    // Commands are newest first; any press we have not seen yet is kept so a
+    // lost or late packet does not swallow a shot.
+    for (int i = 0; i < count && seq - uint32_t(i) > c.lastInputSeq; ++i) {
+        if (cmds[i].fire) c.firePending = true;
+    }
+    c.command = cmds[0];
+    c.lastInputSeq = seq;
+}
+
+void NetServer::dropIdleClients(uint64_t nowUs) {
+    for (size_t i = 0; i < connected.size();) {
+        if (nowUs - connected[i].lastHeardUs > kClientTimeoutUs) {
+            game.setPlayerCommand(connected[i].entity, PlayerCommand());
+            connected.erase(connected.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void NetServer::sendWelcome(const Client& c, uint64_t nowUs) {
+    packet.clear();
+    Net::ByteWriter w(packet);
+    w.u8(Net::MSG_WELCOME);
+    w.u32(Net::kProtocolVersion);
+    w.u32(uint32_t(c.entity));
+    w.f32(simHz);
+    w.u32(uint32_t(snapshotInterval));
+    w.u64(mapHash);
+    const Arena& a = game.getArena();
+    w.f32(a.center.x);
+    w.f32(a.center.y);
+    w.f32(a.radius);
+    conditioner.send(c.address, packet.data(), packet.size(), nowUs);
+}
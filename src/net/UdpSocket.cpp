@@ -0,0 +1,147 @@
+#include "../../include/net/UdpSocket.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* ===================== NetAddress ===================== */
+
+NetAddress::NetAddress() : ip(0), port(0) {}
+
+NetAddress::NetAddress(uint32_t ip_, uint16_t port_) : ip(ip_), port(port_) {}
+
+bool NetAddress::parse(const std::string& text, uint16_t defaultPort, NetAddress& out) {
+    std::string host = text;
+    uint16_t port = defaultPort;
+
+    size_t colon = text.rfind(':');
+    if (colon != std::string::npos) {
+        host = text.substr(0, colon);
+        char* end = nullptr;
+        long p = std::strtol(text.c_str() + colon + 1, &end, 10);
+        if (*end != '\0' || p <= 0 || p > 65535) return false;
+        port = uint16_t(p);
+    }
+    if (host.empty()) host = "127.0.0.1";
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo* res = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &res) != 0 || !res) return false;
+    const sockaddr_in* sa = reinterpret_cast<const sockaddr_in*>(res->ai_addr);
+    out.ip = ntohl(sa->sin_addr.s_addr);
+    out.port = port;
+    freeaddrinfo(res);
+    return true;
+}
+
+NetAddress NetAddress::loopback(uint16_t port) {
+    return NetAddress(INADDR_LOOPBACK, port);
+}
+
+std::string NetAddress::toString() const {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%u.%u.%u.%u:%u",
+                  (ip >> 24) & 255u, (ip >> 16) & 255u, (ip >> 8) & 255u, ip & 255u, unsigned(port));
+    return buf;
+}
+
+bool NetAddress::operator==(const NetAddress& o) const { return ip == o.ip && port == o.port; }
+bool NetAddress::operator!=(const NetAddress& o) const { return !(*this == o); }
+
+/* ===================== UdpSocket ===================== */
+
+UdpSocket::UdpSocket() : fd(-1), boundPort(0) {}
+
+UdpSocket::~UdpSocket() {
+    close();
+}
+
+bool UdpSocket::open(uint16_t port, std::string& error) {
+    close();
+
+    fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        error = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        error = std::string("bind: ") + std::strerror(errno);
+        close();
+        return false;
+    }
+
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+    // Full snapshots of busy games exceed the default buffers on some systems.
+    int size = 1 << 20;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+
+    socklen_t len = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    boundPort = ntohs(addr.sin_port);
+    return true;
+}
+
+void UdpSocket::close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+    boundPort = 0;
+}
+
+bool UdpSocket::isOpen() const { return fd >= 0; }
+
+uint16_t UdpSocket::localPort() const { return boundPort; }
+
+bool UdpSocket::send(const NetAddress& to, const uint8_t* data, size_t size) {
+    if (fd < 0) return false;
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(to.ip);
+    addr.sin_port = htons(to.port);
+    ssize_t n = ::sendto(fd, data, size, 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    return n == ssize_t(size);
+}
+
+int UdpSocket::receive(NetAddress& from, uint8_t* buf, size_t capacity) {
+    if (fd < 0) return -1;
+
+    sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    ssize_t n = ::recvfrom(fd, buf, capacity, 0, reinterpret_cast<sockaddr*>(&addr), &len);
+    if (n < 0) return -1;
+
+    from.ip = ntohl(addr.sin_addr.s_addr);
+    from.port = ntohs(addr.sin_port);
+    return int(n);
+}
+
+bool UdpSocket::waitReadable(int timeoutMs) const {
+    if (fd < 0) return false;
+    pollfd p;
+    p.fd = fd;
+    p.events = POLLIN;
+    p.revents = 0;
+    return ::poll(&p, 1, timeoutMs) > 0;
+}
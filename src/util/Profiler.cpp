@@ -0,0 +1,194 @@
+#include "../../include/util/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+/* ===================== Ring buffer ===================== */
+
+namespace {
+
+// Fields are atomics so concurrent rewrites are not data races; readers
+// validate them with `seq` (index + 1 of the event that was published).
+struct Slot {
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> start;
+    std::atomic<uint64_t> packed;  // duration << 32 | thread << 8 | zone
+};
+
+Slot gRing[Profiler::kCapacity];
+std::atomic<uint64_t> gWriteIndex(0);
+std::atomic<bool> gEnabled(false);
+std::atomic<uint64_t> gFrameStart(0);
+std::atomic<uint32_t> gNextThread(0);
+
+const std::chrono::steady_clock::time_point gEpoch = std::chrono::steady_clock::now();
+
+uint16_t threadIndex() {
+    thread_local uint16_t index = uint16_t(gNextThread.fetch_add(1, std::memory_order_relaxed));
+    return index;
+}
+
+const char* const kZoneNames[] = {
+    "frame",
+    "updatePlayers",
+    "updateBullets",
+    "handleCollisions",
+    "checkGameOver",
+    "drawStatic",
+    "drawPlayers",
+    "drawBullets",
+    "drawHud",
+    "renderSubmit"
+};
+
+static_assert(sizeof(kZoneNames) / sizeof(kZoneNames[0]) == size_t(ProfileZone::COUNT), "zone names");
+
+} // namespace
+
+ProfileZoneStats::ProfileZoneStats()
+    : calls(0), meanUs(0.0), p50Us(0.0), p99Us(0.0), maxUs(0.0), perFrameUs(0.0) {}
+
+void Profiler::setEnabled(bool on) {
+    gEnabled.store(on, std::memory_order_relaxed);
+    if (on) gFrameStart.store(nowNs(), std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() {
+    return gEnabled.load(std::memory_order_relaxed);
+}
+
+const char* Profiler::zoneName(ProfileZone zone) {
+    return (zone < ProfileZone::COUNT) ? kZoneNames[int(zone)] : "?";
+}
+
+uint64_t Profiler::nowNs() {
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - gEpoch).count());
+}
+
+void Profiler::record(ProfileZone zone, uint64_t startNs, uint64_t endNs) {
+    uint64_t i = gWriteIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot& s = gRing[i & (kCapacity - 1)];
+
+    uint64_t duration = std::min<uint64_t>(endNs - startNs, 0xffffffffu);
+    s.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.start.store(startNs, std::memory_order_relaxed);
+    s.packed.store((duration << 32) | (uint64_t(threadIndex()) << 8) | uint64_t(zone),
+                   std::memory_order_relaxed);
+    s.seq.store(i + 1, std::memory_order_release);
+}
+
+void Profiler::frameMark() {
+    if (!isEnabled()) return;
+    uint64_t now = nowNs();
+    uint64_t start = gFrameStart.exchange(now, std::memory_order_relaxed);
+    record(ProfileZone::FRAME, start, now);
+}
+
+Profiler::Scope::Scope(ProfileZone z) : zone(z), start(isEnabled() ? nowNs() : 0) {}
+
+Profiler::Scope::~Scope() {
+    if (start != 0 && isEnabled()) record(zone, start, nowNs());
+}
+
+/* ===================== Reading ===================== */
+
+void Profiler::snapshot(std::vector<Event>& out) {
+    out.clear();
+    uint64_t end = gWriteIndex.load(std::memory_order_acquire);
+    uint64_t begin = (end > kCapacity) ? end - kCapacity : 0;
+    out.reserve(size_t(end - begin));
+
+    for (uint64_t i = begin; i < end; ++i) {
+        const Slot& s = gRing[i & (kCapacity - 1)];
+        if (s.seq.load(std::memory_order_acquire) != i + 1) continue;
+        uint64_t start = s.start.load(std::memory_order_relaxed);
+        uint64_t packed = s.packed.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Rewritten while we read it.
+        if (s.seq.load(std::memory_order_relaxed) != i + 1) continue;
+
+        Event e;
+        e.startNs = start;
+        e.durationNs = uint32_t(packed >> 32);
+        e.thread = uint16_t((packed >> 8) & 0xffffu);
+        e.zone = ProfileZone(packed & 0xffu);
+        out.push_back(e);
+    }
+}
+
+void Profiler::clear() {
+    for (Slot& s : gRing) s.seq.store(0, std::memory_order_relaxed);
+    gWriteIndex.store(0, std::memory_order_release);
+}
+
+uint64_t Profiler::totalEvents() {
+    return gWriteIndex.load(std::memory_order_relaxed);
+}
+
+void Profiler::summarize(std::vector<ProfileZoneStats>& out, uint32_t maxEvents) {
+    std::vector<Event> events;
+    snapshot(events);
+    if (events.size() > maxEvents) events.erase(events.begin(), events.end() - maxEvents);
+
+    const int zones = int(ProfileZone::COUNT);
+    std::vector<std::vector<double>> durations(static_cast<size_t>(zones));
+    for (const Event& e : events) durations[size_t(e.zone)].push_back(double(e.durationNs) * 1e-3);
+
+    out.assign(size_t(zones), ProfileZoneStats());
+    const double frames = double(durations[size_t(ProfileZone::FRAME)].size());
+    for (int z = 0; z < zones; ++z) {
+        std::vector<double>& d = durations[size_t(z)];
+        if (d.empty()) continue;
+        std::sort(d.begin(), d.end());
+
+        double sum = 0.0;
+        for (double v : d) sum += v;
+
+        ProfileZoneStats& s = out[size_t(z)];
+        s.calls = int(d.size());
+        s.meanUs = sum / double(d.size());
+        s.p50Us = d[d.size() / 2];
+        s.p99Us = d[std::min(d.size() - 1, size_t(double(d.size()) * 0.99))];
+        s.maxUs = d.back();
+        s.perFrameUs = frames > 0.0 ? sum / frames : 0.0;
+    }
+}
+
+/* ===================== Export ===================== */
+
+bool Profiler::writeCsv(const std::string& path) {
+    std::vector<Event> events;
+    snapshot(events);
+
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    std::fprintf(f, "zone,thread,start_us,duration_us\n");
+    for (const Event& e : events) {
+        std::fprintf(f, "%s,%u,%.3f,%.3f\n", zoneName(e.zone), unsigned(e.thread),
+                     double(e.startNs) * 1e-3, double(e.durationNs) * 1e-3);
+    }
+    return std::fclose(f) == 0;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    std::vector<Event> events;
+    snapshot(events);
+
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    std::fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (size_t i = 0; i < events.size(); ++i) {
+        const Event& e = events[i];
+        const char* cat = (e.zone >= ProfileZone::DRAW_STATIC) ? "render" :
+                          (e.zone == ProfileZone::FRAME) ? "frame" : "sim";
+        std::fprintf(f, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}%s\n",
+                     zoneName(e.zone), cat, double(e.startNs) * 1e-3, double(e.durationNs) * 1e-3,
+                     unsigned(e.thread), (i + 1 < events.size()) ? "," : "");
+    }
+    std::fprintf(f, "]}\n");
+    return std::fclose(f) == 0;
+}
@@ -0,0 +1,100 @@
+#include "../../include/util/WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(int requested)
+    : workerCount(requested > 0 ? requested : int(std::thread::hardware_concurrency())),
+      generation(0),
+      stopping(false),
+      job(nullptr),
+      remaining(0),
+      stealCount(0) {
+    if (workerCount < 1) workerCount = 1;
+
+    for (int w = 0; w < workerCount; ++w) queues.emplace_back(new Queue());
+    for (int w = 1; w < workerCount; ++w) threads.emplace_back(&WorkStealingPool::workerLoop, this, w);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : threads) t.join();
+}
+
+int WorkStealingPool::threadCount() const { return workerCount; }
+
+uint64_t WorkStealingPool::steals() const { return stealCount.load(std::memory_order_relaxed); }
+
+void WorkStealingPool::parallelFor(int count, const std::function<void(int)>& fn) {
+    if (count <= 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m);
+        // Published before any index is queued: a worker still draining from
+        // the previous call may pick up new indices straight away.
+        job = &fn;
+        remaining.store(count, std::memory_order_release);
+        for (int i = 0; i < count; ++i) {
+            Queue& q = *queues[i % workerCount];
+            std::lock_guard<std::mutex> ql(q.m);
+            q.items.push_back(i);
+        }
+        ++generation;
+    }
+    wake.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(m);
+    done.wait(lock, [this] { return remaining.load(std::memory_order_acquire) == 0; });
+    job = nullptr;
+}
+
+void WorkStealingPool::workerLoop(int w) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        drain(w);
+    }
+}
+
+// Runs tasks until neither the own deque nor any other has work left. No task
+// spawns more, so an empty sweep means this worker is done for the call.
+void WorkStealingPool::drain(int w) {
+    int item;
+    while (popLocal(w, item) || steal(w, item)) {
+        (*job)(item);
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(m);
+            done.notify_all();
+        }
+    }
+}
+
+bool WorkStealingPool::popLocal(int w, int& item) {
+    Queue& q = *queues[w];
+    std::lock_guard<std::mutex> lock(q.m);
+    if (q.items.empty()) return false;
+    item = q.items.back();
+    q.items.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int w, int& item) {
+    for (int k = 1; k < workerCount; ++k) {
+        Queue& q = *queues[(w + k) % workerCount];
+        std::lock_guard<std::mutex> lock(q.m);
+        if (q.items.empty()) continue;
+        item = q.items.front();
+        q.items.pop_front();
+        stealCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,61 @@
+#include "../../include/world/EntityGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Bounds the grid on large arenas with tiny players.
+static const int kMaxCellsPerAxis = 256;
+
+EntityGrid::EntityGrid()
+    : originX(0.0f),
+      originY(0.0f),
+      invCell(1.0f),
+      maxR(0.0f),
+      cells(1) {}
+
+float EntityGrid::maxRadius() const { return maxR; }
+
+void EntityGrid::build(const float* x, const float* y, const float* r, const int* alive, int n, const Arena& arena) {
+    maxR = 0.0f;
+    int liveCount = 0;
+    for (int e = 0; e < n; ++e) {
+        if (alive[e] > 0) {
+            maxR = std::max(maxR, r[e]);
+            ++liveCount;
+        }
+    }
+
+    // Cells about one player across, so neighbor queries touch a 3x3 block,
+    // but no more than ~4 cells per entity: clearing cellStart is part of
+    // every rebuild, and a sparse arena should not pay for empty cells.
+    int perAxis = std::min(kMaxCellsPerAxis, std::max(1, int(2.0f * std::sqrt(float(liveCount)))));
+    float extent = 2.0f * std::max(arena.radius, 1e-3f);
+    float cell = std::max(2.0f * maxR, extent / float(perAxis));
+    cells = std::max(1, std::min(perAxis, int(std::ceil(extent / cell))));
+    invCell = 1.0f / cell;
+    originX = arena.center.x - arena.radius;
+    originY = arena.center.y - arena.radius;
+
+    const int cellCount = cells * cells;
+    cellStart.assign(size_t(cellCount) + 1, 0);
+    cellOf.resize(size_t(n));
+
+    // Counting sort by cell: count, prefix-sum, scatter.
+    for (int e = 0; e < n; ++e) {
+        if (alive[e] <= 0) { cellOf[e] = -1; continue; }
+        int c = cellCoord(y[e] - originY) * cells + cellCoord(x[e] - originX);
+        cellOf[e] = c;
+        cellStart[c + 1]++;
+    }
+    for (int c = 0; c < cellCount; ++c) cellStart[c + 1] += cellStart[c];
+
+    items.resize(size_t(cellStart[cellCount]));
+    // cellStart[c] doubles as the write cursor, which leaves every start
+    // shifted to the next cell's; shift them back afterwards.
+    for (int e = 0; e < n; ++e) {
+        int c = cellOf[e];
+        if (c >= 0) items[cellStart[c]++] = e;
+    }
+    for (int c = cellCount; c > 0; --c) cellStart[c] = cellStart[c - 1];
+    cellStart[0] = 0;
+}
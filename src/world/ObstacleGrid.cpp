@@ -0,0 +1,199 @@
+#include "../../include/world/ObstacleGrid.h"
+#include "../../include/math/Collision.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Keeps memory bounded on degenerate inputs (huge spread, tiny radii).
+static const int kMaxCellsPerAxis = 2048;
+
+ObstacleGrid::ObstacleGrid()
+    : originX(0.0f),
+      originY(0.0f),
+      cell(1.0f),
+      invCell(1.0f),
+      cols(0),
+      rowCount(0) {}
+
+void ObstacleGrid::clear() {
+    originX = originY = 0.0f;
+    cell = invCell = 1.0f;
+    cols = rowCount = 0;
+    cellStart.clear();
+    entryX.clear();
+    entryY.clear();
+    entryR.clear();
+    entryIndex.clear();
+}
+
+bool ObstacleGrid::empty() const { return entryIndex.empty(); }
+float ObstacleGrid::cellSize() const { return cell; }
+int ObstacleGrid::columns() const { return cols; }
+int ObstacleGrid::rows() const { return rowCount; }
+
+void ObstacleGrid::build(const std::vector<Obstacle>& obstacles) {
+    clear();
+    if (obstacles.empty()) return;
+
+    float minX = obstacles[0].pos.x - obstacles[0].radius;
+    float minY = obstacles[0].pos.y - obstacles[0].radius;
+    float maxX = obstacles[0].pos.x + obstacles[0].radius;
+    float maxY = obstacles[0].pos.y + obstacles[0].radius;
+    double sumR = 0.0;
+
+    for (const auto& ob : obstacles) {
+        minX = std::min(minX, ob.pos.x - ob.radius);
+        minY = std::min(minY, ob.pos.y - ob.radius);
+        maxX = std::max(maxX, ob.pos.x + ob.radius);
+        maxY = std::max(maxY, ob.pos.y + ob.radius);
+        sumR += ob.radius;
+    }
+
+    float w = std::max(maxX - minX, 1e-3f);
+    float h = std::max(maxY - minY, 1e-3f);
+    float n = float(obstacles.size());
+
+    // About one obstacle per cell, but never smaller than a typical obstacle,
+    // otherwise each obstacle gets duplicated into many cells.
+    float avgDiameter = float(2.0 * sumR / double(obstacles.size()));
+    cell = std::max(avgDiameter, std::sqrt(w * h / n));
+    cell = std::max(cell, std::max(w, h) / float(kMaxCellsPerAxis));
+    invCell = 1.0f / cell;
+
+    originX = minX;
+    originY = minY;
+    cols = std::max(1, int(std::ceil(w * invCell)));
+    rowCount = std::max(1, int(std::ceil(h * invCell)));
+
+    const int cellCount = cols * rowCount;
+    cellStart.assign(size_t(cellCount) + 1, 0);
+
+    // Two passes (count, then fill) so the CSR arrays are allocated exactly once.
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<int> cursor;
+        if (pass == 1) {
+            for (int c = 0; c < cellCount; ++c) cellStart[c + 1] += cellStart[c];
+            const size_t total = size_t(cellStart[cellCount]);
+            entryX.resize(total);
+            entryY.resize(total);
+            entryR.resize(total);
+            entryIndex.resize(total);
+            cursor.assign(cellStart.begin(), cellStart.end() - 1);
+        }
+
+        for (int i = 0; i < (int)obstacles.size(); ++i) {
+            const Obstacle& ob = obstacles[i];
+            int c0 = cellCoord(ob.pos.x - ob.radius - originX, cols);
+            int c1 = cellCoord(ob.pos.x + ob.radius - originX, cols);
+            int r0 = cellCoord(ob.pos.y - ob.radius - originY, rowCount);
+            int r1 = cellCoord(ob.pos.y + ob.radius - originY, rowCount);
+
+            for (int row = r0; row <= r1; ++row) {
+                for (int col = c0; col <= c1; ++col) {
+                    int c = row * cols + col;
+                    if (pass == 0) {
+                        cellStart[c + 1]++;
+                    } else {
+                        int k = cursor[c]++;
+                        entryX[k] = ob.pos.x;
+                        entryY[k] = ob.pos.y;
+                        entryR[k] = ob.radius;
+                        entryIndex[k] = i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool ObstacleGrid::assign(float ox, float oy, float cellSz, int c, int r,
+                          const int* starts, const Entry* items, int entryCount, int obstacleCount) {
+    clear();
+    // build() can round one cell past kMaxCellsPerAxis.
+    if (c <= 0 || r <= 0 || c > kMaxCellsPerAxis + 1 || r > kMaxCellsPerAxis + 1 || !(cellSz > 0.0f)) return false;
+
+    const int cellCount = c * r;
+    if (starts[0] != 0 || starts[cellCount] != entryCount) return false;
+    for (int i = 0; i < cellCount; ++i) {
+        if (starts[i + 1] < starts[i]) return false;
+    }
+    for (int i = 0; i < entryCount; ++i) {
+        if (items[i].index < 0 || items[i].index >= obstacleCount) return false;
+    }
+
+    originX = ox;
+    originY = oy;
+    cell = cellSz;
+    invCell = 1.0f / cellSz;
+    cols = c;
+    rowCount = r;
+    cellStart.assign(starts, starts + cellCount + 1);
+    entryX.resize(size_t(entryCount));
+    entryY.resize(size_t(entryCount));
+    entryR.resize(size_t(entryCount));
+    entryIndex.resize(size_t(entryCount));
+    for (int i = 0; i < entryCount; ++i) {
+        entryX[i] = items[i].x;
+        entryY[i] = items[i].y;
+        entryR[i] = items[i].r;
+        entryIndex[i] = items[i].index;
+    }
+    return true;
+}
+
+float ObstacleGrid::gridOriginX() const { return originX; }
+float ObstacleGrid::gridOriginY() const { return originY; }
+const std::vector<int>& ObstacleGrid::cellStartArray() const { return cellStart; }
+int ObstacleGrid::entryCount() const { return int(entryIndex.size()); }
+
+ObstacleGrid::Entry ObstacleGrid::entry(int k) const {
+    Entry e;
+    e.x = entryX[k];
+    e.y = entryY[k];
+    e.r = entryR[k];
+    e.index = entryIndex[k];
+    return e;
+}
+
+int ObstacleGrid::findHit(const Vec2& p0, const Vec2& p1, float r, float* toi) const {
+    if (entryIndex.empty()) return -1;
+
+    const float minX = std::min(p0.x, p1.x) - r;
+    const float minY = std::min(p0.y, p1.y) - r;
+    const float maxX = std::max(p0.x, p1.x) + r;
+    const float maxY = std::max(p0.y, p1.y) + r;
+    if (maxX < originX || maxY < originY) return -1;
+    if (minX > originX + float(cols) * cell || minY > originY + float(rowCount) * cell) return -1;
+
+    const int c0 = cellCoord(minX - originX, cols);
+    const int r0 = cellCoord(minY - originY, rowCount);
+    const int c1 = cellCoord(maxX - originX, cols);
+    const int r1 = cellCoord(maxY - originY, rowCount);
+
+    // Keep the earliest contact; an obstacle listed in several cells just
+    // repeats the same time. Each cell is one batch query over its span.
+    int hit = -1;
+    float best = 2.0f;
+    for (int row = r0; row <= r1; ++row) {
+        for (int col = c0; col <= c1; ++col) {
+            const int c = row * cols + col;
+            const int begin = cellStart[c];
+            const Collision::CircleSpan span = { entryX.data() + begin, entryY.data() + begin,
+                                                 entryR.data() + begin, cellStart[c + 1] - begin };
+            if (span.count == 0) continue;
+
+            float t;
+            int k = Collision::sweepCircleFirst(p0, p1, r, span, t);
+            if (k >= 0 && t < best) {
+                best = t;
+                hit = entryIndex[begin + k];
+                if (t <= 0.0f) {
+                    if (toi) *toi = best;
+                    return hit;
+                }
+            }
+        }
+    }
+    if (toi && hit >= 0) *toi = best;
+    return hit;
+}
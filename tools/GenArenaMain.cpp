@@ -0,0 +1,94 @@
+#include "../include/io/ArenaGenerator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Writes seeded stress arenas (see ArenaGenerator) as SVG maps, one file per
+// layout and obstacle count: DIR/stress_<layout>_<count>.svg.
+
+static void usage(const char* exe) {
+    std::fprintf(stderr,
+                 "Usage: %s [options]\n"
+                 "  --layout L       uniform, clustered, ring, corridor or all (default all)\n"
+                 "  --obstacles N,.. obstacle counts, comma separated (default 100,1000,10000,100000,1000000)\n"
+                 "  --seed S         generator seed (default 1)\n"
+                 "  --out DIR        output directory (default .)\n",
+                 exe);
+}
+
+static bool parseCounts(const char* text, std::vector<long long>& out) {
+    out.clear();
+    const char* p = text;
+    while (*p) {
+        char* end = nullptr;
+        long long n = std::strtoll(p, &end, 10);
+        if (end == p || n < 0) return false;
+        out.push_back(n);
+        p = end;
+        if (*p == ',') ++p;
+        else if (*p) return false;
+    }
+    return !out.empty();
+}
+
+int main(int argc, char** argv) {
+    std::string layoutArg = "all";
+    std::vector<long long> counts = { 100, 1000, 10000, 100000, 1000000 };
+    long long seed = 1;
+    std::string outDir = ".";
+
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(a, "--layout") == 0 && hasValue) layoutArg = argv[++i];
+        else if (std::strcmp(a, "--obstacles") == 0 && hasValue) {
+            if (!parseCounts(argv[++i], counts)) { usage(argv[0]); return 1; }
+        }
+        else if (std::strcmp(a, "--seed") == 0 && hasValue) seed = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--out") == 0 && hasValue) outDir = argv[++i];
+        else { usage(argv[0]); return 1; }
+    }
+
+    std::vector<ArenaLayout> layouts;
+    if (layoutArg == "all") {
+        for (int i = 0; i < ArenaGenerator::kLayoutCount; ++i) layouts.push_back(ArenaLayout(i));
+    } else {
+        ArenaLayout l;
+        if (!ArenaGenerator::parseLayout(layoutArg, l)) { usage(argv[0]); return 1; }
+        layouts.push_back(l);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(outDir, ec);
+
+    std::printf("%-44s %10s %10s %9s %9s\n", "file", "obstacles", "radius", "MiB", "ms");
+    for (ArenaLayout layout : layouts) {
+        for (long long n : counts) {
+            auto t0 = std::chrono::steady_clock::now();
+            ArenaGenParams params;
+            params.layout = layout;
+            params.obstacles = n;
+            params.seed = uint32_t(seed);
+            SvgSceneData scene;
+            ArenaGenerator::generate(params, scene);
+
+            std::string path = (std::filesystem::path(outDir) /
+                                ("stress_" + std::string(ArenaGenerator::layoutName(layout)) + "_" +
+                                 std::to_string(n) + ".svg")).string();
+            if (!ArenaGenerator::writeSvg(path, scene)) {
+                std::fprintf(stderr, "cannot write '%s'\n", path.c_str());
+                return 1;
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            double mb = double(std::filesystem::file_size(path, ec)) / (1024.0 * 1024.0);
+            std::printf("%-44s %10zu %10.1f %9.2f %9.1f\n", path.c_str(), scene.obstacles.size(),
+                        scene.arena.radius, mb, ms);
+        }
+    }
+    return 0;
+}
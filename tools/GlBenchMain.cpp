@@ -0,0 +1,312 @@
+#include "../include/game/Camera.h"
+#include "../include/game/Game.h"
+#include "../include/game/GlRenderBackend.h"
+#include "../include/game/InputScript.h"
+#include "../include/io/ImageReader.h"
+#include "../include/io/ImageWriter.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <vector>
+
+// Offscreen GL render bench and golden-image check. Each map is played with
+// the seeded input script for N frames (one simulation tick per frame) and
+// drawn by the game's GL backend into an EGL pbuffer, so no display is
+// needed; Mesa's llvmpipe works. Reports frame time percentiles plus draw
+// calls and vertices per frame, then compares the last frame with the
+// map's reference image.
+//
+// Text uses the built-in 5x7 font (GLUT needs a window system), so the
+// references show that font rather than the GLUT bitmaps.
+
+static void usage(const char* exe) {
+    std::fprintf(stderr,
+                 "Usage: %s [options] [map.svg...]\n"
+                 "  --frames N       frames per map, one tick each (default 240)\n"
+                 "  --size WxH       framebuffer size (default 500x500, the game window)\n"
+                 "  --seed S         input script seed (default 1)\n"
+                 "  --immediate      glBegin/glEnd instead of batched buffers\n"
+                 "  --zoom Z         camera zoom, 1 = whole arena (default 1)\n"
+                 "  --follow         camera follows player 1\n"
+                 "  --golden DIR     reference images (default test_svgs/golden)\n"
+                 "  --update         write the last frames as the new references\n"
+                 "  --tolerance PCT  share of differing pixels allowed (default 0.5)\n"
+                 "  --threshold N    channel difference that makes a pixel differ (default 32)\n"
+                 "  --out DIR        also write each last frame, and a diff image on failure\n"
+                 "Without maps: test_svgs/*.svg and assets/arena.svg. Exit code 2 when a\n"
+                 "frame does not match its reference (or has none). References for other\n"
+                 "camera settings are named <map>_zoom<Z>[_follow].png.\n",
+                 exe);
+}
+
+typedef std::chrono::steady_clock Clock;
+
+/* ===================== Offscreen context ===================== */
+
+// Pbuffer-backed desktop GL context. Prefers Mesa's surfaceless platform,
+// which needs neither X nor a GPU, and falls back to the default display.
+static bool createContext(int width, int height) {
+    EGLDisplay display = EGL_NO_DISPLAY;
+    const char* ext = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (ext && std::strstr(ext, "EGL_MESA_platform_surfaceless")) {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay) display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) return false;
+    }
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint count = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &count) || count < 1) return false;
+
+    const EGLint surfaceAttribs[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttribs);
+    if (surface == EGL_NO_SURFACE) return false;
+
+    // Desktop GL with the compatibility profile: immediate mode and display
+    // lists are part of what is measured.
+    if (!eglBindAPI(EGL_OPENGL_API)) return false;
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+    if (context == EGL_NO_CONTEXT) return false;
+    return eglMakeCurrent(display, surface, surface, context) == EGL_TRUE;
+}
+
+// Same projection as the game window, Y down, following player 1 when
+// asked. The backend gets the scale and the view to cull against.
+static void applyCamera(Camera& camera, const Game& game, int width, int height, GlRenderBackend& gl) {
+    const PlayerStore& players = game.getPlayers();
+    Vec2 target = players.size() > 0 ? Vec2(players.posX()[0], players.posY()[0]) : game.getArena().center;
+    camera.setViewport(width, height);
+    camera.update(game.getArena(), target);
+    const Rect& v = camera.view();
+
+    glViewport(0, 0, width, height);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(v.minX, v.maxX, v.maxY, v.minY, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    gl.setPixelsPerUnit(camera.pixelsPerUnit());
+    gl.setViewRect(camera.cullRect());
+}
+
+// Framebuffer as RGBA8, top row first (GL reads bottom-up).
+static void readFrame(int width, int height, std::vector<uint32_t>& rgba) {
+    std::vector<uint32_t> rows(size_t(width) * size_t(height));
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rows.data());
+    rgba.resize(rows.size());
+    for (int y = 0; y < height; ++y) {
+        const uint32_t* src = rows.data() + size_t(height - 1 - y) * size_t(width);
+        uint32_t* dst = rgba.data() + size_t(y) * size_t(width);
+        for (int x = 0; x < width; ++x) {
+            uint8_t px[4];
+            std::memcpy(px, &src[x], 4);
+            px[3] = 255;   // pbuffer may have no alpha channel
+            std::memcpy(&dst[x], px, 4);
+        }
+    }
+}
+
+/* ===================== Image comparison ===================== */
+
+struct ImageDiff {
+    long differing;      // pixels with a channel off by more than the threshold
+    int maxChannel;      // largest channel difference anywhere
+};
+
+// `marks` gets the frame dimmed with differing pixels in red.
+static ImageDiff compareImages(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, int threshold,
+                               std::vector<uint32_t>& marks) {
+    ImageDiff d = { 0, 0 };
+    marks.resize(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        uint8_t pa[4], pb[4];
+        std::memcpy(pa, &a[i], 4);
+        std::memcpy(pb, &b[i], 4);
+        int worst = 0;
+        for (int c = 0; c < 3; ++c) worst = std::max(worst, std::abs(int(pa[c]) - int(pb[c])));
+        d.maxChannel = std::max(d.maxChannel, worst);
+        bool differs = worst > threshold;
+        if (differs) ++d.differing;
+        uint8_t m[4] = { uint8_t(differs ? 255 : pa[0] / 4), uint8_t(differs ? 0 : pa[1] / 4),
+                         uint8_t(differs ? 0 : pa[2] / 4), 255 };
+        std::memcpy(&marks[i], m, 4);
+    }
+    return d;
+}
+
+static std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    size_t dot = name.rfind(".svg");
+    return (dot == std::string::npos) ? name : name.substr(0, dot);
+}
+
+static std::vector<std::string> defaultMaps() {
+    std::vector<std::string> files;
+    if (DIR* dir = opendir("test_svgs")) {
+        while (dirent* e = readdir(dir)) {
+            std::string name = e->d_name;
+            if (name.size() > 4 && name.compare(name.size() - 4, 4, ".svg") == 0) files.push_back("test_svgs/" + name);
+        }
+        closedir(dir);
+    }
+    std::sort(files.begin(), files.end());
+    files.push_back("assets/arena.svg");
+    return files;
+}
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    return sorted[std::min(sorted.size() - 1, size_t(p * double(sorted.size())))];
+}
+
+int main(int argc, char** argv) {
+    int width = 500, height = 500;
+    long long frames = 240;
+    long long seed = 1;
+    bool immediate = false;
+    float zoom = 1.0f;
+    bool follow = false;
+    bool update = false;
+    double tolerancePct = 0.5;
+    int threshold = 32;
+    std::string goldenDir = "test_svgs/golden";
+    std::string outDir;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(a, "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width < 1 || height < 1) { usage(argv[0]); return 1; }
+        }
+        else if (std::strcmp(a, "--frames") == 0 && hasValue) frames = std::max(1LL, std::atoll(argv[++i]));
+        else if (std::strcmp(a, "--seed") == 0 && hasValue) seed = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--immediate") == 0) immediate = true;
+        else if (std::strcmp(a, "--zoom") == 0 && hasValue) zoom = float(std::atof(argv[++i]));
+        else if (std::strcmp(a, "--follow") == 0) follow = true;
+        else if (std::strcmp(a, "--golden") == 0 && hasValue) goldenDir = argv[++i];
+        else if (std::strcmp(a, "--update") == 0) update = true;
+        else if (std::strcmp(a, "--tolerance") == 0 && hasValue) tolerancePct = std::atof(argv[++i]);
+        else if (std::strcmp(a, "--threshold") == 0 && hasValue) threshold = std::atoi(argv[++i]);
+        else if (std::strcmp(a, "--out") == 0 && hasValue) outDir = argv[++i];
+        else if (std::strncmp(a, "--", 2) == 0) { usage(argv[0]); return 1; }
+        else files.push_back(a);
+    }
+    if (files.empty()) files = defaultMaps();
+
+    if (!createContext(width, height)) {
+        std::fprintf(stderr, "no offscreen GL context (EGL pbuffer with desktop GL) available\n");
+        return 1;
+    }
+    std::printf("%s, %s, %dx%d, %lld frames per map\n", (const char*)glGetString(GL_RENDERER),
+                immediate ? "immediate" : "batched", width, height, frames);
+
+    GlRenderBackend gl;
+    gl.setBatching(!immediate);
+    gl.setBuiltinFont(true);
+
+    std::printf("%-16s %8s %8s %8s %8s %9s %8s %9s  %s\n", "map", "p50(ms)", "p99(ms)", "max(ms)", "draws",
+                "verts", "diff(%)", "max diff", "result");
+
+    int failures = 0;
+    std::vector<uint32_t> frame, golden, marks;
+    for (const std::string& path : files) {
+        Game game;
+        if (!game.loadFromSvg(path)) {
+            std::fprintf(stderr, "failed to load '%s'\n", path.c_str());
+            return 1;
+        }
+        Camera camera;
+        camera.setZoom(zoom);
+        camera.setFollow(follow);
+        glClearColor(0.22f, 0.22f, 0.22f, 1.0f);
+
+        InputScript script((uint32_t)seed);
+        InputState in;
+        std::vector<double> ms;
+        ms.reserve(size_t(frames));
+        long long draws = 0, verts = 0;
+        bool resetPending = false;
+        for (long long f = 0; f < frames; ++f) {
+            if (resetPending) game.reset();
+            script.step(in);
+            game.setInput(in);
+            game.update(1.0f / 60.0f);
+            resetPending = !game.isRunning();
+
+            auto t0 = Clock::now();
+            applyCamera(camera, game, width, height, gl);
+            glClear(GL_COLOR_BUFFER_BIT);
+            gl.beginFrame();
+            game.render(gl);
+            gl.endFrame();
+            glFinish();
+            ms.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+
+            RenderStats st = gl.frameStats();
+            draws += st.drawCalls;
+            verts += st.vertices;
+        }
+        readFrame(width, height, frame);
+        std::sort(ms.begin(), ms.end());
+
+        std::string name = baseName(path);
+        if (zoom != 1.0f || follow) {
+            char suffix[48];
+            std::snprintf(suffix, sizeof(suffix), "_zoom%g%s", double(zoom), follow ? "_follow" : "");
+            name += suffix;
+        }
+        std::string goldenPath = goldenDir + "/" + name + ".png";
+        if (!outDir.empty()) ImageWriter::write(outDir + "/" + name + ".png", frame.data(), width, height);
+
+        char diffCol[32] = "-", maxCol[32] = "-";
+        const char* result;
+        int gw = 0, gh = 0;
+        if (update) {
+            result = ImageWriter::write(goldenPath, frame.data(), width, height) ? "UPDATED" : "WRITE FAILED";
+        } else if (!ImageReader::read(goldenPath, golden, gw, gh)) {
+            result = "NO REFERENCE";
+            ++failures;
+        } else if (gw != width || gh != height) {
+            result = "SIZE MISMATCH";
+            ++failures;
+        } else {
+            ImageDiff d = compareImages(frame, golden, threshold, marks);
+            double pct = 100.0 * double(d.differing) / double(frame.size());
+            std::snprintf(diffCol, sizeof(diffCol), "%.3f", pct);
+            std::snprintf(maxCol, sizeof(maxCol), "%d", d.maxChannel);
+            result = (pct <= tolerancePct) ? "PASS" : "FAIL";
+            if (pct > tolerancePct) {
+                ++failures;
+                if (!outDir.empty()) ImageWriter::write(outDir + "/" + name + ".diff.png", marks.data(), width, height);
+            }
+        }
+
+        std::printf("%-16s %8.3f %8.3f %8.3f %8.1f %9.1f %8s %9s  %s\n", name.c_str(), percentile(ms, 0.50),
+                    percentile(ms, 0.99), ms.back(), double(draws) / double(frames), double(verts) / double(frames),
+                    diffCol, maxCol, result);
+    }
+    return failures ? 2 : 0;
+}
@@ -0,0 +1,141 @@
+#include "../include/game/Game.h"
+#include "../include/game/MatchPool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Batch match runner: plays many headless matches over one or more maps on a
+// work-stealing thread pool and reports per-match results plus aggregate
+// simulation throughput.
+
+static void usage(const char* exe) {
+    std::fprintf(stderr,
+                 "Usage: %s [--matches N] [--threads T] [--max-ticks N] [--seed S]\n"
+                 "          [--scaling] [--quiet] [map.svg...]\n"
+                 "  --matches N    matches to play, spread round-robin over the maps (default 1000)\n"
+                 "  --threads T    worker threads, 0 = all hardware threads (default 0)\n"
+                 "  --max-ticks N  tick limit per match (default 36000, 10 min at 60 Hz)\n"
+                 "  --seed S       seed of the first match; match i uses S + i (default 1)\n"
+                 "  --scaling      rerun the batch with 1, 2, 4 ... T threads and report speedup\n"
+                 "  --quiet        skip the per-match lines\n"
+                 "With no maps, every SVG in test_svgs/ is used.\n",
+                 exe);
+}
+
+static std::vector<std::string> svgFilesIn(const std::string& dir) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const auto& e : std::filesystem::directory_iterator(dir, ec)) {
+        if (e.path().extension() == ".svg") files.push_back(e.path().string());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+static std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+static void queueMatches(MatchPool& pool, int scenarios, long long count, long long seed) {
+    pool.clearMatches();
+    for (long long i = 0; i < count; ++i) {
+        pool.addMatch(int(i % scenarios), uint32_t(seed + i));
+    }
+}
+
+int main(int argc, char** argv) {
+    long long matchCount = 1000;
+    long long threads = 0;
+    long long maxTicks = 36000;
+    long long seed = 1;
+    bool scaling = false;
+    bool quiet = false;
+    std::vector<std::string> maps;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(a, "--matches") == 0 && hasValue) matchCount = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--threads") == 0 && hasValue) threads = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--max-ticks") == 0 && hasValue) maxTicks = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--seed") == 0 && hasValue) seed = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--scaling") == 0) scaling = true;
+        else if (std::strcmp(a, "--quiet") == 0) quiet = true;
+        else if (std::strncmp(a, "--", 2) == 0) { usage(argv[0]); return 1; }
+        else maps.push_back(a);
+    }
+    if (maps.empty()) maps = svgFilesIn("test_svgs");
+    if (maps.empty() || matchCount <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Maps are parsed once; every match copies its scenario's Game.
+    std::vector<Game> prototypes(maps.size());
+    for (size_t i = 0; i < maps.size(); ++i) {
+        if (!prototypes[i].loadFromSvg(maps[i])) {
+            std::fprintf(stderr, "failed to load '%s'\n", maps[i].c_str());
+            return 1;
+        }
+    }
+
+    MatchPool pool((int)threads);
+    for (const Game& g : prototypes) pool.addScenario(g);
+
+    queueMatches(pool, pool.scenarioCount(), matchCount, seed);
+    pool.run(maxTicks);
+
+    if (!quiet) {
+        std::printf("%7s %-24s %10s %8s %8s %6s %6s\n", "match", "map", "seed", "ticks", "winner", "p1", "p2");
+        const std::vector<MatchResult>& rs = pool.results();
+        for (size_t i = 0; i < rs.size(); ++i) {
+            const MatchResult& r = rs[i];
+            char winner[16];
+            if (!r.finished) std::snprintf(winner, sizeof(winner), "-");
+            else if (r.winnerId == 0) std::snprintf(winner, sizeof(winner), "draw");
+            else std::snprintf(winner, sizeof(winner), "P%d", r.winnerId);
+            std::printf("%7zu %-24s %10u %8lld %8s %6d %6d\n", i, baseName(maps[r.scenario]).c_str(),
+                        r.seed, r.ticks, winner, r.livesP1, r.livesP2);
+        }
+    }
+
+    int finished = 0;
+    int wins[3] = {0, 0, 0};
+    for (const MatchResult& r : pool.results()) {
+        if (!r.finished) continue;
+        ++finished;
+        wins[std::min(std::max(r.winnerId, 0), 2)]++;
+    }
+
+    double secs = pool.lastRunSeconds();
+    std::printf("matches: %d (%d finished; P1 %d, P2 %d, draw %d)\n",
+                pool.matchCount(), finished, wins[1], wins[2], wins[0]);
+    std::printf("threads: %d, steals: %llu\n", pool.threadCount(), (unsigned long long)pool.steals());
+    std::printf("ticks: %lld in %.3f s = %.0f ticks/s\n",
+                pool.totalTicks(), secs, double(pool.totalTicks()) / std::max(secs, 1e-9));
+
+    if (scaling) {
+        int maxThreads = pool.threadCount();
+        double base = 0.0;
+        std::printf("\n%8s %14s %9s %11s\n", "threads", "ticks/s", "speedup", "efficiency");
+        for (int t = 1; t <= maxThreads; t = (t * 2 > maxThreads && t != maxThreads) ? maxThreads : t * 2) {
+            MatchPool p(t);
+            for (const Game& g : prototypes) p.addScenario(g);
+            queueMatches(p, p.scenarioCount(), matchCount, seed);
+            p.run(maxTicks);
+
+            double rate = double(p.totalTicks()) / std::max(p.lastRunSeconds(), 1e-9);
+            if (t == 1) base = rate;
+            std::printf("%8d %14.0f %8.2fx %10.0f%%\n", t, rate, rate / base, 100.0 * rate / base / t);
+        }
+    }
+    return 0;
+}
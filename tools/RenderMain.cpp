@@ -0,0 +1,149 @@
+#include "../include/game/Game.h"
+#include "../include/game/InputScript.h"
+#include "../include/game/SoftRaster.h"
+#include "../include/io/ImageWriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Headless frames through the CPU rasterizer: plays the seeded input script
+// on a map, renders every Nth tick and optionally writes the frames as PNG or
+// PPM. --bench then re-renders the last frame with 1, 2, 4... threads to show
+// how the tiled rasterizer scales. No display or GL context is needed.
+
+static void usage(const char* exe) {
+    std::fprintf(stderr,
+                 "Usage: %s [options] map.svg\n"
+                 "  --size WxH      framebuffer size (default 1920x1080)\n"
+                 "  --threads N     rasterizer threads, 0 = all cores (default 1)\n"
+                 "  --ticks N       simulation ticks to play (default 600)\n"
+                 "  --every N       render every Nth tick (default 10)\n"
+                 "  --seed S        input script seed (default 1)\n"
+                 "  --out PREFIX    write PREFIX<tick>.png (or .ppm with --format ppm)\n"
+                 "  --format F      png or ppm (default png)\n"
+                 "  --bench N       then time N renders of the last frame per thread count\n",
+                 exe);
+}
+
+typedef std::chrono::steady_clock Clock;
+
+// Wall time of one whole frame: recording, binning and rasterization.
+static double renderFrame(const Game& game, SoftRaster& raster) {
+    auto t0 = Clock::now();
+    raster.beginFrame();
+    game.render(raster);
+    raster.endFrame();
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    int width = 1920, height = 1080;
+    int threads = 1;
+    long long ticks = 600;
+    long long every = 10;
+    long long seed = 1;
+    long long benchFrames = 0;
+    std::string outPrefix;
+    std::string format = "png";
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(a, "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2) { usage(argv[0]); return 1; }
+        }
+        else if (std::strcmp(a, "--threads") == 0 && hasValue) threads = std::atoi(argv[++i]);
+        else if (std::strcmp(a, "--ticks") == 0 && hasValue) ticks = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--every") == 0 && hasValue) every = std::max(1LL, std::atoll(argv[++i]));
+        else if (std::strcmp(a, "--seed") == 0 && hasValue) seed = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--out") == 0 && hasValue) outPrefix = argv[++i];
+        else if (std::strcmp(a, "--format") == 0 && hasValue) format = argv[++i];
+        else if (std::strcmp(a, "--bench") == 0 && hasValue) benchFrames = std::atoll(argv[++i]);
+        else if (std::strncmp(a, "--", 2) == 0) { usage(argv[0]); return 1; }
+        else files.push_back(a);
+    }
+    if (files.size() != 1 || (format != "png" && format != "ppm")) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Game game;
+    if (!game.loadFromSvg(files[0])) {
+        std::fprintf(stderr, "failed to load '%s'\n", files[0].c_str());
+        return 1;
+    }
+
+    SoftRaster raster;
+    if (!raster.resize(width, height)) {
+        std::fprintf(stderr, "bad framebuffer size %dx%d\n", width, height);
+        return 1;
+    }
+    raster.setThreads(threads);
+    raster.setClearColor(rgb(0.22f, 0.22f, 0.22f));  // the game's glClearColor
+    const Arena& arena = game.getArena();
+    raster.fitView(arena.center, arena.radius);
+
+    InputScript script((uint32_t)seed);
+    InputState in;
+    std::vector<double> frameMs;
+    bool resetPending = false;
+    for (long long t = 1; t <= ticks; ++t) {
+        if (resetPending) game.reset();
+        script.step(in);
+        game.setInput(in);
+        game.update(1.0f / 60.0f);
+        resetPending = !game.isRunning();
+
+        if (t % every != 0) continue;
+        frameMs.push_back(renderFrame(game, raster));
+        if (!outPrefix.empty()) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "%06lld.%s", t, format.c_str());
+            std::string path = outPrefix + name;
+            if (!ImageWriter::write(path, raster.pixels(), width, height)) {
+                std::fprintf(stderr, "failed to write '%s'\n", path.c_str());
+                return 1;
+            }
+        }
+    }
+
+    if (!frameMs.empty()) {
+        std::vector<double> sorted = frameMs;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (double ms : frameMs) sum += ms;
+        double mean = sum / double(frameMs.size());
+        std::printf("%dx%d, %d thread(s): %zu frames, %.2f ms mean, %.2f ms p99 (%.0f fps), %d shapes in the last\n",
+                    width, height, raster.threads(), frameMs.size(), mean,
+                    sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)], 1000.0 / mean,
+                    int(raster.frameStats().drawCalls));
+    }
+
+    if (benchFrames > 0) {
+        int maxThreads = (threads > 0) ? threads : std::max(1, int(std::thread::hardware_concurrency()));
+        std::printf("\n%8s %10s %8s %9s\n", "threads", "ms/frame", "fps", "speedup");
+        std::vector<int> counts;
+        for (int n = 1; n < maxThreads; n *= 2) counts.push_back(n);
+        counts.push_back(maxThreads);
+
+        double base = 0.0;
+        for (int n : counts) {
+            raster.setThreads(n);
+            renderFrame(game, raster);   // warm up: static layer and worker threads
+            double sum = 0.0;
+            for (long long i = 0; i < benchFrames; ++i) sum += renderFrame(game, raster);
+            double ms = sum / double(benchFrames);
+            if (n == 1) base = ms;
+            std::printf("%8d %10.3f %8.0f %8.2fx\n", n, ms, 1000.0 / ms, base / ms);
+        }
+    }
+
+    return 0;
+}
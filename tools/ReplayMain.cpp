@@ -0,0 +1,187 @@
+#include "../include/game/Game.h"
+#include "../include/game/InputScript.h"
+#include "../include/io/InputRecording.h"
+#include "../include/io/SceneCache.h"
+#include "../include/util/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Headless replay of input recordings (trabalhocg --record) through
+// Game::update as fast as the CPU allows. Reports throughput and the final
+// state hash, and checks it against the hash stored in the recording so an
+// optimized build can be shown to simulate identically.
+
+static void usage(const char* exe) {
+    std::fprintf(stderr,
+                 "Usage: %s [--repeat N] [--expect HASH] recording.rec map.svg\n"
+                 "       %s --script out.rec [--ticks N] [--seed S] map.svg\n"
+                 "  --repeat N     replay N times and report the best run (default 5)\n"
+                 "  --expect HASH  also require this final state hash (hex)\n"
+                 "  --script       write a recording of the seeded input script instead\n"
+                 "  --profile P    time the update phases (one frame per tick), print a\n"
+                 "                 summary and write P.csv and P.trace.json\n",
+                 exe, exe);
+}
+
+typedef std::chrono::steady_clock Clock;
+
+// Drives a game with the scripted input, resetting after each game over like
+// a player pressing 'r', and records it.
+static int writeScript(const std::string& outPath, const std::string& mapPath,
+                       const Game& prototype, long long ticks, long long seed) {
+    uint64_t mapHash = 0;
+    SceneCache::hashFile(mapPath, mapHash);
+
+    Game game = prototype;
+    InputScript script((uint32_t)seed);
+    InputState in;
+    InputRecorder rec;
+    rec.begin(60, mapHash);
+
+    bool resetPending = false;
+    for (long long t = 0; t < ticks; ++t) {
+        if (resetPending) game.reset();
+        script.step(in);
+        game.setInput(in);
+        rec.record(game.getInput(), game.getViewportWidth(), resetPending);
+        game.update(1.0f / 60.0f);
+        resetPending = !game.isRunning();
+    }
+
+    if (!rec.save(outPath, game.stateHash())) {
+        std::fprintf(stderr, "failed to write '%s'\n", outPath.c_str());
+        return 1;
+    }
+    std::printf("wrote %s: %lld ticks, %zu bytes of input, final hash %016llx\n", outPath.c_str(), ticks,
+                rec.body().size(), (unsigned long long)game.stateHash());
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    long long repeat = 5;
+    long long ticks = 36000;
+    long long seed = 1;
+    std::string expect;
+    std::string scriptOut;
+    std::string profilePrefix;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(a, "--repeat") == 0 && hasValue) repeat = std::max(1LL, std::atoll(argv[++i]));
+        else if (std::strcmp(a, "--expect") == 0 && hasValue) expect = argv[++i];
+        else if (std::strcmp(a, "--script") == 0 && hasValue) scriptOut = argv[++i];
+        else if (std::strcmp(a, "--ticks") == 0 && hasValue) ticks = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--seed") == 0 && hasValue) seed = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--profile") == 0 && hasValue) profilePrefix = argv[++i];
+        else if (std::strncmp(a, "--", 2) == 0) { usage(argv[0]); return 1; }
+        else files.push_back(a);
+    }
+
+    size_t need = scriptOut.empty() ? 2 : 1;
+    if (files.size() != need) {
+        usage(argv[0]);
+        return 1;
+    }
+    const std::string& mapPath = files.back();
+
+    Game prototype;
+    if (!prototype.loadFromSvg(mapPath)) {
+        std::fprintf(stderr, "failed to load '%s'\n", mapPath.c_str());
+        return 1;
+    }
+
+    if (!scriptOut.empty()) return writeScript(scriptOut, mapPath, prototype, ticks, seed);
+
+    InputReplay replay;
+    if (!replay.load(files[0])) {
+        std::fprintf(stderr, "%s: %s\n", files[0].c_str(), replay.error().c_str());
+        return 1;
+    }
+    const InputRecordingInfo& info = replay.info();
+
+    uint64_t mapHash = 0;
+    if (info.mapHash != 0 && SceneCache::hashFile(mapPath, mapHash) && mapHash != info.mapHash) {
+        std::fprintf(stderr, "%s was recorded on a different map than '%s'\n", files[0].c_str(), mapPath.c_str());
+        return 1;
+    }
+
+    const bool profiling = !profilePrefix.empty();
+    Profiler::setEnabled(profiling);
+
+    const float dt = 1.0f / float(info.simHz);
+    uint64_t finalHash = 0;
+    double best = 1e30;
+
+    for (long long r = 0; r < repeat; ++r) {
+        Game game = prototype;
+        replay.restart();
+
+        InputState in;
+        int viewportWidth = 0;
+        bool resetBefore = false;
+
+        auto t0 = Clock::now();
+        while (replay.next(in, viewportWidth, resetBefore)) {
+            if (resetBefore) game.reset();
+            game.setViewportSize(viewportWidth, viewportWidth);
+            game.setInput(in);
+            game.update(dt);
+            if (profiling) Profiler::frameMark();
+        }
+        double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+        best = std::min(best, secs);
+
+        uint64_t h = game.stateHash();
+        if (r > 0 && h != finalHash) {
+            std::fprintf(stderr, "replay %lld ended in a different state (%016llx vs %016llx)\n", r,
+                         (unsigned long long)h, (unsigned long long)finalHash);
+            return 2;
+        }
+        finalHash = h;
+    }
+
+    std::printf("ticks: %llu at %u Hz (%.1f s of play)\n", (unsigned long long)info.tickCount, info.simHz,
+                double(info.tickCount) / double(info.simHz));
+    std::printf("best of %lld: %.3f ms = %.0f ticks/s (%.0fx real time)\n", repeat, best * 1e3,
+                double(info.tickCount) / best, double(info.tickCount) / double(info.simHz) / best);
+    std::printf("final state hash: %016llx\n", (unsigned long long)finalHash);
+
+    if (profiling) {
+        std::vector<ProfileZoneStats> stats;
+        Profiler::summarize(stats, Profiler::kCapacity);
+        std::printf("\n%-18s %8s %9s %9s %9s %9s\n", "zone", "calls", "mean(us)", "p50(us)", "p99(us)", "max(us)");
+        for (int z = 0; z < int(ProfileZone::COUNT); ++z) {
+            const ProfileZoneStats& st = stats[size_t(z)];
+            if (st.calls == 0) continue;
+            std::printf("%-18s %8d %9.2f %9.2f %9.2f %9.2f\n", Profiler::zoneName(ProfileZone(z)), st.calls,
+                        st.meanUs, st.p50Us, st.p99Us, st.maxUs);
+        }
+        if (Profiler::writeCsv(profilePrefix + ".csv") && Profiler::writeChromeTrace(profilePrefix + ".trace.json")) {
+            std::printf("profile: %s.csv, %s.trace.json (newest %u of %llu events)\n", profilePrefix.c_str(),
+                        profilePrefix.c_str(), Profiler::kCapacity, (unsigned long long)Profiler::totalEvents());
+        } else {
+            std::fprintf(stderr, "failed to write profile '%s'\n", profilePrefix.c_str());
+        }
+    }
+
+    int status = 0;
+    if (info.finalHash != 0) {
+        bool ok = info.finalHash == finalHash;
+        std::printf("recorded hash:    %016llx (%s)\n", (unsigned long long)info.finalHash, ok ? "match" : "MISMATCH");
+        if (!ok) status = 2;
+    }
+    if (!expect.empty()) {
+        bool ok = std::strtoull(expect.c_str(), nullptr, 16) == finalHash;
+        std::printf("expected hash:    %s (%s)\n", expect.c_str(), ok ? "match" : "MISMATCH");
+        if (!ok) status = 2;
+    }
+    return status;
+}
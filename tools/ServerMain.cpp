@@ -0,0 +1,258 @@
+#include "../include/game/Game.h"
+#include "../include/game/InputScript.h"
+#include "../include/io/SceneCache.h"
+#include "../include/net/NetClient.h"
+#include "../include/net/NetServer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Headless authoritative server. Optionally starts scripted bot clients in
+// the same process that connect over localhost UDP, so the whole path
+// (conditioned links, delta snapshots, interpolation) can be exercised and
+// measured without a display.
+
+// IPv4 + UDP headers, added to payload sizes for the on-the-wire figures.
+static const int kUdpOverhead = 28;
+
+static std::atomic<bool> stopRequested(false);
+
+static void onSignal(int) {
+    stopRequested = true;
+}
+
+static void usage(const char* exe) {
+    std::fprintf(stderr,
+                 "Usage: %s [--port P] [--hz N] [--snapshot-hz N] [--loss PCT] [--latency MS]\n"
+                 "          [--jitter MS] [--bots N] [--seconds S] [--report S] map.svg\n"
+                 "  --port P         UDP port (default %u; 0 picks a free one)\n"
+                 "  --hz N           simulation rate (default 60)\n"
+                 "  --snapshot-hz N  snapshots per second to each client (default 30)\n"
+                 "  --loss PCT       simulated packet loss on every link, percent (default 0)\n"
+                 "  --latency MS     simulated one-way latency on every link (default 0)\n"
+                 "  --jitter MS      extra random delay, 0..MS (default 0)\n"
+                 "  --bots N         scripted clients to run in-process (default 0)\n"
+                 "  --seconds S      stop after S seconds, 0 = run until interrupted (default 0)\n"
+                 "  --report S       per-client bandwidth report interval (default 5)\n",
+                 exe, unsigned(Net::kDefaultPort));
+}
+
+struct LinkSettings {
+    float loss;
+    int latencyMs;
+    int jitterMs;
+};
+
+struct BotResult {
+    NetClientReport report;
+    int entity;
+    double seconds;
+    bool ok;
+    std::string error;
+};
+
+static float percentile(std::vector<float> v, float q) {
+    if (v.empty()) return 0.0f;
+    std::sort(v.begin(), v.end());
+    size_t i = std::min(v.size() - 1, size_t(q * float(v.size() - 1) + 0.5f));
+    return v[i];
+}
+
+static float mean(const std::vector<float>& v) {
+    if (v.empty()) return 0.0f;
+    double sum = 0.0;
+    for (float x : v) sum += x;
+    return float(sum / double(v.size()));
+}
+
+// One scripted client: connects, sends a command every tick and samples
+// the interpolated view as a renderer would.
+static void runBot(int index, uint16_t port, uint64_t mapHash, LinkSettings link, BotResult& out) {
+    NetClient client;
+    client.link().configure(link.loss, link.latencyMs, link.jitterMs);
+
+    std::string error;
+    if (!client.connect(NetAddress::loopback(port), mapHash, error)) {
+        out.ok = false;
+        out.error = error;
+        return;
+    }
+
+    InputScript script(uint32_t(1000 + index));
+    InputState in;
+    NetView view;
+
+    auto start = std::chrono::steady_clock::now();
+    auto next = start;
+    while (!stopRequested) {
+        uint64_t now = Net::nowMicros();
+        client.poll(now);
+        if (client.status() == NetClient::Status::FAILED) break;
+
+        if (client.status() == NetClient::Status::CONNECTED) {
+            script.step(in);
+            client.sendCommand(player1Command(in, 500), now);
+            client.sample(now, view);
+        }
+
+        next += std::chrono::microseconds(int64_t(1e6 / client.simulationRate()));
+        std::this_thread::sleep_until(next);
+    }
+
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    out.ok = client.status() != NetClient::Status::FAILED;
+    out.error = client.error();
+    out.entity = client.entity();
+    client.disconnect(Net::nowMicros());
+    out.report = client.report();
+}
+
+static void printClientReport(const std::vector<NetServer::ClientInfo>& now,
+                              std::vector<NetServer::ClientInfo>& before, double seconds) {
+    std::printf("%-22s %6s %10s %10s %9s %8s %7s\n",
+                "client", "entity", "kB/s", "wire kB/s", "snap/s", "avg B", "full");
+    for (const NetServer::ClientInfo& c : now) {
+        NetClientStats prev;
+        for (const NetServer::ClientInfo& b : before) {
+            if (b.address == c.address) prev = b.stats;
+        }
+        uint64_t bytes = c.stats.bytesSent - prev.bytesSent;
+        uint64_t snaps = c.stats.snapshots - prev.snapshots;
+        std::printf("%-22s %6d %10.2f %10.2f %9.1f %8.0f %7llu\n",
+                    c.address.toString().c_str(), c.entity,
+                    double(bytes) / 1024.0 / seconds,
+                    double(bytes + snaps * kUdpOverhead) / 1024.0 / seconds,
+                    double(snaps) / seconds,
+                    snaps ? double(bytes) / double(snaps) : 0.0,
+                    (unsigned long long)(c.stats.fullSnapshots - prev.fullSnapshots));
+    }
+    before = now;
+}
+
+int main(int argc, char** argv) {
+    long long port = Net::kDefaultPort;
+    long long hz = 60;
+    long long snapshotHz = 30;
+    double lossPct = 0.0;
+    long long latencyMs = 0;
+    long long jitterMs = 0;
+    long long bots = 0;
+    double seconds = 0.0;
+    double reportSeconds = 5.0;
+    const char* mapPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(a, "--port") == 0 && hasValue) port = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--hz") == 0 && hasValue) hz = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--snapshot-hz") == 0 && hasValue) snapshotHz = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--loss") == 0 && hasValue) lossPct = std::atof(argv[++i]);
+        else if (std::strcmp(a, "--latency") == 0 && hasValue) latencyMs = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--jitter") == 0 && hasValue) jitterMs = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--bots") == 0 && hasValue) bots = std::atoll(argv[++i]);
+        else if (std::strcmp(a, "--seconds") == 0 && hasValue) seconds = std::atof(argv[++i]);
+        else if (std::strcmp(a, "--report") == 0 && hasValue) reportSeconds = std::atof(argv[++i]);
+        else if (std::strncmp(a, "--", 2) == 0) { usage(argv[0]); return 1; }
+        else mapPath = a;
+    }
+    if (!mapPath || hz <= 0 || snapshotHz <= 0 || port < 0 || port > 65535) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Game game;
+    if (!game.loadFromSvg(mapPath)) {
+        std::fprintf(stderr, "failed to load '%s'\n", mapPath);
+        return 1;
+    }
+    uint64_t mapHash = 0;
+    SceneCache::hashFile(mapPath, mapHash);
+
+    LinkSettings link = { float(lossPct / 100.0), int(latencyMs), int(jitterMs) };
+
+    NetServer server(game, mapHash);
+    server.setSimulationRate(float(hz));
+    server.setSnapshotInterval(int(std::max(1LL, hz / snapshotHz)));
+    server.link().configure(link.loss, link.latencyMs, link.jitterMs);
+
+    std::string error;
+    if (!server.start(uint16_t(port), error)) {
+        std::fprintf(stderr, "cannot listen on port %lld: %s\n", port, error.c_str());
+        return 1;
+    }
+    std::printf("serving '%s' on UDP port %u at %lld Hz, snapshot every %d ticks "
+                "(loss %.1f%%, latency %lld ms, jitter %lld ms)\n",
+                mapPath, unsigned(server.port()), hz, int(std::max(1LL, hz / snapshotHz)),
+                lossPct, latencyMs, jitterMs);
+    std::fflush(stdout);
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    std::vector<BotResult> botResults(size_t(std::max(0LL, bots)));
+    std::vector<std::thread> botThreads;
+    for (size_t i = 0; i < botResults.size(); ++i) {
+        botThreads.emplace_back(runBot, int(i), server.port(), mapHash, link, std::ref(botResults[i]));
+    }
+
+    const auto stepTime = std::chrono::microseconds(int64_t(1e6 / double(hz)));
+    auto start = std::chrono::steady_clock::now();
+    auto next = start;
+    auto lastReport = start;
+    std::vector<NetServer::ClientInfo> reported;
+
+    while (!stopRequested) {
+        server.step(Net::nowMicros());
+
+        auto now = std::chrono::steady_clock::now();
+        double sinceReport = std::chrono::duration<double>(now - lastReport).count();
+        if (reportSeconds > 0.0 && sinceReport >= reportSeconds) {
+            std::printf("tick %u, %zu clients\n", server.tick(), server.clients().size());
+            printClientReport(server.clients(), reported, sinceReport);
+            std::fflush(stdout);
+            lastReport = now;
+        }
+        if (seconds > 0.0 && std::chrono::duration<double>(now - start).count() >= seconds) break;
+
+        next += stepTime;
+        std::this_thread::sleep_until(next);
+    }
+
+    // Bots report after the server stops so their last snapshots are counted.
+    stopRequested = true;
+    for (std::thread& t : botThreads) t.join();
+
+    double sinceReport = std::chrono::duration<double>(std::chrono::steady_clock::now() - lastReport).count();
+    if (sinceReport > 0.1) {
+        std::printf("tick %u, %zu clients\n", server.tick(), server.clients().size());
+        printClientReport(server.clients(), reported, sinceReport);
+    }
+
+    if (!botResults.empty()) {
+        std::printf("\n%4s %6s %10s %9s %9s %9s %9s %7s\n",
+                    "bot", "entity", "down kB/s", "snap/s", "lat mean", "lat p50", "lat p99", "stale");
+        for (size_t i = 0; i < botResults.size(); ++i) {
+            const BotResult& b = botResults[i];
+            if (!b.ok) {
+                std::printf("%4zu failed: %s\n", i, b.error.c_str());
+                continue;
+            }
+            const NetClientReport& r = b.report;
+            double secs = std::max(b.seconds, 1e-9);
+            std::printf("%4zu %6d %10.2f %9.1f %8.1fms %8.1fms %8.1fms %7llu\n",
+                        i, b.entity, double(r.bytesReceived) / 1024.0 / secs, double(r.snapshots) / secs,
+                        mean(r.latencyMs), percentile(r.latencyMs, 0.5f), percentile(r.latencyMs, 0.99f),
+                        (unsigned long long)r.undecodable);
+        }
+    }
+    return 0;
+}